@@ -0,0 +1,39 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <coretypes/intfs.h>
+#include <coretypes/deserializer.h>
+#include <coretypes/updatable.h>
+#include <rapidjson/document.h>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+// Decodes the binary stream into a JSON document, so the serialized objects, lists and the
+// deserialize factories are shared with the JSON deserializer.
+class BinaryDeserializerImpl : public ImplementationOf<IDeserializer>
+{
+public:
+    using JsonDocument = rapidjson::Document;
+
+    ErrCode INTERFACE_FUNC deserialize(IString* serialized, IBaseObject* context, IFunction* factoryCallback, IBaseObject** object) override;
+    ErrCode INTERFACE_FUNC update(IUpdatable* updatable, IString* serialized) override;
+
+    ErrCode INTERFACE_FUNC toString(CharPtr* str) override;
+
+    static ErrCode Parse(IString* serialized, JsonDocument& document);
+};
+
+END_NAMESPACE_OPENDAQ
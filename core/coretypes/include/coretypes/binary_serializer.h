@@ -0,0 +1,34 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <coretypes/serializer.h>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+extern "C"
+ErrCode PUBLIC_EXPORT createBinarySerializer(ISerializer** obj);
+
+inline ISerializer* BinarySerializer_Create()
+{
+    ISerializer* obj;
+    ErrCode res = createBinarySerializer(&obj);
+    if (OPENDAQ_SUCCEEDED(res))
+        return obj;
+
+    throw std::bad_alloc();
+}
+
+END_NAMESPACE_OPENDAQ
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <coretypes/common.h>
+#include <coretypes/serializer.h>
+#include <coretypes/binary_serializer.h>
+#include <coretypes/serializer_ptr.h>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+/*!
+ * @brief Creates a serializer that writes a compact binary encoding of the JSON data model.
+ *
+ * Keys are written once per output and referenced by index afterwards. The output is stuffed
+ * so that it contains no zero bytes and can be carried in a String object. It can only be read
+ * by a BinaryDeserializer.
+ */
+inline SerializerPtr BinarySerializer()
+{
+    return SerializerPtr(BinarySerializer_Create());
+}
+
+END_NAMESPACE_OPENDAQ
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <coretypes/serializer.h>
+#include <coretypes/serializable.h>
+#include <coretypes/intfs.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+namespace binary_serialization
+{
+    // Values are written as a tag byte followed by the tag's payload. Lists and objects are closed
+    // by the End tag. Object keys are unsigned varints: an even value introduces a new key of length
+    // value / 2 followed by its characters, an odd value references the (value / 2)-th introduced key.
+    // The stream starts with the format version and is COBS-stuffed, so it contains no zero bytes.
+    enum class Tag : uint8_t
+    {
+        End = 0x00,
+        Null = 0x01,
+        False = 0x02,
+        True = 0x03,
+        Int = 0x04,      // zig-zag encoded varint
+        Float = 0x05,    // 8 bytes, little endian IEEE 754
+        String = 0x06,   // varint length followed by characters
+        List = 0x07,
+        Object = 0x08
+    };
+
+    constexpr uint8_t FormatVersion = 1;
+
+    void encodeCobs(const std::string& input, std::vector<char>& output);
+    bool decodeCobs(const char* input, SizeT length, std::string& output);
+}
+
+class BinarySerializerImpl : public ImplementationOf<ISerializer>
+{
+public:
+    BinarySerializerImpl();
+
+    ErrCode INTERFACE_FUNC startTaggedObject(ISerializable* serializable) override;
+    ErrCode INTERFACE_FUNC startObject() override;
+    ErrCode INTERFACE_FUNC endObject() override;
+
+    ErrCode INTERFACE_FUNC startList() override;
+    ErrCode INTERFACE_FUNC endList() override;
+
+    ErrCode INTERFACE_FUNC getOutput(IString** output) override;
+
+    ErrCode INTERFACE_FUNC key(ConstCharPtr string) override;
+    ErrCode INTERFACE_FUNC keyStr(IString* name) override;
+    ErrCode INTERFACE_FUNC keyRaw(ConstCharPtr string, SizeT length) override;
+
+    ErrCode INTERFACE_FUNC writeInt(Int integer) override;
+    ErrCode INTERFACE_FUNC writeBool(Bool boolean) override;
+    ErrCode INTERFACE_FUNC writeFloat(Float real) override;
+    ErrCode INTERFACE_FUNC writeString(ConstCharPtr string, SizeT length) override;
+    ErrCode INTERFACE_FUNC writeNull() override;
+
+    ErrCode INTERFACE_FUNC reset() override;
+    ErrCode INTERFACE_FUNC isComplete(Bool* complete) override;
+
+    template <typename TSerializable>
+    ErrCode startTaggedObject(TSerializable* obj);
+
+private:
+    void writeTag(binary_serialization::Tag tag);
+    void writeVarUInt(uint64_t value);
+    void writeKey(ConstCharPtr string, SizeT length);
+    void writeStringPayload(ConstCharPtr string, SizeT length);
+
+    std::string buffer;
+    std::vector<char> output;
+    std::unordered_map<std::string, SizeT> keyIndices;
+    SizeT depth;
+};
+
+template <typename TSerializable>
+ErrCode BinarySerializerImpl::startTaggedObject(TSerializable* obj)
+{
+    writeTag(binary_serialization::Tag::Object);
+    depth++;
+    writeKey("__type", 6);
+    return writeInt(TSerializable::serializeId());
+}
+
+END_NAMESPACE_OPENDAQ
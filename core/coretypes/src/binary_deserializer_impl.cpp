@@ -0,0 +1,316 @@
+#include <coretypes/binary_deserializer_impl.h>
+#include <coretypes/binary_serializer_impl.h>
+#include <coretypes/json_deserializer_impl.h>
+#include <coretypes/json_serialized_object.h>
+#include <coretypes/coretypes.h>
+#include <coretypes/ctutils.h>
+#include <cstring>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+namespace
+{
+
+using namespace binary_serialization;
+
+class BinaryReader
+{
+public:
+    using JsonValue = rapidjson::Value;
+    using JsonAllocator = rapidjson::Document::AllocatorType;
+
+    BinaryReader(const std::string& data, JsonAllocator& allocator)
+        : pos(data.data())
+        , end(data.data() + data.size())
+        , allocator(allocator)
+    {
+    }
+
+    bool readDocument(JsonValue& value)
+    {
+        uint8_t version;
+        if (!readByte(version) || version != FormatVersion)
+            return false;
+
+        return readValue(value, 0) && pos == end;
+    }
+
+private:
+    // bounds the recursion on malformed or malicious input
+    static constexpr SizeT MaxDepth = 512;
+
+    bool readByte(uint8_t& byte)
+    {
+        if (pos == end)
+            return false;
+
+        byte = static_cast<uint8_t>(*pos++);
+        return true;
+    }
+
+    bool readVarUInt(uint64_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte;
+            if (!readByte(byte))
+                return false;
+
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool readLength(SizeT& length)
+    {
+        uint64_t value;
+        if (!readVarUInt(value) || value > static_cast<uint64_t>(end - pos))
+            return false;
+
+        length = static_cast<SizeT>(value);
+        return true;
+    }
+
+    bool readKey(JsonValue& name)
+    {
+        uint64_t value;
+        if (!readVarUInt(value))
+            return false;
+
+        if (value & 1)
+        {
+            const auto index = static_cast<SizeT>(value >> 1);
+            if (index >= keys.size())
+                return false;
+
+            name.SetString(rapidjson::StringRef(keys[index].first, keys[index].second));
+            return true;
+        }
+
+        const auto length = static_cast<SizeT>(value >> 1);
+        if (length == 0 || length > static_cast<SizeT>(end - pos))
+            return false;
+
+        // keys are kept in the document's allocator and referenced by all later occurrences
+        auto key = static_cast<char*>(allocator.Malloc(length + 1));
+        std::memcpy(key, pos, length);
+        key[length] = '\0';
+        pos += length;
+
+        keys.emplace_back(key, static_cast<rapidjson::SizeType>(length));
+        name.SetString(rapidjson::StringRef(key, static_cast<rapidjson::SizeType>(length)));
+        return true;
+    }
+
+    bool readValue(JsonValue& value, SizeT depth)
+    {
+        if (depth > MaxDepth)
+            return false;
+
+        uint8_t tag;
+        if (!readByte(tag))
+            return false;
+
+        switch (static_cast<Tag>(tag))
+        {
+            case Tag::Null:
+                value.SetNull();
+                return true;
+            case Tag::False:
+                value.SetBool(false);
+                return true;
+            case Tag::True:
+                value.SetBool(true);
+                return true;
+            case Tag::Int:
+            {
+                uint64_t encoded;
+                if (!readVarUInt(encoded))
+                    return false;
+
+                value.SetInt64(static_cast<int64_t>((encoded >> 1) ^ (~(encoded & 1) + 1)));
+                return true;
+            }
+            case Tag::Float:
+            {
+                if (end - pos < 8)
+                    return false;
+
+                uint64_t bits = 0;
+                for (int i = 0; i < 8; ++i)
+                    bits |= static_cast<uint64_t>(static_cast<uint8_t>(*pos++)) << (i * 8);
+
+                double real;
+                std::memcpy(&real, &bits, sizeof(real));
+                value.SetDouble(real);
+                return true;
+            }
+            case Tag::String:
+            {
+                SizeT length;
+                if (!readLength(length))
+                    return false;
+
+                value.SetString(pos, static_cast<rapidjson::SizeType>(length), allocator);
+                pos += length;
+                return true;
+            }
+            case Tag::List:
+            {
+                value.SetArray();
+                while (pos != end && static_cast<Tag>(*pos) != Tag::End)
+                {
+                    JsonValue item;
+                    if (!readValue(item, depth + 1))
+                        return false;
+                    value.PushBack(item, allocator);
+                }
+                return readEnd();
+            }
+            case Tag::Object:
+            {
+                value.SetObject();
+                while (pos != end && static_cast<Tag>(*pos) != Tag::End)
+                {
+                    JsonValue name;
+                    JsonValue member;
+                    if (!readKey(name) || !readValue(member, depth + 1))
+                        return false;
+                    value.AddMember(name, member, allocator);
+                }
+                return readEnd();
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool readEnd()
+    {
+        uint8_t tag;
+        return readByte(tag) && static_cast<Tag>(tag) == Tag::End;
+    }
+
+    const char* pos;
+    const char* end;
+    JsonAllocator& allocator;
+    std::vector<std::pair<const char*, rapidjson::SizeType>> keys;
+};
+
+}
+
+ErrCode BinaryDeserializerImpl::Parse(IString* serialized, JsonDocument& document)
+{
+    if (serialized == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    ConstCharPtr ptr;
+    ErrCode errCode = serialized->getCharPtr(&ptr);
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    SizeT length;
+    errCode = serialized->getLength(&length);
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    std::string data;
+    if (!decodeCobs(ptr, length, data))
+    {
+        return OPENDAQ_ERR_DESERIALIZE_PARSE_ERROR;
+    }
+
+    BinaryReader reader(data, document.GetAllocator());
+    if (!reader.readDocument(document))
+    {
+        return OPENDAQ_ERR_DESERIALIZE_PARSE_ERROR;
+    }
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinaryDeserializerImpl::deserialize(IString* serialized, IBaseObject* context, IFunction* factoryCallback, IBaseObject** object)
+{
+    if (object == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    JsonDocument document;
+    ErrCode errCode = Parse(serialized, document);
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    return JsonDeserializerImpl::Deserialize(document, context, factoryCallback, object);
+}
+
+ErrCode BinaryDeserializerImpl::update(IUpdatable* updatable, IString* serialized)
+{
+    if (updatable == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    JsonDocument document;
+    ErrCode errCode = Parse(serialized, document);
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    if (document.GetType() != rapidjson::kObjectType)
+    {
+        return OPENDAQ_ERR_INVALIDTYPE;
+    }
+
+    SerializedObjectPtr serObj;
+    errCode = createObject<ISerializedObject, JsonSerializedObject>(&serObj, document.GetObject());
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    return updatable->update(serObj);
+}
+
+ErrCode BinaryDeserializerImpl::toString(CharPtr* str)
+{
+    if (str == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    return daqDuplicateCharPtr("BinaryDeserializer", str);
+}
+
+// createBinaryDeserializer
+extern "C"
+ErrCode PUBLIC_EXPORT createBinaryDeserializer(IDeserializer** binaryDeserializer)
+{
+    if (!binaryDeserializer)
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+
+    IDeserializer* object = new(std::nothrow) BinaryDeserializerImpl();
+
+    if (!object)
+        return OPENDAQ_ERR_NOMEMORY;
+
+    object->addRef();
+
+    *binaryDeserializer = object;
+    return OPENDAQ_SUCCESS;
+}
+
+END_NAMESPACE_OPENDAQ
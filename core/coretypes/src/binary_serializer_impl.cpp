@@ -0,0 +1,322 @@
+#include <coretypes/binary_serializer_impl.h>
+#include <coretypes/stringobject_factory.h>
+#include <cstring>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+namespace binary_serialization
+{
+
+void encodeCobs(const std::string& input, std::vector<char>& output)
+{
+    output.resize(input.size() + input.size() / 254 + 2);
+
+    size_t codeIndex = 0;
+    size_t writeIndex = 1;
+    uint8_t code = 1;
+
+    for (const char byte : input)
+    {
+        if (byte == 0)
+        {
+            output[codeIndex] = static_cast<char>(code);
+            codeIndex = writeIndex++;
+            code = 1;
+            continue;
+        }
+
+        output[writeIndex++] = byte;
+        if (++code == 0xFF)
+        {
+            output[codeIndex] = static_cast<char>(code);
+            codeIndex = writeIndex++;
+            code = 1;
+        }
+    }
+
+    output[codeIndex] = static_cast<char>(code);
+    output.resize(writeIndex);
+}
+
+bool decodeCobs(const char* input, SizeT length, std::string& output)
+{
+    output.clear();
+    output.reserve(length);
+
+    SizeT readIndex = 0;
+    while (readIndex < length)
+    {
+        const auto code = static_cast<uint8_t>(input[readIndex++]);
+        if (code == 0 || readIndex + code - 1 > length)
+            return false;
+
+        output.append(input + readIndex, code - 1);
+        readIndex += code - 1;
+
+        if (code != 0xFF && readIndex < length)
+            output.push_back(0);
+    }
+
+    return true;
+}
+
+}
+
+using namespace binary_serialization;
+
+BinarySerializerImpl::BinarySerializerImpl()
+    : depth(0)
+{
+    reset();
+}
+
+void BinarySerializerImpl::writeTag(Tag tag)
+{
+    buffer.push_back(static_cast<char>(tag));
+}
+
+void BinarySerializerImpl::writeVarUInt(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void BinarySerializerImpl::writeKey(ConstCharPtr string, SizeT length)
+{
+    auto [it, inserted] = keyIndices.try_emplace(std::string(string, length), keyIndices.size());
+    if (!inserted)
+    {
+        writeVarUInt((static_cast<uint64_t>(it->second) << 1) | 1);
+        return;
+    }
+
+    writeVarUInt(static_cast<uint64_t>(length) << 1);
+    buffer.append(string, length);
+}
+
+void BinarySerializerImpl::writeStringPayload(ConstCharPtr string, SizeT length)
+{
+    writeVarUInt(length);
+    if (length > 0)
+        buffer.append(string, length);
+}
+
+ErrCode BinarySerializerImpl::startTaggedObject(ISerializable* serializable)
+{
+    if (!serializable)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    ConstCharPtr id;
+    ErrCode errCode = serializable->getSerializeId(&id);
+
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    writeTag(Tag::Object);
+    depth++;
+    writeKey("__type", 6);
+    writeTag(Tag::String);
+    writeStringPayload(id, std::strlen(id));
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::startObject()
+{
+    writeTag(Tag::Object);
+    depth++;
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::endObject()
+{
+    if (depth == 0)
+        return OPENDAQ_ERR_INVALIDSTATE;
+
+    writeTag(Tag::End);
+    depth--;
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::startList()
+{
+    writeTag(Tag::List);
+    depth++;
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::endList()
+{
+    if (depth == 0)
+        return OPENDAQ_ERR_INVALIDSTATE;
+
+    writeTag(Tag::End);
+    depth--;
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::getOutput(IString** serialized)
+{
+    if (serialized == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    encodeCobs(buffer, output);
+    return createStringN(serialized, output.data(), output.size());
+}
+
+ErrCode BinarySerializerImpl::key(ConstCharPtr string)
+{
+    if (string == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    return keyRaw(string, std::strlen(string));
+}
+
+ErrCode BinarySerializerImpl::keyStr(IString* name)
+{
+    if (!name)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    ConstCharPtr str;
+    ErrCode errCode = name->getCharPtr(&str);
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    SizeT length;
+    errCode = name->getLength(&length);
+    if (OPENDAQ_FAILED(errCode))
+    {
+        return errCode;
+    }
+
+    return keyRaw(str, length);
+}
+
+ErrCode BinarySerializerImpl::keyRaw(ConstCharPtr string, SizeT length)
+{
+    if (string == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    if (length == 0)
+    {
+        return OPENDAQ_ERR_INVALIDPARAMETER;
+    }
+
+    writeKey(string, length);
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::writeInt(Int integer)
+{
+    writeTag(Tag::Int);
+    const auto value = static_cast<uint64_t>(integer);
+    writeVarUInt((value << 1) ^ static_cast<uint64_t>(integer >> 63));
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::writeBool(Bool boolean)
+{
+    writeTag(boolean ? Tag::True : Tag::False);
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::writeFloat(Float real)
+{
+    writeTag(Tag::Float);
+
+    uint64_t bits;
+    std::memcpy(&bits, &real, sizeof(bits));
+    for (int i = 0; i < 8; ++i)
+        buffer.push_back(static_cast<char>(bits >> (i * 8)));
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::writeString(ConstCharPtr string, SizeT length)
+{
+    if (string == nullptr && length > 0)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    writeTag(Tag::String);
+    writeStringPayload(string, length);
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::writeNull()
+{
+    writeTag(Tag::Null);
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::reset()
+{
+    buffer.clear();
+    buffer.push_back(static_cast<char>(FormatVersion));
+    keyIndices.clear();
+    depth = 0;
+
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode BinarySerializerImpl::isComplete(Bool* complete)
+{
+    if (complete == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    *complete = depth == 0 && buffer.size() > 1;
+
+    return OPENDAQ_SUCCESS;
+}
+
+// createBinarySerializer
+extern "C"
+ErrCode PUBLIC_EXPORT createBinarySerializer(ISerializer** binarySerializer)
+{
+    if (binarySerializer == nullptr)
+    {
+        return OPENDAQ_ERR_ARGUMENT_NULL;
+    }
+
+    ISerializer* object = new(std::nothrow) BinarySerializerImpl();
+    if (!object)
+    {
+        return OPENDAQ_ERR_NOMEMORY;
+    }
+
+    object->addRef();
+    *binarySerializer = object;
+    return OPENDAQ_SUCCESS;
+}
+
+END_NAMESPACE_OPENDAQ
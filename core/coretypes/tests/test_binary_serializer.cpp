@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <testutils/testutils.h>
+#include <limits>
+#include <cstring>
+#include <coretypes/coretypes.h>
+
+using namespace daq;
+
+class BinarySerializerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        serializer = BinarySerializer();
+        deserializer = BinaryDeserializer();
+    }
+
+    BaseObjectPtr roundTrip(const BaseObjectPtr& obj)
+    {
+        serializer.reset();
+        obj.serialize(serializer);
+        return deserializer.deserialize(serializer.getOutput());
+    }
+
+    SerializerPtr serializer;
+    DeserializerPtr deserializer;
+};
+
+TEST_F(BinarySerializerTest, Scalars)
+{
+    ASSERT_EQ(roundTrip(Boolean(true)), true);
+    ASSERT_EQ(roundTrip(Boolean(false)), false);
+    ASSERT_EQ(roundTrip(Integer(0)), 0);
+    ASSERT_EQ(roundTrip(Integer(-1)), -1);
+    ASSERT_EQ(roundTrip(Integer(std::numeric_limits<Int>::min())), std::numeric_limits<Int>::min());
+    ASSERT_EQ(roundTrip(Integer(std::numeric_limits<Int>::max())), std::numeric_limits<Int>::max());
+    ASSERT_EQ(roundTrip(Floating(1.5)), 1.5);
+    ASSERT_EQ(roundTrip(Floating(0.0)), 0.0);
+    ASSERT_EQ(roundTrip(String("test")), "test");
+    ASSERT_EQ(roundTrip(String("")), "");
+}
+
+TEST_F(BinarySerializerTest, OutputHasNoZeroBytes)
+{
+    auto list = List<IBaseObject>(0, 0.0, "", false);
+    list.serialize(serializer);
+
+    const StringPtr output = serializer.getOutput();
+    ASSERT_GT(output.getLength(), 0u);
+    ASSERT_EQ(output.getLength(), std::strlen(output.getCharPtr()));
+}
+
+TEST_F(BinarySerializerTest, List)
+{
+    auto list = List<IBaseObject>(1, "two", 3.0, true, List<IInteger>(4, 5));
+
+    const ListPtr<IBaseObject> deserialized = roundTrip(list);
+    ASSERT_EQ(deserialized.getCount(), 5u);
+    ASSERT_EQ(deserialized[0], 1);
+    ASSERT_EQ(deserialized[1], "two");
+    ASSERT_EQ(deserialized[2], 3.0);
+    ASSERT_EQ(deserialized[3], true);
+    ASSERT_EQ(deserialized[4].asPtr<IList>().getCount(), 2u);
+}
+
+TEST_F(BinarySerializerTest, DictWithRepeatedKeys)
+{
+    auto dict = Dict<IString, IBaseObject>();
+    for (int i = 0; i < 10; ++i)
+        dict.set("Key" + std::to_string(i), Dict<IString, IBaseObject>({{"Value", i}}));
+
+    const DictPtr<IString, IBaseObject> deserialized = roundTrip(dict);
+    ASSERT_EQ(deserialized.getCount(), 10u);
+    for (int i = 0; i < 10; ++i)
+        ASSERT_EQ(deserialized.get("Key" + std::to_string(i)).asPtr<IDict>().get("Value"), i);
+}
+
+TEST_F(BinarySerializerTest, SmallerThanJson)
+{
+    auto dict = Dict<IString, IBaseObject>();
+    for (int i = 0; i < 100; ++i)
+        dict.set("Key" + std::to_string(i), Dict<IString, IBaseObject>({{"Value", i}}));
+
+    auto jsonSerializer = JsonSerializer();
+    dict.serialize(jsonSerializer);
+    dict.serialize(serializer);
+
+    ASSERT_LT(serializer.getOutput().getLength(), jsonSerializer.getOutput().getLength());
+}
+
+TEST_F(BinarySerializerTest, InvalidInput)
+{
+    ASSERT_THROW(deserializer.deserialize("..."), DeserializeException);
+
+    List<IInteger>(1, 2, 3).serialize(serializer);
+    const std::string output = serializer.getOutput();
+    ASSERT_THROW(deserializer.deserialize(output.substr(0, output.size() - 1)), DeserializeException);
+}
+
+TEST_F(BinarySerializerTest, IsComplete)
+{
+    ASSERT_FALSE(serializer.isComplete());
+
+    serializer.startList();
+    ASSERT_FALSE(serializer.isComplete());
+    serializer.writeInt(1);
+    serializer.endList();
+    ASSERT_TRUE(serializer.isComplete());
+
+    serializer.reset();
+    ASSERT_FALSE(serializer.isComplete());
+}
@@ -26,7 +26,9 @@
 #include <opendaq/context_ptr.h>
 #include <opendaq/streaming_ptr.h>
 
+#include <chrono>
 #include <future>
+#include <mutex>
 
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_CLIENT_MODULE
 
@@ -42,6 +44,7 @@ public:
                                 opendaq_native_streaming_protocol::NativeStreamingClientHandlerPtr transportProtocolClient);
     ~NativeDeviceHelper();
 
+    void setLazyLoading(bool lazyLoading, SizeT prefetchDepth);
     DevicePtr connectAndGetDevice(const ComponentPtr& parent);
 
     void subscribeToCoreEvent(const ContextPtr& context);
@@ -50,9 +53,24 @@ public:
     void addStreaming(const StreamingPtr& streaming);
 
 private:
+    struct PendingReply
+    {
+        std::promise<config_protocol::PacketBuffer> promise;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    // outlives the helper while a returned future still waits for its reply
+    struct PendingReplies
+    {
+        std::unordered_map<size_t, PendingReply> promises;
+        std::mutex sync;
+    };
+
     void setupProtocolClients(const ContextPtr& context);
     config_protocol::PacketBuffer doConfigRequest(const config_protocol::PacketBuffer& reqPacket);
+    std::future<config_protocol::PacketBuffer> sendConfigRequestAsync(const config_protocol::PacketBuffer& reqPacket);
     void receiveConfigPacket(const config_protocol::PacketBuffer& packet);
+    void expirePendingReplies();
     void coreEventCallback(ComponentPtr& sender, CoreEventArgsPtr& eventArgs);
     void componentAdded(const ComponentPtr& sender, const CoreEventArgsPtr& eventArgs);
     void addSignalsToStreaming(const ListPtr<ISignal>& signals);
@@ -60,7 +78,7 @@ private:
     LoggerComponentPtr loggerComponent;
     std::unique_ptr<config_protocol::ConfigProtocolClient<NativeDeviceImpl>> configProtocolClient;
     opendaq_native_streaming_protocol::NativeStreamingClientHandlerPtr transportProtocolClient;
-    std::unordered_map<size_t, std::promise<config_protocol::PacketBuffer>> replyPackets;
+    std::shared_ptr<PendingReplies> replyPackets;
     StreamingPtr streaming;
     WeakRefPtr<IDevice> deviceRef;
 };
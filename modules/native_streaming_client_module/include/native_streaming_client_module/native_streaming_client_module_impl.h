@@ -18,6 +18,7 @@
 #include <native_streaming_client_module/common.h>
 #include <opendaq/module_impl.h>
 #include <daq_discovery/daq_discovery_client.h>
+#include <native_streaming_protocol/native_streaming_client_handler.h>
 
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_CLIENT_MODULE
 
@@ -49,9 +50,11 @@ private:
                                         const PropertyObjectPtr& config,
                                         const StringPtr& host,
                                         const StringPtr& port,
-                                        const StringPtr& path);
+                                        const StringPtr& path,
+                                        const opendaq_native_streaming_protocol::NativeStreamingClientHandlerPtr& transportProtocolClient);
     static PropertyObjectPtr createDeviceDefaultConfig();
     void populateConfigFromContext(PropertyObjectPtr config);
+    opendaq_native_streaming_protocol::NativeStreamingClientHandlerPtr createClientHandler(const PropertyObjectPtr& transportLayerConfig);
     static PropertyObjectPtr createTransportLayerDefaultConfig();
     bool validateDeviceConfig(const PropertyObjectPtr& config);
     bool validateTransportLayerConfig(const PropertyObjectPtr& config);
@@ -44,6 +44,7 @@ protected:
     void signalUnavailableHandler(const StringPtr& signalStringId);
     void reconnectionStatusChangedHandler(opendaq_native_streaming_protocol::ClientReconnectionStatus status);
     void initStatuses(const ContextPtr& ctx);
+    void initReferenceStatistics();
     void publishReconnectionStatus();
     void createNativeStreaming(opendaq_native_streaming_protocol::NativeStreamingClientHandlerPtr transportProtocolClient,
                                const StringPtr& host,
@@ -57,6 +58,7 @@ protected:
     StringPtr connectionString;
     opendaq_native_streaming_protocol::ClientReconnectionStatus reconnectionStatus;
     StreamingPtr nativeStreaming;
+    opendaq_native_streaming_protocol::NativeStreamingClientHandlerPtr clientHandler;
     std::unordered_map<StringPtr, std::pair<SignalPtr, StringPtr>, StringHash, StringEqualTo> deviceSignals;
     std::unordered_map<StringPtr, std::pair<SignalPtr, StringPtr>, StringHash, StringEqualTo> deviceSignalsReconnection;
 };
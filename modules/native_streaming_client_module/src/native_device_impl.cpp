@@ -17,6 +17,7 @@ NativeDeviceHelper::NativeDeviceHelper(const ContextPtr& context,
                                        NativeStreamingClientHandlerPtr transportProtocolClient)
     : loggerComponent(context.getLogger().getOrAddComponent("NativeDevice"))
     , transportProtocolClient(transportProtocolClient)
+    , replyPackets(std::make_shared<PendingReplies>())
 {
     setupProtocolClients(context);
 }
@@ -31,6 +32,11 @@ NativeDeviceHelper::~NativeDeviceHelper()
     }
 }
 
+void NativeDeviceHelper::setLazyLoading(bool lazyLoading, SizeT prefetchDepth)
+{
+    configProtocolClient->getClientComm()->setLazyLoading(lazyLoading, prefetchDepth);
+}
+
 DevicePtr NativeDeviceHelper::connectAndGetDevice(const ComponentPtr& parent)
 {
     auto device = configProtocolClient->connect(parent);
@@ -120,6 +126,13 @@ void NativeDeviceHelper::setupProtocolClients(const ContextPtr& context)
     };
     configProtocolClient = std::make_unique<ConfigProtocolClient<NativeDeviceImpl>>(context, sendRequestCallback, nullptr);
 
+    SendRequestAsyncCallback sendRequestAsyncCallback =
+        [this](PacketBuffer& packet)
+    {
+        return this->sendConfigRequestAsync(packet);
+    };
+    configProtocolClient->getClientComm()->setSendRequestAsyncCallback(sendRequestAsyncCallback);
+
     auto receiveConfigPacketCb =
         [this](const PacketBuffer& packet)
     {
@@ -130,23 +143,41 @@ void NativeDeviceHelper::setupProtocolClients(const ContextPtr& context)
 
 PacketBuffer NativeDeviceHelper::doConfigRequest(const PacketBuffer& reqPacket)
 {
-    // future/promise mechanism is used since transport client works asynchronously
+    return sendConfigRequestAsync(reqPacket).get();
+}
+
+std::future<PacketBuffer> NativeDeviceHelper::sendConfigRequestAsync(const PacketBuffer& reqPacket)
+{
+    // future/promise mechanism is used since transport client works asynchronously,
+    // replies are matched to requests by id so any number of requests can be in flight
     auto reqId = reqPacket.getId();
-    replyPackets.insert({reqId, std::promise<PacketBuffer>()});
-    std::future<PacketBuffer> future = replyPackets.at(reqId).get_future();
-    transportProtocolClient->sendConfigRequest(reqPacket);
 
-    if (future.wait_for(requestTimeout) == std::future_status::ready)
-    {
-        auto result = future.get();
-        replyPackets.erase(reqId);
-        return result;
-    }
-    else
+    // the timeout runs from sending, not from the (possibly later) call to get()
+    const auto deadline = std::chrono::steady_clock::now() + requestTimeout;
+    std::future<PacketBuffer> future;
     {
-        replyPackets.erase(reqId);
-        throw GeneralErrorException("Native configuration protocol request timed out");
+        std::scoped_lock lock(replyPackets->sync);
+        expirePendingReplies();
+        auto& pendingReply = replyPackets->promises[reqId];
+        pendingReply.deadline = deadline;
+        future = pendingReply.promise.get_future();
     }
+    transportProtocolClient->sendConfigRequest(reqPacket);
+
+    std::weak_ptr<PendingReplies> replyPacketsRef = replyPackets;
+    return std::async(std::launch::deferred,
+                      [replyPacketsRef, reqId, deadline, future = std::move(future)]() mutable
+                      {
+                          if (future.wait_until(deadline) == std::future_status::ready)
+                              return future.get();
+
+                          if (const auto replyPackets = replyPacketsRef.lock())
+                          {
+                              std::scoped_lock lock(replyPackets->sync);
+                              replyPackets->promises.erase(reqId);
+                          }
+                          throw GeneralErrorException("Native configuration protocol request timed out");
+                      });
 }
 
 void NativeDeviceHelper::receiveConfigPacket(const PacketBuffer& packet)
@@ -154,15 +185,40 @@ void NativeDeviceHelper::receiveConfigPacket(const PacketBuffer& packet)
     if (packet.getPacketType() == serverNotification)
     {
         configProtocolClient->triggerNotificationPacket(packet);
+        return;
     }
-    else if(auto it = replyPackets.find(packet.getId()); it != replyPackets.end())
+
+    std::scoped_lock lock(replyPackets->sync);
+    if (auto it = replyPackets->promises.find(packet.getId()); it != replyPackets->promises.end())
     {
-        it->second.set_value(PacketBuffer(packet.getBuffer(), true));
+        it->second.promise.set_value(PacketBuffer(packet.getBuffer(), true));
+        replyPackets->promises.erase(it);
     }
     else
     {
         LOG_E("Received reply for unknown request id {}, reply type {:#x}", packet.getId(), packet.getPacketType());
     }
+
+    expirePendingReplies();
+}
+
+void NativeDeviceHelper::expirePendingReplies()
+{
+    // requests whose future is never read would otherwise keep their promise until the helper is destroyed;
+    // a future still waiting on an expired request receives the timeout error. Called with replyPackets->sync locked
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = replyPackets->promises.begin(); it != replyPackets->promises.end();)
+    {
+        if (it->second.deadline > now)
+        {
+            ++it;
+            continue;
+        }
+
+        LOG_W("Native configuration protocol request {} expired without a reply", it->first);
+        it->second.promise.set_exception(std::make_exception_ptr(GeneralErrorException("Native configuration protocol request timed out")));
+        it = replyPackets->promises.erase(it);
+    }
 }
 
 NativeDeviceImpl::NativeDeviceImpl(const config_protocol::ConfigProtocolClientCommPtr& configProtocolClientComm,
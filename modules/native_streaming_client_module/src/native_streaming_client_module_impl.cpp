@@ -11,6 +11,7 @@
 #include <regex>
 
 #include <config_protocol/config_protocol_client.h>
+#include <packet_streaming/event_packet_binary_serializer.h>
 
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_CLIENT_MODULE
 
@@ -78,13 +79,12 @@ DevicePtr NativeStreamingClientModule::createNativeDevice(const ContextPtr& cont
                                                           const PropertyObjectPtr& config,
                                                           const StringPtr& host,
                                                           const StringPtr& port,
-                                                          const StringPtr& path)
+                                                          const StringPtr& path,
+                                                          const NativeStreamingClientHandlerPtr& transportProtocolClient)
 {
     std::string streamingConnectionString = std::regex_replace(connectionString.toStdString(),
                                                                std::regex(NativeConfigurationDevicePrefix),
                                                                NativeStreamingPrefix);
-    auto transportProtocolClient =
-        std::make_shared<NativeStreamingClientHandler>(context, config.getPropertyValue("TransportLayerConfig"));
     StreamingPtr nativeStreaming =
         createWithImplementation<IStreaming, NativeStreamingImpl>(streamingConnectionString,
                                                                   host,
@@ -98,6 +98,14 @@ DevicePtr NativeStreamingClientModule::createNativeDevice(const ContextPtr& cont
     nativeStreaming.setActive(true);
 
     auto deviceHelper = std::make_unique<NativeDeviceHelper>(context, transportProtocolClient);
+    if (config.hasProperty("LazyLoading"))
+    {
+        const bool lazyLoading = config.getPropertyValue("LazyLoading");
+        Int prefetchDepth = 0;
+        if (config.hasProperty("LazyLoadingPrefetchDepth"))
+            prefetchDepth = config.getPropertyValue("LazyLoadingPrefetchDepth");
+        deviceHelper->setLazyLoading(lazyLoading, prefetchDepth);
+    }
     auto device = deviceHelper->connectAndGetDevice(parent);
 
     deviceHelper->addStreaming(nativeStreaming);
@@ -139,6 +147,20 @@ void NativeStreamingClientModule::populateConfigFromContext(PropertyObjectPtr co
             transportLayerConfig.setPropertyValue("HeartbeatTimeout", value);
     }
 
+    if (options.hasKey("PayloadCompression"))
+    {
+        auto value = options.get("PayloadCompression");
+        if (value.getCoreType() == CoreType::ctBool)
+            transportLayerConfig.setPropertyValue("PayloadCompression", value);
+    }
+
+    if (options.hasKey("SharedMemoryTransport"))
+    {
+        auto value = options.get("SharedMemoryTransport");
+        if (value.getCoreType() == CoreType::ctBool)
+            transportLayerConfig.setPropertyValue("SharedMemoryTransport", value);
+    }
+
     if (options.hasKey("ConnectionTimeout"))
     {
         auto value = options.get("ConnectionTimeout");
@@ -161,6 +183,24 @@ void NativeStreamingClientModule::populateConfigFromContext(PropertyObjectPtr co
     }
 }
 
+NativeStreamingClientHandlerPtr NativeStreamingClientModule::createClientHandler(const PropertyObjectPtr& transportLayerConfig)
+{
+    auto clientHandler = std::make_shared<NativeStreamingClientHandler>(context, transportLayerConfig);
+
+    // received data packets are allocated with the allocator given in the module options, if any
+    const auto options = context.getModuleOptions(id);
+    if (options.hasKey("PacketAllocator"))
+    {
+        const auto allocator = options.get("PacketAllocator").asPtrOrNull<IAllocator>();
+        if (allocator.assigned())
+            clientHandler->setPacketAllocator(allocator);
+        else
+            LOG_W("The PacketAllocator module option is not an allocator and is ignored");
+    }
+
+    return clientHandler;
+}
+
 DevicePtr NativeStreamingClientModule::onCreateDevice(const StringPtr& connectionString,
                                                       const ComponentPtr& parent,
                                                       const PropertyObjectPtr& config)
@@ -190,12 +230,13 @@ DevicePtr NativeStreamingClientModule::onCreateDevice(const StringPtr& connectio
 
         std::string localId = fmt::format("streaming_pseudo_device{}", deviceIndex++);
 
-        auto clientHandler = std::make_shared<NativeStreamingClientHandler>(context, deviceConfig.getPropertyValue("TransportLayerConfig"));
+        auto clientHandler = createClientHandler(deviceConfig.getPropertyValue("TransportLayerConfig"));
         return createWithImplementation<IDevice, NativeStreamingDeviceImpl>(context, parent, localId, connectionString, host, port, path, clientHandler);
     }
     else if (connectionStringHasPrefix(connectionString, NativeConfigurationDevicePrefix))
     {
-        return createNativeDevice(context, parent, connectionString, deviceConfig, host, port, path);
+        auto clientHandler = createClientHandler(deviceConfig.getPropertyValue("TransportLayerConfig"));
+        return createNativeDevice(context, parent, connectionString, deviceConfig, host, port, path, clientHandler);
     }
     else
     {
@@ -213,6 +254,14 @@ PropertyObjectPtr NativeStreamingClientModule::createTransportLayerDefaultConfig
     transportLayerConfig.addProperty(daq::IntProperty("ConnectionTimeout", 1000));
     transportLayerConfig.addProperty(daq::IntProperty("StreamingInitTimeout", 1000));
     transportLayerConfig.addProperty(daq::IntProperty("ReconnectionPeriod", 1000));
+    transportLayerConfig.addProperty(daq::IntProperty("EventPacketVersion", PACKET_EVENT_VERSION_BINARY));
+    transportLayerConfig.addProperty(daq::BoolProperty("PayloadCompression", daq::False));
+    // data payloads are passed through a POSIX shared memory ring when the server runs on the same host;
+    // supported on Linux only, elsewhere the option is ignored and payloads are sent over the socket
+    transportLayerConfig.addProperty(
+        BoolPropertyBuilder("SharedMemoryTransport", daq::False)
+            .setDescription("Pass data payloads through shared memory if the server runs on the same host. Supported on Linux only.")
+            .build());
 
     return transportLayerConfig;
 }
@@ -223,6 +272,14 @@ PropertyObjectPtr NativeStreamingClientModule::createDeviceDefaultConfig()
 
     defaultConfig.addProperty(ObjectProperty("TransportLayerConfig", createTransportLayerDefaultConfig()));
 
+    // only the top-level structure of the device is mirrored on connect, the items of folders below
+    // are requested when first accessed together with the given number of nested levels
+    defaultConfig.addProperty(BoolProperty("LazyLoading", False));
+    const auto prefetchDepthProp = IntPropertyBuilder("LazyLoadingPrefetchDepth", 0)
+        .setMinValue(0)
+        .build();
+    defaultConfig.addProperty(prefetchDepthProp);
+
     return defaultConfig;
 }
 
@@ -286,7 +343,7 @@ StreamingPtr NativeStreamingClientModule::onCreateStreaming(const StringPtr& con
             port,
             path,
             context,
-            std::make_shared<opendaq_native_streaming_protocol::NativeStreamingClientHandler>(context, createTransportLayerDefaultConfig()),
+            createClientHandler(createTransportLayerDefaultConfig()),
             nullptr,
             nullptr,
             nullptr);
@@ -307,7 +364,7 @@ StreamingPtr NativeStreamingClientModule::onCreateStreaming(const StringPtr& con
             port,
             String("/"),
             context,
-            std::make_shared<opendaq_native_streaming_protocol::NativeStreamingClientHandler>(context, createTransportLayerDefaultConfig()),
+            createClientHandler(createTransportLayerDefaultConfig()),
             nullptr,
             nullptr,
             nullptr);
@@ -10,6 +10,7 @@
 #include <coretypes/function_factory.h>
 
 #include <coreobjects/property_object_protected_ptr.h>
+#include <coreobjects/property_factory.h>
 
 #include <regex>
 
@@ -28,6 +29,7 @@ NativeStreamingDeviceImpl::NativeStreamingDeviceImpl(const ContextPtr& ctx,
     : Device(ctx, parent, localId)
     , connectionString(connectionString)
     , reconnectionStatus(ClientReconnectionStatus::Connected)
+    , clientHandler(transportProtocolClient)
 {
     if (!this->connectionString.assigned())
         throw ArgumentNullException("connectionString cannot be null");
@@ -35,6 +37,7 @@ NativeStreamingDeviceImpl::NativeStreamingDeviceImpl(const ContextPtr& ctx,
     createNativeStreaming(transportProtocolClient, host, port, path);
     activateStreaming();
     initStatuses(ctx);
+    initReferenceStatistics();
 }
 
 void NativeStreamingDeviceImpl::initStatuses(const ContextPtr& ctx)
@@ -51,6 +54,32 @@ void NativeStreamingDeviceImpl::initStatuses(const ContextPtr& ctx)
     this->statusContainer.asPtr<IComponentStatusContainerPrivate>().addStatus("ReconnectionStatus", statusInitValue);
 }
 
+void NativeStreamingDeviceImpl::initReferenceStatistics()
+{
+    // packets referenced by the client, read from the current connection on each access
+    objPtr.addProperty(IntPropertyBuilder("ReferencedPackets", 0).setReadOnly(True).build());
+    objPtr.addProperty(IntPropertyBuilder("ReferencedBytes", 0).setReadOnly(True).build());
+    objPtr.addProperty(IntPropertyBuilder("WaitingPacketBuffers", 0).setReadOnly(True).build());
+    objPtr.addProperty(IntPropertyBuilder("ReferenceLimitHits", 0).setReadOnly(True).build());
+
+    objPtr.getOnPropertyValueRead("ReferencedPackets") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+    {
+        args.setValue(static_cast<Int>(clientHandler->getReferenceStatistics().referencedPackets));
+    };
+    objPtr.getOnPropertyValueRead("ReferencedBytes") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+    {
+        args.setValue(static_cast<Int>(clientHandler->getReferenceStatistics().referencedBytes));
+    };
+    objPtr.getOnPropertyValueRead("WaitingPacketBuffers") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+    {
+        args.setValue(static_cast<Int>(clientHandler->getReferenceStatistics().waitingPacketBuffers));
+    };
+    objPtr.getOnPropertyValueRead("ReferenceLimitHits") += [this](PropertyObjectPtr&, PropertyValueEventArgsPtr& args)
+    {
+        args.setValue(static_cast<Int>(clientHandler->getReferenceStatistics().referenceLimitHits));
+    };
+}
+
 void NativeStreamingDeviceImpl::publishReconnectionStatus()
 {
     auto newStatusValue = this->statusContainer.getStatus("ReconnectionStatus");
@@ -158,6 +158,8 @@ TEST_F(NativeStreamingClientModuleTest, DefaultDeviceConfig)
     ASSERT_TRUE(deviceTypes.hasKey("daq.nd"));
     auto deviceConfig = deviceTypes.get("daq.nd").createDefaultConfig();
     ASSERT_TRUE(deviceConfig.assigned());
+    ASSERT_EQ(deviceConfig.getPropertyValue("LazyLoading"), False);
+    ASSERT_EQ(deviceConfig.getPropertyValue("LazyLoadingPrefetchDepth"), 0);
     ASSERT_TRUE(module.acceptsConnectionParameters("daq.nd://address", deviceConfig));
 
     ASSERT_TRUE(deviceTypes.hasKey("daq.nsd"));
@@ -18,6 +18,7 @@
 #include <native_streaming_server_module/common.h>
 #include <opendaq/device_ptr.h>
 #include <opendaq/packet_reader_ptr.h>
+#include <opendaq/input_port_config_ptr.h>
 #include <opendaq/server.h>
 #include <opendaq/server_impl.h>
 #include <coretypes/intfs.h>
@@ -26,6 +27,16 @@
 
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_SERVER_MODULE
 
+struct SignalReader
+{
+    SignalPtr signal;
+    InputPortConfigPtr port;
+    PacketReaderPtr reader;
+    opendaq_native_streaming_protocol::SignalHandlePtr signalHandle;
+    // serializes the notifications of one signal, packets of different signals are forwarded concurrently
+    std::shared_ptr<std::mutex> readSync;
+};
+
 class NativeStreamingServerImpl : public daq::Server
 {
 public:
@@ -40,12 +51,14 @@ protected:
 
     std::shared_ptr<opendaq_native_streaming_protocol::NativeStreamingServerHandler> serverHandler;
 
-    void startReading();
     void stopReading();
-    void startReadThread();
     void createReaders();
     void addReader(SignalPtr signalToRead);
     void removeReader(SignalPtr signalToRead);
+    static void readPackets(const PacketReaderPtr& reader,
+                            const opendaq_native_streaming_protocol::SignalHandlePtr& signalHandle,
+                            const std::shared_ptr<opendaq_native_streaming_protocol::NativeStreamingServerHandler>& serverHandler,
+                            const LoggerComponentPtr& loggerComponent);
 
     void startAsyncOperations();
     void stopAsyncOperations();
@@ -54,10 +67,9 @@ protected:
     void componentRemoved(ComponentPtr& sender, CoreEventArgsPtr& eventArgs);
     void coreEventCallback(ComponentPtr& sender, CoreEventArgsPtr& eventArgs);
 
-    std::thread readThread;
-    bool readThreadActive;
-    std::chrono::milliseconds readThreadSleepTime;
-    std::vector<std::pair<SignalPtr, PacketReaderPtr>> signalReaders;
+    bool useMultiThreadedScheduler;
+    std::chrono::milliseconds notificationCoalescingWindow;
+    std::vector<SignalReader> signalReaders;
 
     std::shared_ptr<boost::asio::io_context> ioContextPtr;
     boost::asio::executor_work_guard<boost::asio::io_context::executor_type> workGuard;
@@ -6,6 +6,8 @@
 #include <opendaq/device_private.h>
 #include <opendaq/streaming_info_factory.h>
 #include <opendaq/reader_factory.h>
+#include <opendaq/input_port_factory.h>
+#include <coretypes/weakrefptr.h>
 #include <opendaq/search_filter_factory.h>
 #include <opendaq/custom_log.h>
 #include <opendaq/event_packet_ids.h>
@@ -13,6 +15,7 @@
 #include <native_streaming_protocol/native_streaming_server_handler.h>
 #include <config_protocol/config_protocol_server.h>
 
+
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_SERVER_MODULE
 
 using namespace daq;
@@ -20,16 +23,58 @@ using namespace opendaq_native_streaming_protocol;
 
 NativeStreamingServerImpl::NativeStreamingServerImpl(DevicePtr rootDevice, PropertyObjectPtr config, const ContextPtr& context)
     : Server(config, rootDevice, context, nullptr)
-    , readThreadActive(false)
-    , readThreadSleepTime(std::chrono::milliseconds(20))
+    , useMultiThreadedScheduler(true)
+    , notificationCoalescingWindow(0)
     , ioContextPtr(std::make_shared<boost::asio::io_context>())
     , workGuard(ioContextPtr->get_executor())
     , logger(context.getLogger())
     , loggerComponent(logger.getOrAddComponent("NativeStreamingServerImpl"))
 {
+    if (config.hasProperty("UseMultiThreadedScheduler"))
+        useMultiThreadedScheduler = config.getPropertyValue("UseMultiThreadedScheduler");
+    if (config.hasProperty("NotificationCoalescingWindow"))
+    {
+        const Int window = config.getPropertyValue("NotificationCoalescingWindow");
+        notificationCoalescingWindow = std::chrono::milliseconds(window);
+    }
+
     startAsyncOperations();
 
     prepareServerHandler();
+    if (config.hasProperty("WriteBatchMaxSize") && config.hasProperty("WriteBatchFlushDelay"))
+    {
+        const SizeT maxBatchSize = config.getPropertyValue("WriteBatchMaxSize");
+        const Int flushDelay = config.getPropertyValue("WriteBatchFlushDelay");
+        serverHandler->setWriteBatchingParams(maxBatchSize, std::chrono::microseconds(flushDelay));
+    }
+    if (config.hasProperty("SendThreadCount"))
+    {
+        const SizeT sendThreadCount = config.getPropertyValue("SendThreadCount");
+        serverHandler->setSendThreadCount(sendThreadCount);
+    }
+    if (config.hasProperty("EncodeOnSocketThread"))
+    {
+        const Bool encodeOnSocketThread = config.getPropertyValue("EncodeOnSocketThread");
+        serverHandler->setEncodeOnSocketThread(encodeOnSocketThread);
+    }
+    if (config.hasProperty("SendQueueMaxBytes") && config.hasProperty("SendQueueMaxPackets") &&
+        config.hasProperty("SlowConsumerPolicy"))
+    {
+        const SizeT maxBytes = config.getPropertyValue("SendQueueMaxBytes");
+        const SizeT maxPackets = config.getPropertyValue("SendQueueMaxPackets");
+        const Int policy = config.getPropertyValue("SlowConsumerPolicy");
+
+        SendQueueLimits limits;
+        limits.maxBytes = maxBytes;
+        limits.maxPackets = maxPackets;
+        limits.policy = static_cast<SlowConsumerPolicy>(policy);
+        if (config.hasProperty("SlowConsumerDownsampleFactor"))
+        {
+            const SizeT downsampleFactor = config.getPropertyValue("SlowConsumerDownsampleFactor");
+            limits.downsampleFactor = downsampleFactor;
+        }
+        serverHandler->setSendQueueLimits(limits);
+    }
     const uint16_t port = config.getPropertyValue("NativeStreamingPort");
     serverHandler->startServer(port);
 
@@ -39,8 +84,6 @@ NativeStreamingServerImpl::NativeStreamingServerImpl(DevicePtr rootDevice, Prope
     checkErrorInfo(errCode);
 
     this->context.getOnCoreEvent() += event(&NativeStreamingServerImpl::coreEventCallback);
-
-    startReading();
 }
 
 NativeStreamingServerImpl::~NativeStreamingServerImpl()
@@ -141,9 +184,10 @@ void NativeStreamingServerImpl::prepareServerHandler()
     // The Callback establishes a new native configuration server for each connected client
     // and transfers ownership of the configuration server to the transport layer session
     SetUpConfigProtocolServerCb createConfigServerCb =
-        [rootDevice = rootDevice](ConfigProtocolPacketCb sendConfigPacketCb)
+        [rootDevice = rootDevice, notificationCoalescingWindow = notificationCoalescingWindow](ConfigProtocolPacketCb sendConfigPacketCb)
     {
         auto configServer = std::make_shared<config_protocol::ConfigProtocolServer>(rootDevice, sendConfigPacketCb);
+        configServer->setNotificationCoalescingWindow(notificationCoalescingWindow);
         ConfigProtocolPacketCb processConfigRequestCb =
             [configServer, sendConfigPacketCb](const config_protocol::PacketBuffer& packetBuffer)
         {
@@ -165,6 +209,13 @@ PropertyObjectPtr NativeStreamingServerImpl::createDefaultConfig()
 {
     constexpr Int minPortValue = 0;
     constexpr Int maxPortValue = 65535;
+    constexpr Int minWriteBatchValue = 0;
+    constexpr Int maxWriteBatchFlushDelay = 1000000;
+    constexpr Int minSendThreadCount = 0;
+    constexpr Int maxSendThreadCount = 64;
+    constexpr Int minSendQueueLimit = 0;
+    constexpr Int minNotificationWindow = 0;
+    constexpr Int maxNotificationWindow = 10000;
 
     auto defaultConfig = PropertyObject();
 
@@ -174,6 +225,58 @@ PropertyObjectPtr NativeStreamingServerImpl::createDefaultConfig()
         .build();
     defaultConfig.addProperty(websocketPortProp);
 
+    // packets are forwarded to clients on input port notifications instead of being polled,
+    // if disabled - notifications are handled on the thread which sends the packet
+    defaultConfig.addProperty(BoolProperty("UseMultiThreadedScheduler", true));
+
+    // streaming packets are written to the socket in batches of up to max size bytes,
+    // flush delay in microseconds allows batching across send cycles, 0 writes at the end of each cycle
+    const auto writeBatchMaxSizeProp = IntPropertyBuilder("WriteBatchMaxSize", 65536)
+        .setMinValue(minWriteBatchValue)
+        .build();
+    defaultConfig.addProperty(writeBatchMaxSizeProp);
+    const auto writeBatchFlushDelayProp = IntPropertyBuilder("WriteBatchFlushDelay", 0)
+        .setMinValue(minWriteBatchValue)
+        .setMaxValue(maxWriteBatchFlushDelay)
+        .build();
+    defaultConfig.addProperty(writeBatchFlushDelayProp);
+
+    // clients are spread over the send threads on connect, their packets are encoded and queued on them
+    // in parallel; 0 keeps the work on the thread forwarding the packets
+    const auto sendThreadCountProp = IntPropertyBuilder("SendThreadCount", 0)
+        .setMinValue(minSendThreadCount)
+        .setMaxValue(maxSendThreadCount)
+        .build();
+    defaultConfig.addProperty(sendThreadCountProp);
+
+    // packets are encoded and queued on the thread serving the sockets, the send threads are not used then
+    defaultConfig.addProperty(BoolProperty("EncodeOnSocketThread", false));
+
+    // bytes and packets queued for a single client before the slow consumer policy applies, 0 disables the limit
+    // and is the default, so no data is dropped unless requested; the policy drops data packets, sends every
+    // n-th data packet of a signal, or disconnects the client
+    const auto sendQueueMaxBytesProp = IntPropertyBuilder("SendQueueMaxBytes", 0)
+        .setMinValue(minSendQueueLimit)
+        .build();
+    defaultConfig.addProperty(sendQueueMaxBytesProp);
+    const auto sendQueueMaxPacketsProp = IntPropertyBuilder("SendQueueMaxPackets", 0)
+        .setMinValue(minSendQueueLimit)
+        .build();
+    defaultConfig.addProperty(sendQueueMaxPacketsProp);
+    defaultConfig.addProperty(SelectionProperty("SlowConsumerPolicy", List<IString>("DropData", "Downsample", "Disconnect"), 0));
+    const auto downsampleFactorProp = IntPropertyBuilder("SlowConsumerDownsampleFactor", 10)
+        .setMinValue(1)
+        .build();
+    defaultConfig.addProperty(downsampleFactorProp);
+
+    // core event notifications raised within the window in milliseconds are sent to configuration clients
+    // as one packet with superseded property value changes dropped, 0 sends each event immediately
+    const auto notificationWindowProp = IntPropertyBuilder("NotificationCoalescingWindow", 0)
+        .setMinValue(minNotificationWindow)
+        .setMaxValue(maxNotificationWindow)
+        .build();
+    defaultConfig.addProperty(notificationWindowProp);
+
     return defaultConfig;
 }
 
@@ -202,52 +305,41 @@ void NativeStreamingServerImpl::onStopServer()
     serverHandler->stopServer();
 }
 
-void NativeStreamingServerImpl::startReading()
-{
-    readThreadActive = true;
-    this->readThread = std::thread([this]()
-    {
-        this->startReadThread();
-        LOG_I("Reading thread finished");
-    });
-}
-
 void NativeStreamingServerImpl::stopReading()
 {
-    readThreadActive = false;
-    if (readThread.joinable())
+    std::scoped_lock lock(readersSync);
+    for (const auto& signalReader : signalReaders)
     {
-        readThread.join();
-        LOG_I("Reading thread joined");
+        signalReader.reader.setOnDataAvailable(nullptr);
+        signalReader.port.remove();
     }
-
     signalReaders.clear();
 }
 
-void NativeStreamingServerImpl::startReadThread()
+void NativeStreamingServerImpl::readPackets(const PacketReaderPtr& reader,
+                                            const SignalHandlePtr& signalHandle,
+                                            const std::shared_ptr<NativeStreamingServerHandler>& serverHandler,
+                                            const LoggerComponentPtr& loggerComponent)
 {
-    while (readThreadActive)
+    try
     {
+        // packets read together are written to each client within one send cycle
+        auto packets = reader.readAll();
+        while (packets.getCount() > 0)
         {
-            std::scoped_lock lock(readersSync);
-            for (const auto& [signal, reader] : signalReaders)
-            {
-                PacketPtr packet = reader.read();
-                while (packet.assigned())
-                {
-                    serverHandler->sendPacket(signal, packet);
-                    packet = reader.read();
-                }
-            }
+            serverHandler->sendPackets(signalHandle, packets);
+            packets = reader.readAll();
         }
-
-        std::this_thread::sleep_for(readThreadSleepTime);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Failed to forward packets of signal with numeric id {}: {}", signalHandle->signalNumericId, e.what());
     }
 }
 
 void NativeStreamingServerImpl::createReaders()
 {
-    signalReaders.clear();
+    stopReading();
     auto signals = rootDevice.getSignals(search::Recursive(search::Any()));
 
     for (const auto& signal : signals)
@@ -260,30 +352,60 @@ void NativeStreamingServerImpl::addReader(SignalPtr signalToRead)
 {
     auto it = std::find_if(signalReaders.begin(),
                            signalReaders.end(),
-                           [&signalToRead](const std::pair<SignalPtr, PacketReaderPtr>& element)
+                           [&signalToRead](const SignalReader& element)
                            {
-                               return element.first == signalToRead;
+                               return element.signal == signalToRead;
                            });
     if (it != signalReaders.end())
         return;
 
     LOG_I("Add reader for signal {}", signalToRead.getGlobalId());
-    auto reader = PacketReader(signalToRead);
-    signalReaders.push_back(std::pair<SignalPtr, PacketReaderPtr>({signalToRead, reader}));
+
+    // resolved once, so the per-packet path does no string id lookups
+    auto signalHandle = serverHandler->getSignalHandle(signalToRead);
+
+    // with scheduler notifications, packets enqueued while the notification is pending
+    // are coalesced and forwarded together by a single read loop
+    auto port = InputPort(signalToRead.getContext(), nullptr, "readsignal");
+    auto reader = PacketReaderFromPort(port);
+    if (!useMultiThreadedScheduler)
+        port.setNotificationMethod(PacketReadyNotification::SameThread);
+    port.connect(signalToRead);
+
+    // the callback holds no reference to the server, it may still run on a scheduler thread after the server is destroyed
+    auto readSync = std::make_shared<std::mutex>();
+    WeakRefPtr<IPacketReader> readerRef = reader;
+    std::weak_ptr<NativeStreamingServerHandler> serverHandlerRef = serverHandler;
+    reader.setOnDataAvailable([readerRef, signalHandle, readSync, serverHandlerRef, loggerComponent = loggerComponent]
+    {
+        // keeps the packets of the signal in the order of reading
+        std::scoped_lock lock(*readSync);
+        auto reader = readerRef.getRef();
+        auto serverHandler = serverHandlerRef.lock();
+        if (reader.assigned() && serverHandler)
+            readPackets(reader, signalHandle, serverHandler, loggerComponent);
+    });
+    signalReaders.push_back({signalToRead, port, reader, signalHandle, readSync});
+
+    // forward packets enqueued before the notification callback was set
+    std::scoped_lock lock(*readSync);
+    readPackets(reader, signalHandle, serverHandler, loggerComponent);
 }
 
 void NativeStreamingServerImpl::removeReader(SignalPtr signalToRead)
 {
     auto it = std::find_if(signalReaders.begin(),
                            signalReaders.end(),
-                           [&signalToRead](const std::pair<SignalPtr, PacketReaderPtr>& element)
+                           [&signalToRead](const SignalReader& element)
                            {
-                               return element.first == signalToRead;
+                               return element.signal == signalToRead;
                            });
     if (it == signalReaders.end())
         return;
 
     LOG_I("Remove reader for signal {}", signalToRead.getGlobalId());
+    it->reader.setOnDataAvailable(nullptr);
+    it->port.remove();
     signalReaders.erase(it);
 }
 
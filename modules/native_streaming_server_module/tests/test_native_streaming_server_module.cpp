@@ -115,6 +115,17 @@ TEST_F(NativeStreamingServerModuleTest, ServerConfig)
 
     ASSERT_TRUE(config.hasProperty("NativeStreamingPort"));
     ASSERT_EQ(config.getPropertyValue("NativeStreamingPort"), 7420);
+
+    ASSERT_TRUE(config.hasProperty("UseMultiThreadedScheduler"));
+    ASSERT_EQ(config.getPropertyValue("UseMultiThreadedScheduler"), True);
+
+    ASSERT_TRUE(config.hasProperty("NotificationCoalescingWindow"));
+    ASSERT_EQ(config.getPropertyValue("NotificationCoalescingWindow"), 0);
+
+    ASSERT_TRUE(config.hasProperty("SendQueueMaxBytes"));
+    ASSERT_EQ(config.getPropertyValue("SendQueueMaxBytes"), 0);
+    ASSERT_TRUE(config.hasProperty("SendQueueMaxPackets"));
+    ASSERT_EQ(config.getPropertyValue("SendQueueMaxPackets"), 0);
 }
 
 TEST_F(NativeStreamingServerModuleTest, CreateServer)
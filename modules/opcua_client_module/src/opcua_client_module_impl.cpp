@@ -106,6 +106,22 @@ DevicePtr OpcUaClientModule::onCreateDevice(const StringPtr& connectionString,
 
     std::scoped_lock lock(sync);
     TmsClient client(context, parent, OpcUaScheme + deviceUrl, createStreamingCallback);
+    if (deviceConfig.hasProperty("ValueMonitoring"))
+    {
+        const bool valueMonitoring = deviceConfig.getPropertyValue("ValueMonitoring");
+        Int samplingInterval = 100;
+        if (deviceConfig.hasProperty("ValueMonitoringSamplingInterval"))
+            samplingInterval = deviceConfig.getPropertyValue("ValueMonitoringSamplingInterval");
+        Int maxItems = static_cast<Int>(tms::TmsClientContext::DefaultMaxMonitoredValues);
+        if (deviceConfig.hasProperty("ValueMonitoringMaxItems"))
+            maxItems = deviceConfig.getPropertyValue("ValueMonitoringMaxItems");
+        client.setValueMonitoring(valueMonitoring, static_cast<double>(samplingInterval), static_cast<size_t>(maxItems));
+    }
+    if (deviceConfig.hasProperty("BrowseCacheDirectory"))
+    {
+        const StringPtr browseCacheDirectory = deviceConfig.getPropertyValue("BrowseCacheDirectory");
+        client.setBrowseCacheDirectory(browseCacheDirectory.toStdString());
+    }
     auto device = client.connect();
     this->configureStreamingSources(deviceConfig, device);
     return device;
@@ -190,6 +206,24 @@ PropertyObjectPtr OpcUaClientModule::createDeviceDefaultConfig()
     defaultConfig.addProperty(ListProperty("AllowedStreamingProtocols", allowedStreamingProtocols));
     defaultConfig.addProperty(StringProperty("PrimaryStreamingProtocol", primaryStreamingProtocol));
 
+    // values read repeatedly (introspection properties, signal last values, component flags) are
+    // subscribed to with monitored items and served from a locally updated cache
+    defaultConfig.addProperty(BoolProperty("ValueMonitoring", False));
+    const auto samplingIntervalProp = IntPropertyBuilder("ValueMonitoringSamplingInterval", 100)
+        .setMinValue(1)
+        .build();
+    defaultConfig.addProperty(samplingIntervalProp);
+
+    // upper bound of monitored values, the least recently read one stops being monitored first
+    const auto maxItemsProp = IntPropertyBuilder("ValueMonitoringMaxItems", 1000)
+        .setMinValue(1)
+        .build();
+    defaultConfig.addProperty(maxItemsProp);
+
+    // browse results are stored in this directory and reused on reconnect while the server
+    // was not restarted; empty disables the persistent browse cache
+    defaultConfig.addProperty(StringProperty("BrowseCacheDirectory", ""));
+
     return defaultConfig;
 }
 
@@ -173,6 +173,18 @@ TEST_F(OpcUaClientModuleTest, DefaultDeviceConfig)
     ASSERT_TRUE(config.hasProperty("PrimaryStreamingProtocol"));
     ASSERT_EQ(config.getPropertyValue("PrimaryStreamingProtocol"), "daq.wss");
 #endif
+
+    ASSERT_TRUE(config.hasProperty("ValueMonitoring"));
+    ASSERT_EQ(config.getPropertyValue("ValueMonitoring"), False);
+
+    ASSERT_TRUE(config.hasProperty("ValueMonitoringSamplingInterval"));
+    ASSERT_EQ(config.getPropertyValue("ValueMonitoringSamplingInterval"), 100);
+
+    ASSERT_TRUE(config.hasProperty("ValueMonitoringMaxItems"));
+    ASSERT_EQ(config.getPropertyValue("ValueMonitoringMaxItems"), 1000);
+
+    ASSERT_TRUE(config.hasProperty("BrowseCacheDirectory"));
+    ASSERT_EQ(config.getPropertyValue("BrowseCacheDirectory"), "");
 }
 
 TEST_F(OpcUaClientModuleTest, InvalidDeviceConfig)
@@ -18,6 +18,8 @@ OpcUaServerImpl::OpcUaServerImpl(DevicePtr rootDevice, PropertyObjectPtr config,
     const uint16_t port = config.getPropertyValue("Port");
 
     server.setOpcUaPort(port);
+    if (config.hasProperty("LazyNodeCreation"))
+        server.setLazyNodeCreation(config.getPropertyValue("LazyNodeCreation"));
     server.start();
 }
 
@@ -31,6 +33,10 @@ PropertyObjectPtr OpcUaServerImpl::createDefaultConfig()
     const auto portProp = IntPropertyBuilder("Port", 4840).setMinValue(minPortValue).setMaxValue(maxPortValue).build();
     defaultConfig.addProperty(portProp);
 
+    // creates the device address space in slices once the first client session is activated
+    // instead of at server start, the nodes then stay until the server stops
+    defaultConfig.addProperty(BoolProperty("LazyNodeCreation", False));
+
     return defaultConfig;
 }
 
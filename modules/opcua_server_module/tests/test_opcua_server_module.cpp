@@ -124,6 +124,9 @@ TEST_F(OpcUaServerModuleTest, ServerConfig)
 
     ASSERT_TRUE(config.hasProperty("Port"));
     ASSERT_EQ(config.getPropertyValue("Port"), 4840);
+
+    ASSERT_TRUE(config.hasProperty("LazyNodeCreation"));
+    ASSERT_EQ(config.getPropertyValue("LazyNodeCreation"), False);
 }
 
 TEST_F(OpcUaServerModuleTest, CreateServer)
@@ -18,6 +18,10 @@
 
 #include <thread>
 #include <future>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <chrono>
 
 #include <opendaq/opendaq.h>
 #include <testutils/testutils.h>
@@ -97,6 +101,79 @@ namespace test_helpers
     {
         return acknowledgementFuture.wait_for(timeout) == std::future_status::ready;
     }
+
+    // value signals are selected by their domain signal, domain signals are not streamed separately
+    [[maybe_unused]]
+    static std::vector<MirroredSignalConfigPtr> getValueSignals(const DevicePtr& device)
+    {
+        std::vector<MirroredSignalConfigPtr> signals;
+        for (const auto& signal : device.getSignals(search::Recursive(search::Any())))
+        {
+            if (signal.getDomainSignal().assigned())
+                signals.push_back(signal.template asPtr<IMirroredSignalConfig>());
+        }
+        return signals;
+    }
+
+    // Reads the signals concurrently as their packets arrive and returns, for each signal, the delays
+    // between the domain timestamp of the newest sample read and the time it was read. The signals
+    // must have a microsecond domain relative to the Unix epoch, as the reference device signals do.
+    [[maybe_unused]]
+    static std::vector<std::vector<std::chrono::microseconds>> readSignalsConcurrently(
+        std::vector<MirroredSignalConfigPtr>& signals,
+        std::chrono::milliseconds duration)
+    {
+        const size_t signalCount = signals.size();
+        std::vector<std::promise<StringPtr>> subscribePromises(signalCount);
+        std::vector<std::future<StringPtr>> subscribeFutures(signalCount);
+        std::vector<std::vector<std::chrono::microseconds>> latencies(signalCount);
+        std::vector<std::mutex> latencySync(signalCount);
+
+        std::vector<StreamReaderPtr> readers;
+        readers.reserve(signalCount);
+        for (size_t i = 0; i < signalCount; ++i)
+        {
+            setupSubscribeAckHandler(subscribePromises[i], subscribeFutures[i], signals[i]);
+            readers.push_back(daq::StreamReader<double, int64_t>(signals[i]));
+            if (!waitForAcknowledgement(subscribeFutures[i]))
+            {
+                ADD_FAILURE() << "Signal " << signals[i].getGlobalId() << " was not subscribed";
+                return latencies;
+            }
+        }
+
+        for (size_t i = 0; i < signalCount; ++i)
+        {
+            auto& reader = readers[i];
+            reader.setOnDataAvailable(
+                [&reader, &latencies = latencies[i], &sync = latencySync[i]]()
+                {
+                    double values[1000];
+                    int64_t domain[1000];
+                    SizeT count = 1000;
+                    reader.readWithDomain(values, domain, &count);
+                    if (count == 0)
+                        return;
+
+                    const auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch());
+                    std::scoped_lock lock(sync);
+                    latencies.push_back(now - std::chrono::microseconds(domain[count - 1]));
+                });
+        }
+
+        std::this_thread::sleep_for(duration);
+
+        for (auto& reader : readers)
+            reader.setOnDataAvailable(nullptr);
+
+        for (size_t i = 0; i < signalCount; ++i)
+        {
+            std::scoped_lock lock(latencySync[i]);
+            std::sort(latencies[i].begin(), latencies[i].end());
+        }
+        return latencies;
+    }
 }
 
 END_NAMESPACE_OPENDAQ
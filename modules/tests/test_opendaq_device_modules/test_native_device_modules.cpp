@@ -114,6 +114,47 @@ TEST_F(NativeDeviceModulesTest, GetSetDeviceProperties)
     ASSERT_EQ(properties.getCount(), 6u);
 }
 
+TEST_F(NativeDeviceModulesTest, ConcurrentConfigRequests)
+{
+    SKIP_TEST_MAC_CI;
+    auto server = CreateServerInstance();
+    auto client = CreateClientInstance();
+
+    auto clientChannels = client.getDevices()[0].getDevices()[0].getChannels();
+    auto serverChannels = server.getDevices()[0].getChannels();
+    ASSERT_EQ(clientChannels.getCount(), 2u);
+
+    // requests of all threads are in flight at once, each reply must reach the thread that sent the request
+    const std::vector<std::string> propNames{"Frequency", "Amplitude", "DC", "NoiseAmplitude"};
+    std::vector<std::future<void>> requests;
+    for (size_t i = 0; i < clientChannels.getCount(); ++i)
+    {
+        for (const auto& propName : propNames)
+        {
+            requests.push_back(std::async(std::launch::async,
+                                          [channel = clientChannels[i], propName, i]()
+                                          {
+                                              for (int j = 1; j <= 10; ++j)
+                                              {
+                                                  const Float value = static_cast<Float>(i + j) / 10.0;
+                                                  channel.setPropertyValue(propName, value);
+                                                  ASSERT_EQ(channel.getPropertyValue(propName), value);
+                                              }
+                                          }));
+        }
+    }
+
+    for (auto& request : requests)
+        ASSERT_NO_THROW(request.get());
+
+    for (size_t i = 0; i < serverChannels.getCount(); ++i)
+    {
+        const Float expected = static_cast<Float>(i + 10) / 10.0;
+        for (const auto& propName : propNames)
+            ASSERT_EQ(serverChannels[i].getPropertyValue(propName), expected);
+    }
+}
+
 TEST_F(NativeDeviceModulesTest, DeviceInfo)
 {
     SKIP_TEST_MAC_CI;
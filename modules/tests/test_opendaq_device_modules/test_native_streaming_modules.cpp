@@ -136,6 +136,96 @@ TEST_F(NativeStreamingModulesTest, SubscribeReadUnsubscribe)
     ASSERT_EQ(domainUnsubscribeFuture.get(), streamingSource);
 }
 
+TEST_F(NativeStreamingModulesTest, StreamSignalsConcurrently)
+{
+    SKIP_TEST_MAC_CI;
+    auto server = CreateServerInstance();
+    auto client = CreateClientInstance();
+
+    auto signals = test_helpers::getValueSignals(client.getRootDevice());
+    ASSERT_GE(signals.size(), 2u);
+    signals.resize(2);
+
+    // each signal is forwarded by the server as soon as its packets are available, so packets arrive
+    // well within the 20 ms a polling server waits between reads
+    const auto latencies = test_helpers::readSignalsConcurrently(signals, std::chrono::milliseconds(1000));
+    for (const auto& signalLatencies : latencies)
+    {
+        ASSERT_FALSE(signalLatencies.empty());
+        const auto percentile90 = signalLatencies[signalLatencies.size() * 9 / 10];
+        EXPECT_LT(percentile90, std::chrono::milliseconds(20));
+    }
+}
+
+TEST_F(NativeStreamingModulesTest, ReferenceStatistics)
+{
+    SKIP_TEST_MAC_CI;
+    auto server = CreateServerInstance();
+    auto client = CreateClientInstance();
+
+    auto device = client.getDevices()[0];
+    auto signal = client.getSignalsRecursive()[0];
+    StreamReaderPtr reader = daq::StreamReader<double, uint64_t>(signal);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    // values are read from the live connection on each access
+    ASSERT_NO_THROW(device.getPropertyValue("ReferencedPackets"));
+    ASSERT_NO_THROW(device.getPropertyValue("ReferencedBytes"));
+    ASSERT_NO_THROW(device.getPropertyValue("WaitingPacketBuffers"));
+    ASSERT_EQ(device.getPropertyValue("ReferenceLimitHits"), 0);
+    ASSERT_ANY_THROW(device.setPropertyValue("ReferenceLimitHits", 1));
+}
+
+TEST_F(NativeStreamingModulesTest, SharedMemoryTransportDisabledByDefault)
+{
+    auto instance = Instance();
+    auto config = instance.getAvailableDeviceTypes().get("daq.nsd").createDefaultConfig();
+    PropertyObjectPtr transportLayerConfig = config.getPropertyValue("TransportLayerConfig");
+    ASSERT_FALSE(transportLayerConfig.getPropertyValue("SharedMemoryTransport"));
+}
+
+TEST_F(NativeStreamingModulesTest, SubscribeReadSharedMemoryTransport)
+{
+    SKIP_TEST_MAC_CI;
+#if !defined(__linux__)
+    GTEST_SKIP() << "Shared memory transport is supported on Linux only";
+#endif
+    auto server = CreateServerInstance();
+    // packets of 200 float64 samples are large enough to be passed through the shared memory ring
+    for (const auto& channel : server.getChannels(search::Recursive(search::Any())))
+    {
+        channel.setPropertyValue("FixedPacketSize", True);
+        channel.setPropertyValue("PacketSize", 200);
+    }
+
+    auto client = Instance();
+    auto config = client.getAvailableDeviceTypes().get("daq.nsd").createDefaultConfig();
+    PropertyObjectPtr transportLayerConfig = config.getPropertyValue("TransportLayerConfig");
+    transportLayerConfig.setPropertyValue("SharedMemoryTransport", True);
+    client.addDevice("daq.nsd://127.0.0.1/", config);
+
+    auto signal = client.getSignalsRecursive()[0].template asPtr<IMirroredSignalConfig>();
+
+    std::promise<StringPtr> signalSubscribePromise;
+    std::future<StringPtr> signalSubscribeFuture;
+    test_helpers::setupSubscribeAckHandler(signalSubscribePromise, signalSubscribeFuture, signal);
+
+    using namespace std::chrono_literals;
+    StreamReaderPtr reader = daq::StreamReader<double, uint64_t>(signal);
+    ASSERT_TRUE(test_helpers::waitForAcknowledgement(signalSubscribeFuture));
+
+    SizeT total = 0;
+    double samples[1000];
+    for (int i = 0; i < 10; ++i)
+    {
+        std::this_thread::sleep_for(100ms);
+        SizeT count = 1000;
+        reader.read(samples, &count);
+        total += count;
+    }
+    ASSERT_GT(total, 0u);
+}
+
 TEST_F(NativeStreamingModulesTest, DISABLED_RenderSignal)
 {
     auto server = CreateServerInstance();
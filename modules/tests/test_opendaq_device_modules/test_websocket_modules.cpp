@@ -135,6 +135,27 @@ TEST_F(WebsocketModulesTest, SubscribeReadUnsubscribe)
     ASSERT_EQ(signalUnsubscribeFuture.get(), streamingSource);
 }
 
+TEST_F(WebsocketModulesTest, StreamSignalsConcurrently)
+{
+    SKIP_TEST_MAC_CI;
+    auto server = CreateServerInstance();
+    auto client = CreateClientInstance();
+
+    auto signals = test_helpers::getValueSignals(client.getRootDevice());
+    ASSERT_GE(signals.size(), 2u);
+    signals.resize(2);
+
+    // each signal is forwarded by the server as soon as its packets are available, so packets arrive
+    // well within the 20 ms a polling server waits between reads
+    const auto latencies = test_helpers::readSignalsConcurrently(signals, std::chrono::milliseconds(1000));
+    for (const auto& signalLatencies : latencies)
+    {
+        ASSERT_FALSE(signalLatencies.empty());
+        const auto percentile90 = signalLatencies[signalLatencies.size() * 9 / 10];
+        EXPECT_LT(percentile90, std::chrono::milliseconds(20));
+    }
+}
+
 TEST_F(WebsocketModulesTest, DISABLED_RenderSignal)
 {
     auto server = CreateServerInstance();
@@ -18,6 +18,16 @@ WebsocketStreamingServerImpl::WebsocketStreamingServerImpl(DevicePtr rootDevice,
 
     websocketStreamingServer.setStreamingPort(streamingPort);
     websocketStreamingServer.setControlPort(controlPort);
+    if (config.hasProperty("UseMultiThreadedScheduler"))
+    {
+        const bool useMultiThreadedScheduler = config.getPropertyValue("UseMultiThreadedScheduler");
+        websocketStreamingServer.setUseMultiThreadedScheduler(useMultiThreadedScheduler);
+    }
+    if (config.hasProperty("CoalescePackets"))
+    {
+        const bool coalescePackets = config.getPropertyValue("CoalescePackets");
+        websocketStreamingServer.setCoalescePackets(coalescePackets);
+    }
     websocketStreamingServer.start();
 }
 
@@ -36,6 +46,12 @@ PropertyObjectPtr WebsocketStreamingServerImpl::createDefaultConfig()
         IntPropertyBuilder("WebsocketControlPort", 7438).setMinValue(minPortValue).setMaxValue(maxPortValue).build();
     defaultConfig.addProperty(websocketControlPortProp);
 
+    defaultConfig.addProperty(BoolProperty("UseMultiThreadedScheduler", true));
+
+    // forwards the packets of a signal enqueued while a read is pending together,
+    // disable to send each packet on its own as soon as it is read
+    defaultConfig.addProperty(BoolProperty("CoalescePackets", true));
+
     return defaultConfig;
 }
 
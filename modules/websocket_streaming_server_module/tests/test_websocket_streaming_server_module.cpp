@@ -126,6 +126,12 @@ TEST_F(WebsocketStreamingServerModuleTest, ServerConfig)
 
     ASSERT_TRUE(config.hasProperty("WebsocketControlPort"));
     ASSERT_EQ(config.getPropertyValue("WebsocketControlPort"), 7438);
+
+    ASSERT_TRUE(config.hasProperty("UseMultiThreadedScheduler"));
+    ASSERT_EQ(config.getPropertyValue("UseMultiThreadedScheduler"), true);
+
+    ASSERT_TRUE(config.hasProperty("CoalescePackets"));
+    ASSERT_EQ(config.getPropertyValue("CoalescePackets"), true);
 }
 
 TEST_F(WebsocketStreamingServerModuleTest, CreateServer)
@@ -19,14 +19,20 @@
 #include <opendaq/folder_impl.h>
 
 #include <opendaq/component_holder_ptr.h>
+#include <atomic>
 
 namespace daq::config_protocol
 {
 
+DECLARE_OPENDAQ_INTERFACE(IConfigClientFolderPrivate, IBaseObject)
+{
+    virtual bool INTERFACE_FUNC getItemsLoaded() = 0;
+};
+
 template <class Impl>
 class ConfigClientBaseFolderImpl;
 
-using ConfigClientFolderImpl = ConfigClientBaseFolderImpl<FolderImpl<IFolderConfig, IConfigClientObject>>;
+using ConfigClientFolderImpl = ConfigClientBaseFolderImpl<FolderImpl<IFolderConfig, IConfigClientObject, IConfigClientFolderPrivate>>;
 
 template <class Impl>
 class ConfigClientBaseFolderImpl : public ConfigClientComponentBaseImpl<Impl>
@@ -47,6 +53,15 @@ public:
                                const StringPtr& localId,
                                const StringPtr& className = nullptr);
 
+    // IFolder
+    ErrCode INTERFACE_FUNC getItems(IList** items, ISearchFilter* searchFilter = nullptr) override;
+    ErrCode INTERFACE_FUNC getItem(IString* localId, IComponent** item) override;
+    ErrCode INTERFACE_FUNC isEmpty(Bool* empty) override;
+    ErrCode INTERFACE_FUNC hasItem(IString* localId, Bool* value) override;
+
+    // IConfigClientFolderPrivate
+    bool INTERFACE_FUNC getItemsLoaded() override;
+
     static ErrCode Deserialize(ISerializedObject* serialized, IBaseObject* context, IFunction* factoryCallback, IBaseObject** obj);
 
 protected:
@@ -56,8 +71,17 @@ protected:
                                                  const FunctionPtr& factoryCallback);
 
     void handleRemoteCoreObjectInternal(const ComponentPtr& sender, const CoreEventArgsPtr& args) override;
+    void serializeCustomObjectValues(const SerializerPtr& serializer, bool forUpdate) override;
+    void deserializeCustomObjectValues(const SerializedObjectPtr& serializedObject,
+                                       const BaseObjectPtr& context,
+                                       const FunctionPtr& factoryCallback) override;
 
 private:
+    // false when the server left out the items of this folder; they are requested on first access
+    std::atomic<bool> itemsLoaded{true};
+    std::mutex loadSync;
+
+    void loadItems();
     void componentAdded(const CoreEventArgsPtr& args);
     void componentRemoved(const CoreEventArgsPtr& args);
 };
@@ -87,6 +111,52 @@ ConfigClientBaseFolderImpl<Impl>::ConfigClientBaseFolderImpl(const ConfigProtoco
 {
 }
 
+template <class Impl>
+ErrCode ConfigClientBaseFolderImpl<Impl>::getItems(IList** items, ISearchFilter* searchFilter)
+{
+    const ErrCode errCode = daqTry([this] { loadItems(); });
+    if (OPENDAQ_FAILED(errCode))
+        return errCode;
+
+    return Impl::getItems(items, searchFilter);
+}
+
+template <class Impl>
+ErrCode ConfigClientBaseFolderImpl<Impl>::getItem(IString* localId, IComponent** item)
+{
+    const ErrCode errCode = daqTry([this] { loadItems(); });
+    if (OPENDAQ_FAILED(errCode))
+        return errCode;
+
+    return Impl::getItem(localId, item);
+}
+
+template <class Impl>
+ErrCode ConfigClientBaseFolderImpl<Impl>::isEmpty(Bool* empty)
+{
+    const ErrCode errCode = daqTry([this] { loadItems(); });
+    if (OPENDAQ_FAILED(errCode))
+        return errCode;
+
+    return Impl::isEmpty(empty);
+}
+
+template <class Impl>
+ErrCode ConfigClientBaseFolderImpl<Impl>::hasItem(IString* localId, Bool* value)
+{
+    const ErrCode errCode = daqTry([this] { loadItems(); });
+    if (OPENDAQ_FAILED(errCode))
+        return errCode;
+
+    return Impl::hasItem(localId, value);
+}
+
+template <class Impl>
+bool ConfigClientBaseFolderImpl<Impl>::getItemsLoaded()
+{
+    return itemsLoaded;
+}
+
 template <class Impl>
 ErrCode ConfigClientBaseFolderImpl<Impl>::Deserialize(ISerializedObject* serialized,
     IBaseObject* context,
@@ -173,9 +243,71 @@ void ConfigClientBaseFolderImpl<Impl>::handleRemoteCoreObjectInternal(const Comp
     ConfigClientComponentBaseImpl<Impl>::handleRemoteCoreObjectInternal(sender, args);
 }
 
+template <class Impl>
+void ConfigClientBaseFolderImpl<Impl>::serializeCustomObjectValues(const SerializerPtr& serializer, bool forUpdate)
+{
+    loadItems();
+    ConfigClientComponentBaseImpl<Impl>::serializeCustomObjectValues(serializer, forUpdate);
+}
+
+template <class Impl>
+void ConfigClientBaseFolderImpl<Impl>::deserializeCustomObjectValues(const SerializedObjectPtr& serializedObject,
+                                                                     const BaseObjectPtr& context,
+                                                                     const FunctionPtr& factoryCallback)
+{
+    ConfigClientComponentBaseImpl<Impl>::deserializeCustomObjectValues(serializedObject, context, factoryCallback);
+
+    if (serializedObject.hasKey("lazyItems"))
+        itemsLoaded = false;
+}
+
+template <class Impl>
+void ConfigClientBaseFolderImpl<Impl>::loadItems()
+{
+    if (itemsLoaded)
+        return;
+
+    std::scoped_lock loadLock(loadSync);
+    if (itemsLoaded)
+        return;
+
+    auto params = Dict<IString, IBaseObject>();
+    params.set("ItemsDepth", static_cast<Int>(this->clientComm->getPrefetchDepth()));
+    const ListPtr<IComponentHolder> holders =
+        this->clientComm->sendComponentCommand(this->remoteGlobalId, "GetComponentItems", params, this->template borrowPtr<ComponentPtr>());
+
+    std::vector<ComponentPtr> newItems;
+    {
+        std::scoped_lock lock(this->sync);
+        for (const auto& holder : holders)
+        {
+            const auto comp = holder.getComponent();
+            if (this->addItemInternal(comp))
+                newItems.push_back(comp);
+        }
+
+        if (!this->coreEventMuted)
+            for (const auto& comp : newItems)
+                comp.template asPtr<IPropertyObjectInternal>().enableCoreEventTrigger();
+    }
+
+    // items are visible from here on, so resolving signal ids in this folder does not request them again
+    itemsLoaded = true;
+
+    for (const auto& comp : newItems)
+    {
+        this->clientComm->connectDomainSignals(comp);
+        this->clientComm->connectInputPorts(comp);
+    }
+}
+
 template <class Impl>
 void ConfigClientBaseFolderImpl<Impl>::componentAdded(const CoreEventArgsPtr& args)
 {
+    // the item is part of the reply when the folder is loaded later
+    if (!itemsLoaded)
+        return;
+
     const ComponentPtr comp = args.getParameters().get("Component");
     Bool hasItem{false};
     checkErrorInfo(Impl::hasItem(comp.getLocalId(), &hasItem));
@@ -189,6 +321,9 @@ void ConfigClientBaseFolderImpl<Impl>::componentAdded(const CoreEventArgsPtr& ar
 template <class Impl>
 void ConfigClientBaseFolderImpl<Impl>::componentRemoved(const CoreEventArgsPtr& args)
 {
+    if (!itemsLoaded)
+        return;
+
     const StringPtr id = args.getParameters().get("Id");
     Bool hasItem{false};
     checkErrorInfo(Impl::hasItem(id, &hasItem));
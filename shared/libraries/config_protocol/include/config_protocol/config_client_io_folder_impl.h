@@ -21,10 +21,10 @@
 namespace daq::config_protocol
 {
 
-class ConfigClientIoFolderImpl : public ConfigClientBaseFolderImpl<IoFolderImpl<IConfigClientObject>>
+class ConfigClientIoFolderImpl : public ConfigClientBaseFolderImpl<IoFolderImpl<IConfigClientObject, IConfigClientFolderPrivate>>
 {
 public:
-    using Super = ConfigClientBaseFolderImpl<IoFolderImpl<IConfigClientObject>>;
+    using Super = ConfigClientBaseFolderImpl<IoFolderImpl<IConfigClientObject, IConfigClientFolderPrivate>>;
 
     ConfigClientIoFolderImpl(const ConfigProtocolClientCommPtr& configProtocolClientComm,
                              const std::string& remoteGlobalId,
@@ -19,9 +19,12 @@
 #include <functional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <coretypes/string_ptr.h>
 #include <coretypes/dictobject_factory.h>
 #include <coretypes/baseobject_factory.h>
+#include <coretypes/serializer_ptr.h>
+#include <coretypes/deserializer_ptr.h>
 
 namespace daq::config_protocol
 {
@@ -39,7 +42,19 @@ inline auto ParamsDict(std::initializer_list<std::pair<const StringPtr, ObjectPt
 }
 
 
-enum PacketType: uint8_t { getProtocolInfo = 0x80, upgradeProtocol = 0x81, rpc = 0x82, serverNotification = 0x83, invalidRequest = 0x84 };
+// version 0 encodes RPC payloads as JSON, version 1 with the more compact binary serializer,
+// version 2 keeps the binary encoding and adds rpcBatch packets,
+// version 3 lets the server send a list of packed core events in one notification
+constexpr uint16_t JsonRpcProtocolVersion = 0;
+constexpr uint16_t BinaryRpcProtocolVersion = 1;
+constexpr uint16_t BatchRpcProtocolVersion = 2;
+constexpr uint16_t NotificationBatchProtocolVersion = 3;
+
+std::vector<uint16_t> getSupportedProtocolVersions();
+SerializerPtr createRpcSerializer(uint16_t protocolVersion);
+DeserializerPtr createRpcDeserializer(uint16_t protocolVersion);
+
+enum PacketType: uint8_t { getProtocolInfo = 0x80, upgradeProtocol = 0x81, rpc = 0x82, serverNotification = 0x83, invalidRequest = 0x84, rpcBatch = 0x85 };
 
 struct PacketHeader
 {
@@ -107,6 +122,10 @@ public:
     static PacketBuffer createRpcRequestOrReply(size_t id, const char* json, size_t jsonSize);
     StringPtr parseRpcRequestOrReply() const;
 
+    // payload is a serialized list of RPC requests, the reply carries the list of RPC replies in the same order
+    static PacketBuffer createRpcBatchRequestOrReply(size_t id, const char* json, size_t jsonSize);
+    StringPtr parseRpcBatchRequestOrReply() const;
+
     static PacketBuffer createServerNotification(const char* json, size_t jsonSize);
     StringPtr parseServerNotification() const;
 
@@ -29,14 +29,24 @@
 #include <coreobjects/core_event_args_factory.h>
 
 #include "opendaq/custom_log.h"
+#include <algorithm>
+#include <future>
 
 namespace daq::config_protocol
 {
 
 using SendRequestCallback = std::function<PacketBuffer(PacketBuffer&)>;
+// sends the request without waiting for the reply; the returned future is fulfilled when the reply with the same id arrives
+using SendRequestAsyncCallback = std::function<std::future<PacketBuffer>(PacketBuffer&)>;
 using ServerNotificationReceivedCallback = std::function<bool(const BaseObjectPtr& obj)>;
 using ComponentDeserializeCallback = std::function<ErrCode(ISerializedObject*, IBaseObject*, IFunction*, IBaseObject**)>;
 
+struct RpcCommand
+{
+    StringPtr name;
+    ParamsDictPtr params;
+};
+
 class ConfigProtocolClientComm : public std::enable_shared_from_this<ConfigProtocolClientComm>
 {
 public:
@@ -53,8 +63,28 @@ public:
     BaseObjectPtr callProperty(const std::string& globalId, const std::string& propertyName, const BaseObjectPtr& params);
     void setAttributeValue(const std::string& globalId, const std::string& attributeName, const BaseObjectPtr& attributeValue);
 
+    // the async variants only send the request, so several can be in flight at once;
+    // the reply is parsed (and errors are thrown) when the future is read
+    std::future<void> setPropertyValueAsync(const std::string& globalId, const std::string& propertyName, const BaseObjectPtr& propertyValue);
+    std::future<BaseObjectPtr> getPropertyValueAsync(const std::string& globalId, const std::string& propertyName);
+    std::future<BaseObjectPtr> sendCommandAsync(const StringPtr& command, const ParamsDictPtr& params = nullptr);
+
+    // sends all commands in a single rpcBatch packet, or pipelined when the server does not support batches;
+    // every command is executed, the first failure is thrown when the future is read
+    std::future<std::vector<BaseObjectPtr>> sendCommandBatchAsync(const std::vector<RpcCommand>& commands);
+    static RpcCommand createSetPropertyValueCommand(const std::string& globalId, const std::string& propertyName, const BaseObjectPtr& propertyValue);
+
+    void setSendRequestAsyncCallback(SendRequestAsyncCallback sendRequestAsyncCallback);
+
+    // in lazy mode only the top-level structure is requested on connect; folder items are requested on
+    // first access, together with prefetchDepth levels of nested items
+    void setLazyLoading(bool lazyLoading, SizeT prefetchDepth = 0);
+    bool getLazyLoading() const;
+    SizeT getPrefetchDepth() const;
+
     bool getConnected() const;
     ContextPtr getDaqContext();
+    uint16_t getProtocolVersion() const;
 
     BaseObjectPtr sendComponentCommand(const StringPtr& globalId,
                                        const StringPtr& command,
@@ -64,6 +94,7 @@ public:
     BaseObjectPtr sendCommand(const StringPtr& command, const ParamsDictPtr& params = nullptr);
 
     static SignalPtr findSignalByRemoteGlobalId(const DevicePtr& device, const std::string& remoteGlobalId);
+    static ComponentPtr findLoadedComponent(const ComponentPtr& component, const std::string& relativeId);
 
     void setRootDevice(const DevicePtr& rootDevice);
     DevicePtr getRootDevice() const;
@@ -82,10 +113,14 @@ private:
     ContextPtr daqContext;
     size_t id;
     SendRequestCallback sendRequestCallback;
+    SendRequestAsyncCallback sendRequestAsyncCallback;
     ComponentDeserializeCallback rootDeviceDeserializeCallback;
+    uint16_t protocolVersion;
     SerializerPtr serializer;
     DeserializerPtr deserializer;
     bool connected;
+    bool lazyLoading;
+    SizeT prefetchDepth;
     WeakRefPtr<IDevice> rootDeviceRef;
 
     ComponentDeserializeContextPtr createDeserializeContext(const std::string& remoteGlobalId,
@@ -100,7 +135,14 @@ private:
     BaseObjectPtr parseRpcReplyPacketBuffer(const PacketBuffer& packetBuffer,
                                             const ComponentDeserializeContextPtr& context = nullptr,
                                             bool isGetRootDeviceReply = false);
+    std::vector<BaseObjectPtr> parseRpcBatchReplyPacketBuffer(const PacketBuffer& packetBuffer, size_t expectedCount);
+    BaseObjectPtr deserializeRpcReply(const StringPtr& jsonStr,
+                                      const ComponentDeserializeContextPtr& context,
+                                      bool isGetRootDeviceReply);
+    static BaseObjectPtr parseRpcReply(const ParamsDictPtr& reply);
+    std::future<PacketBuffer> sendRequestAsync(PacketBuffer& packetBuffer);
     size_t generateId();
+    void setProtocolVersion(uint16_t protocolVersion);
 
     BaseObjectPtr sendComponentCommandInternal(const StringPtr& command,
                                                const ParamsDictPtr& params,
@@ -110,6 +152,7 @@ private:
     BaseObjectPtr requestRootDevice(const ComponentPtr& parentComponent);
 
     static SignalPtr findSignalByRemoteGlobalIdWithComponent(const ComponentPtr& component, const std::string& remoteGlobalId);
+    static bool itemsLoaded(const ComponentPtr& component);
 
     template <class Interface, class F>
     void forEachComponent(const ComponentPtr& component, const F& f);
@@ -187,13 +230,22 @@ DevicePtr ConfigProtocolClient<TRootDeviceImpl>::connect(const ComponentPtr& par
     std::vector<uint16_t> supportedVersions;
     getProtocolInfoReplyPacketBuffer.parseProtocolInfoReply(currentVersion, supportedVersions);
 
-    if (currentVersion != 0)
+    if (currentVersion != JsonRpcProtocolVersion)
         throw ConfigProtocolException("Invalid server protocol version");
 
-    if (std::find(supportedVersions.begin(), supportedVersions.end(), 0) == supportedVersions.end())
+    // the highest version supported by both sides is used, servers without binary support stay on JSON
+    const auto clientVersions = getSupportedProtocolVersions();
+    int version = -1;
+    for (const auto serverVersion : supportedVersions)
+    {
+        if (std::find(clientVersions.begin(), clientVersions.end(), serverVersion) != clientVersions.end())
+            version = std::max<int>(version, serverVersion);
+    }
+
+    if (version < 0)
         throw ConfigProtocolException("Protocol not supported on server");
 
-    auto upgradeProtocolRequestPacketBuffer = PacketBuffer::createUpgradeProtocolRequest(clientComm->generateId(), 0);
+    auto upgradeProtocolRequestPacketBuffer = PacketBuffer::createUpgradeProtocolRequest(clientComm->generateId(), static_cast<uint16_t>(version));
     const auto upgradeProtocolReplyPacketBuffer = sendRequestCallback(upgradeProtocolRequestPacketBuffer);
 
     bool success;
@@ -202,6 +254,8 @@ DevicePtr ConfigProtocolClient<TRootDeviceImpl>::connect(const ComponentPtr& par
     if (!success)
         throw ConfigProtocolException("Protocol upgrade failed");
 
+    clientComm->setProtocolVersion(static_cast<uint16_t>(version));
+
     const auto localTypeManager = daqContext.getTypeManager();
     const TypeManagerPtr typeManager = clientComm->sendCommand("GetTypeManager");
     const auto types = typeManager.getTypes();
@@ -278,6 +332,10 @@ ComponentPtr ConfigProtocolClient<TRootDeviceImpl>::findComponent(std::string gl
     if (globalId.find_first_of('/') == 0)
         globalId.erase(globalId.begin(), globalId.begin() + 1);
 
+    // components in folders that were not loaded yet are not looked up, their events are dropped
+    if (clientComm->getLazyLoading())
+        return ConfigProtocolClientComm::findLoadedComponent(rootDevice, globalId);
+
     return rootDevice.findComponent(globalId);
 }
 
@@ -285,7 +343,18 @@ template<class TRootDeviceImpl>
 void ConfigProtocolClient<TRootDeviceImpl>::triggerNotificationObject(const BaseObjectPtr& object)
 {
     ListPtr<IBaseObject> packedEvent = object.asPtrOrNull<IList>();
-    if (!packedEvent.assigned() || packedEvent.getCount() != 2)
+    if (!packedEvent.assigned() || packedEvent.getCount() == 0)
+        return;
+
+    // coalesced notifications carry a list of packed events
+    if (packedEvent[0].supportsInterface<IList>())
+    {
+        for (const auto& item : packedEvent)
+            triggerNotificationObject(item);
+        return;
+    }
+
+    if (packedEvent.getCount() != 2)
         return;
 
     const ComponentPtr component = findComponent(packedEvent[0]);
@@ -20,6 +20,13 @@
 #include <opendaq/device_ptr.h>
 
 #include <opendaq/component_holder_ptr.h>
+#include <coretypes/weakrefptr.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <thread>
 
 namespace daq::config_protocol
 {
@@ -30,6 +37,8 @@ class IComponentFinder
 {
 public:
     virtual ComponentPtr findComponent(const std::string& globalId) = 0;
+    // called by the server for core events of the root device context
+    virtual void onCoreEvent(const ComponentPtr& /*component*/, const CoreEventArgsPtr& /*eventArgs*/) {}
     virtual ~IComponentFinder() = default;
 };
 
@@ -38,8 +47,15 @@ class ComponentFinderRootDevice: public IComponentFinder
 public:
     ComponentFinderRootDevice(DevicePtr rootDevice);
     ComponentPtr findComponent(const std::string& globalId) override;
+    void onCoreEvent(const ComponentPtr& component, const CoreEventArgsPtr& eventArgs) override;
 private:
     DevicePtr rootDevice;
+    // global id to component, filled on lookups and added components and pruned on removal;
+    // entries are validated when used, so a missed core event only costs a walk of the tree
+    std::unordered_map<std::string, WeakRefPtr<IComponent>> index;
+    std::mutex indexSync;
+
+    ComponentPtr findComponentInTree(const std::string& globalId) const;
     static ComponentPtr findComponentInternal(const ComponentPtr& component, const std::string& id);
 };
 
@@ -65,12 +81,18 @@ public:
     void setComponentFinder(std::unique_ptr<IComponentFinder>& componentFinder);
     std::unique_ptr<IComponentFinder>& getComponentFinder();
 
+    // core events raised within the window are sent as a single notification and superseded
+    // property value changes are dropped; only applies to clients which negotiated
+    // NotificationBatchProtocolVersion, 0 sends each event as it is raised
+    void setNotificationCoalescingWindow(std::chrono::milliseconds window);
+
 private:
     using DispatchFunction = std::function<BaseObjectPtr(const ParamsDictPtr&)>;
 
     DevicePtr rootDevice;
     ContextPtr daqContext;
     NotificationReadyCallback notificationReadyCallback;
+    uint16_t protocolVersion;
     DeserializerPtr deserializer;
     SerializerPtr serializer;
     SerializerPtr notificationSerializer;
@@ -78,13 +100,31 @@ private:
     std::mutex notificationSerializerLock;
     std::unique_ptr<IComponentFinder> componentFinder;
 
+    std::atomic<bool> notificationBatchesSupported;
+    std::chrono::milliseconds notificationWindow;
+    std::vector<ListPtr<IBaseObject>> pendingNotifications;
+    std::unordered_map<std::string, size_t> pendingPropertyChanges;
+    std::mutex pendingNotificationsSync;
+    std::mutex notificationFlushSync;
+    std::condition_variable pendingNotificationsCv;
+    bool notificationThreadStopped;
+    std::thread notificationThread;
+
+    bool queueNotification(const ListPtr<IBaseObject>& packedEvent, const CoreEventArgsPtr& eventArgs);
+    void flushNotifications();
+    void notificationThreadFunc();
+    void stopNotificationThread();
+
     PacketBuffer processPacket(const PacketBuffer& packetBuffer);
     StringPtr processRpc(const StringPtr& jsonStr);
+    StringPtr processRpcBatch(const StringPtr& jsonStr);
+    DictPtr<IString, IBaseObject> processRpcRequest(const BaseObjectPtr& request);
 
     BaseObjectPtr callRpc(const StringPtr& name, const ParamsDictPtr& params);
     ComponentPtr findComponent(const std::string& componentGlobalId) const;
 
     BaseObjectPtr getComponent(const ParamsDictPtr& params) const;
+    BaseObjectPtr getComponentItems(const ParamsDictPtr& params) const;
     BaseObjectPtr getTypeManager(const ParamsDictPtr& params) const;
 
     template <class SmartPtr, class F>
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <coretypes/intfs.h>
+#include <coretypes/serializer_ptr.h>
+#include <coretypes/serializable_ptr.h>
+#include <vector>
+
+namespace daq::config_protocol
+{
+
+// Forwards to another serializer but leaves out the items of folders nested deeper than maxItemsDepth
+// item levels. A folder whose items were left out gets a "lazyItems" key instead, so the client can
+// fetch them when they are first accessed.
+class LimitedDepthSerializerImpl : public ImplementationOf<ISerializer>
+{
+public:
+    LimitedDepthSerializerImpl(SerializerPtr serializer, SizeT maxItemsDepth);
+
+    ErrCode INTERFACE_FUNC startTaggedObject(ISerializable* serializable) override;
+    ErrCode INTERFACE_FUNC startObject() override;
+    ErrCode INTERFACE_FUNC endObject() override;
+
+    ErrCode INTERFACE_FUNC startList() override;
+    ErrCode INTERFACE_FUNC endList() override;
+
+    ErrCode INTERFACE_FUNC getOutput(IString** output) override;
+
+    ErrCode INTERFACE_FUNC key(ConstCharPtr string) override;
+    ErrCode INTERFACE_FUNC keyStr(IString* name) override;
+    ErrCode INTERFACE_FUNC keyRaw(ConstCharPtr string, SizeT length) override;
+
+    ErrCode INTERFACE_FUNC writeInt(Int integer) override;
+    ErrCode INTERFACE_FUNC writeBool(Bool boolean) override;
+    ErrCode INTERFACE_FUNC writeFloat(Float real) override;
+    ErrCode INTERFACE_FUNC writeString(ConstCharPtr string, SizeT length) override;
+    ErrCode INTERFACE_FUNC writeNull() override;
+
+    ErrCode INTERFACE_FUNC reset() override;
+    ErrCode INTERFACE_FUNC isComplete(Bool* complete) override;
+
+private:
+    enum class Scope
+    {
+        Folder,
+        Items,
+        Other
+    };
+
+    SerializerPtr serializer;
+    SizeT maxItemsDepth;
+    SizeT itemsDepth;
+    bool itemsKeyWritten;
+    bool skipValue;
+    SizeT skippedLevels;
+    std::vector<Scope> scopes;
+
+    ErrCode handleKey(const char* string, SizeT length, bool& forward);
+    ErrCode start(Scope scope, bool& forward);
+    bool end();
+    bool writeValue();
+};
+
+// Serializes the wrapped object through a LimitedDepthSerializerImpl. Used as an RPC return value,
+// it adds nothing of its own to the output.
+class LimitedDepthSerializableImpl : public ImplementationOf<ISerializable>
+{
+public:
+    LimitedDepthSerializableImpl(BaseObjectPtr object, SizeT maxItemsDepth);
+
+    ErrCode INTERFACE_FUNC serialize(ISerializer* serializer) override;
+    ErrCode INTERFACE_FUNC getSerializeId(ConstCharPtr* id) const override;
+
+private:
+    BaseObjectPtr object;
+    SizeT maxItemsDepth;
+};
+
+inline SerializablePtr LimitedDepthSerializable(const BaseObjectPtr& object, SizeT maxItemsDepth)
+{
+    return createWithImplementation<ISerializable, LimitedDepthSerializableImpl>(object, maxItemsDepth);
+}
+
+}
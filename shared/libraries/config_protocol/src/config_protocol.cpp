@@ -1,6 +1,10 @@
 #include <config_protocol/config_protocol.h>
 #include <cassert>
 #include <coretypes/stringobject_factory.h>
+#include <coretypes/json_serializer_factory.h>
+#include <coretypes/json_deserializer_factory.h>
+#include <coretypes/binary_serializer_factory.h>
+#include <coretypes/binary_deserializer_factory.h>
 
 namespace daq::config_protocol
 {
@@ -290,6 +294,26 @@ StringPtr PacketBuffer::parseRpcRequestOrReply() const
     return jsonStr;
 }
 
+PacketBuffer PacketBuffer::createRpcBatchRequestOrReply(size_t id, const char* json, size_t jsonSize)
+{
+    auto packetBuffer = PacketBuffer(PacketType::rpcBatch, id, json, jsonSize);
+    return packetBuffer;
+}
+
+StringPtr PacketBuffer::parseRpcBatchRequestOrReply() const
+{
+    if (getPacketType() != PacketType::rpcBatch)
+        throw ConfigProtocolException("Invalid packet type");
+
+    const auto payloadSize = getPayloadSize();
+
+    if (payloadSize == 0)
+        throw ConfigProtocolException("Invalid payload");
+
+    auto jsonStr = String(static_cast<char*>(getPayload()), payloadSize);
+    return jsonStr;
+}
+
 PacketBuffer PacketBuffer::createServerNotification(const char* json, size_t jsonSize)
 {
     auto packetBuffer = PacketBuffer(PacketType::serverNotification, std::numeric_limits<size_t>::max(), json, jsonSize);
@@ -310,6 +334,41 @@ StringPtr PacketBuffer::parseServerNotification() const
     return jsonStr;
 }
 
+std::vector<uint16_t> getSupportedProtocolVersions()
+{
+    return {JsonRpcProtocolVersion, BinaryRpcProtocolVersion, BatchRpcProtocolVersion, NotificationBatchProtocolVersion};
+}
+
+SerializerPtr createRpcSerializer(uint16_t protocolVersion)
+{
+    switch (protocolVersion)
+    {
+        case JsonRpcProtocolVersion:
+            return JsonSerializer();
+        case BinaryRpcProtocolVersion:
+        case BatchRpcProtocolVersion:
+        case NotificationBatchProtocolVersion:
+            return BinarySerializer();
+        default:
+            throw ConfigProtocolException("Unsupported protocol version");
+    }
+}
+
+DeserializerPtr createRpcDeserializer(uint16_t protocolVersion)
+{
+    switch (protocolVersion)
+    {
+        case JsonRpcProtocolVersion:
+            return JsonDeserializer();
+        case BinaryRpcProtocolVersion:
+        case BatchRpcProtocolVersion:
+        case NotificationBatchProtocolVersion:
+            return BinaryDeserializer();
+        default:
+            throw ConfigProtocolException("Unsupported protocol version");
+    }
+}
+
 ConfigProtocolException::ConfigProtocolException(const std::string& msg)
     : runtime_error(msg)
 {
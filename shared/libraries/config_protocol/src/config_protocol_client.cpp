@@ -18,9 +18,12 @@ ConfigProtocolClientComm::ConfigProtocolClientComm(const ContextPtr& daqContext,
         , id(0)
         , sendRequestCallback(std::move(sendRequestCallback))
         , rootDeviceDeserializeCallback(std::move(rootDeviceDeserializeCallback))
-        , serializer(JsonSerializer())
-        , deserializer(JsonDeserializer())
+        , protocolVersion(JsonRpcProtocolVersion)
+        , serializer(createRpcSerializer(protocolVersion))
+        , deserializer(createRpcDeserializer(protocolVersion))
         , connected(false)
+        , lazyLoading(false)
+        , prefetchDepth(0)
 {
 }
 
@@ -29,6 +32,18 @@ size_t ConfigProtocolClientComm::generateId()
     return id++;
 }
 
+void ConfigProtocolClientComm::setProtocolVersion(uint16_t protocolVersion)
+{
+    this->protocolVersion = protocolVersion;
+    serializer = createRpcSerializer(protocolVersion);
+    deserializer = createRpcDeserializer(protocolVersion);
+}
+
+uint16_t ConfigProtocolClientComm::getProtocolVersion() const
+{
+    return protocolVersion;
+}
+
 void ConfigProtocolClientComm::setPropertyValue(
     const std::string& globalId,
     const std::string& propertyName,
@@ -118,6 +133,119 @@ void ConfigProtocolClientComm::setAttributeValue(const std::string& globalId,
     parseRpcReplyPacketBuffer(setAttributeValueRpcReplyPacketBuffer);
 }
 
+std::future<void> ConfigProtocolClientComm::setPropertyValueAsync(const std::string& globalId,
+                                                                 const std::string& propertyName,
+                                                                 const BaseObjectPtr& propertyValue)
+{
+    const auto command = createSetPropertyValueCommand(globalId, propertyName, propertyValue);
+    auto requestPacketBuffer = createRpcRequestPacketBuffer(generateId(), command.name, command.params);
+    auto replyFuture = sendRequestAsync(requestPacketBuffer);
+
+    return std::async(std::launch::deferred,
+                      [self = shared_from_this(), replyFuture = std::move(replyFuture)]() mutable
+                      {
+                          // ReSharper disable once CppExpressionWithoutSideEffects
+                          self->parseRpcReplyPacketBuffer(replyFuture.get());
+                      });
+}
+
+std::future<BaseObjectPtr> ConfigProtocolClientComm::getPropertyValueAsync(const std::string& globalId, const std::string& propertyName)
+{
+    auto dict = Dict<IString, IBaseObject>();
+    dict.set("ComponentGlobalId", String(globalId));
+    dict.set("PropertyName", String(propertyName));
+    auto requestPacketBuffer = createRpcRequestPacketBuffer(generateId(), "GetPropertyValue", dict);
+    auto replyFuture = sendRequestAsync(requestPacketBuffer);
+
+    return std::async(std::launch::deferred,
+                      [self = shared_from_this(), replyFuture = std::move(replyFuture)]() mutable
+                      {
+                          const auto deserializeContext =
+                              self->createDeserializeContext(std::string{}, self->daqContext, nullptr, nullptr, nullptr, nullptr);
+                          return self->parseRpcReplyPacketBuffer(replyFuture.get(), deserializeContext);
+                      });
+}
+
+std::future<BaseObjectPtr> ConfigProtocolClientComm::sendCommandAsync(const StringPtr& command, const ParamsDictPtr& params)
+{
+    auto requestPacketBuffer = createRpcRequestPacketBuffer(generateId(), command, params);
+    auto replyFuture = sendRequestAsync(requestPacketBuffer);
+
+    return std::async(std::launch::deferred,
+                      [self = shared_from_this(), replyFuture = std::move(replyFuture)]() mutable
+                      {
+                          return self->parseRpcReplyPacketBuffer(replyFuture.get(), nullptr);
+                      });
+}
+
+std::future<std::vector<BaseObjectPtr>> ConfigProtocolClientComm::sendCommandBatchAsync(const std::vector<RpcCommand>& commands)
+{
+    if (protocolVersion < BatchRpcProtocolVersion)
+    {
+        std::vector<std::future<BaseObjectPtr>> replyFutures;
+        replyFutures.reserve(commands.size());
+        for (const auto& command : commands)
+            replyFutures.push_back(sendCommandAsync(command.name, command.params));
+
+        return std::async(std::launch::deferred,
+                          [replyFutures = std::move(replyFutures)]() mutable
+                          {
+                              // wait for all replies so that no request is left in flight when one of them fails
+                              std::vector<BaseObjectPtr> results;
+                              std::exception_ptr firstError;
+                              for (auto& replyFuture : replyFutures)
+                              {
+                                  try
+                                  {
+                                      results.push_back(replyFuture.get());
+                                  }
+                                  catch (...)
+                                  {
+                                      if (!firstError)
+                                          firstError = std::current_exception();
+                                  }
+                              }
+
+                              if (firstError)
+                                  std::rethrow_exception(firstError);
+                              return results;
+                          });
+    }
+
+    auto requests = List<IBaseObject>();
+    for (const auto& command : commands)
+        requests.pushBack(createRpcRequest(command.name, command.params));
+
+    serializer.reset();
+    requests.serialize(serializer);
+    const auto jsonStr = serializer.getOutput();
+
+    auto requestPacketBuffer = PacketBuffer::createRpcBatchRequestOrReply(generateId(), jsonStr.getCharPtr(), jsonStr.getLength());
+    auto replyFuture = sendRequestAsync(requestPacketBuffer);
+
+    return std::async(std::launch::deferred,
+                      [self = shared_from_this(), replyFuture = std::move(replyFuture), count = commands.size()]() mutable
+                      {
+                          return self->parseRpcBatchReplyPacketBuffer(replyFuture.get(), count);
+                      });
+}
+
+RpcCommand ConfigProtocolClientComm::createSetPropertyValueCommand(const std::string& globalId,
+                                                                   const std::string& propertyName,
+                                                                   const BaseObjectPtr& propertyValue)
+{
+    auto dict = Dict<IString, IBaseObject>();
+    dict.set("ComponentGlobalId", String(globalId));
+    dict.set("PropertyName", String(propertyName));
+    dict.set("PropertyValue", String(propertyValue));
+    return {"SetPropertyValue", dict};
+}
+
+void ConfigProtocolClientComm::setSendRequestAsyncCallback(SendRequestAsyncCallback sendRequestAsyncCallback)
+{
+    this->sendRequestAsyncCallback = std::move(sendRequestAsyncCallback);
+}
+
 BaseObjectPtr ConfigProtocolClientComm::createRpcRequest(const StringPtr& name, const ParamsDictPtr& params) const
 {
     auto obj = Dict<IString, IBaseObject>();
@@ -151,12 +279,43 @@ BaseObjectPtr ConfigProtocolClientComm::parseRpcReplyPacketBuffer(const PacketBu
                                                                   bool isGetRootDeviceReply)
 {
     const auto jsonStr = packetBuffer.parseRpcRequestOrReply();
+    const ParamsDictPtr reply = deserializeRpcReply(jsonStr, context, isGetRootDeviceReply);
+    return parseRpcReply(reply);
+}
 
-    ParamsDictPtr reply;
+std::vector<BaseObjectPtr> ConfigProtocolClientComm::parseRpcBatchReplyPacketBuffer(const PacketBuffer& packetBuffer, size_t expectedCount)
+{
+    const auto jsonStr = packetBuffer.parseRpcBatchRequestOrReply();
+    const auto deserializeContext = createDeserializeContext(std::string{}, daqContext, nullptr, nullptr, nullptr, nullptr);
+    const auto replyObj = deserializeRpcReply(jsonStr, deserializeContext, false);
+
+    // the server replies with a single error when it cannot parse the batch
+    if (replyObj.assigned() && replyObj.supportsInterface<IDict>())
+    {
+        parseRpcReply(replyObj);
+        throw ConfigProtocolException("Invalid reply");
+    }
+
+    const ListPtr<IBaseObject> replies = replyObj.asPtrOrNull<IList>(true);
+    if (!replies.assigned() || replies.getCount() != expectedCount)
+        throw ConfigProtocolException("Invalid reply");
+
+    std::vector<BaseObjectPtr> results;
+    results.reserve(expectedCount);
+    for (const auto& reply : replies)
+        results.push_back(parseRpcReply(reply));
+
+    return results;
+}
+
+BaseObjectPtr ConfigProtocolClientComm::deserializeRpcReply(const StringPtr& jsonStr,
+                                                            const ComponentDeserializeContextPtr& context,
+                                                            bool isGetRootDeviceReply)
+{
     try
     {
         ComponentDeserializeCallback customDeviceDeserilazeCallback = isGetRootDeviceReply ? rootDeviceDeserializeCallback : nullptr;
-        reply = deserializer.deserialize(
+        return deserializer.deserialize(
             jsonStr,
             context,
             [this, &customDeviceDeserilazeCallback](const StringPtr& typeId, const SerializedObjectPtr& object, const BaseObjectPtr& context, const FunctionPtr& factoryCallback)
@@ -168,8 +327,11 @@ BaseObjectPtr ConfigProtocolClientComm::parseRpcReplyPacketBuffer(const PacketBu
     {
         throw ConfigProtocolException(fmt::format("Invalid reply: {}", e.what()));
     }
+}
 
-    if (!reply.hasKey("ErrorCode"))
+BaseObjectPtr ConfigProtocolClientComm::parseRpcReply(const ParamsDictPtr& reply)
+{
+    if (!reply.assigned() || !reply.hasKey("ErrorCode"))
         throw ConfigProtocolException("Invalid reply");
 
     const ErrCode errCode = reply["ErrorCode"];
@@ -187,6 +349,17 @@ BaseObjectPtr ConfigProtocolClientComm::parseRpcReplyPacketBuffer(const PacketBu
     return {};
 }
 
+std::future<PacketBuffer> ConfigProtocolClientComm::sendRequestAsync(PacketBuffer& packetBuffer)
+{
+    if (sendRequestAsyncCallback)
+        return sendRequestAsyncCallback(packetBuffer);
+
+    // transport without async support, the request completes before returning
+    std::promise<PacketBuffer> reply;
+    reply.set_value(sendRequestCallback(packetBuffer));
+    return reply.get_future();
+}
+
 BaseObjectPtr ConfigProtocolClientComm::deserializeConfigComponent(const StringPtr& typeId,
                                                                    const SerializedObjectPtr& serObj,
                                                                    const BaseObjectPtr& context,
@@ -273,6 +446,22 @@ ComponentDeserializeContextPtr ConfigProtocolClientComm::createDeserializeContex
         shared_from_this(), remoteGlobalId, context, root, parent, localId, intfID);
 }
 
+void ConfigProtocolClientComm::setLazyLoading(bool lazyLoading, SizeT prefetchDepth)
+{
+    this->lazyLoading = lazyLoading;
+    this->prefetchDepth = prefetchDepth;
+}
+
+bool ConfigProtocolClientComm::getLazyLoading() const
+{
+    return lazyLoading;
+}
+
+SizeT ConfigProtocolClientComm::getPrefetchDepth() const
+{
+    return prefetchDepth;
+}
+
 bool ConfigProtocolClientComm::getConnected() const
 {
     return connected;
@@ -305,6 +494,8 @@ BaseObjectPtr ConfigProtocolClientComm::requestRootDevice(const ComponentPtr& pa
 {
     auto params = Dict<IString, IBaseObject>();
     params.set("ComponentGlobalId", "//root");
+    if (lazyLoading)
+        params.set("ItemsDepth", static_cast<Int>(prefetchDepth));
     return sendComponentCommandInternal("GetComponent", params, parentComponent, true);
 }
 
@@ -424,13 +615,46 @@ void ConfigProtocolClientComm::forEachComponent(const ComponentPtr& component, c
         f(comp);
 
     const auto folder = component.asPtrOrNull<IFolder>(true);
-    if (folder.assigned())
+    if (folder.assigned() && itemsLoaded(component))
     {
         for (const auto item : folder.getItems())
             forEachComponent<Interface>(item, f);
     }
 }
 
+bool ConfigProtocolClientComm::itemsLoaded(const ComponentPtr& component)
+{
+    const auto lazyFolder = component.asPtrOrNull<IConfigClientFolderPrivate>(true);
+    return !lazyFolder.assigned() || lazyFolder->getItemsLoaded();
+}
+
+ComponentPtr ConfigProtocolClientComm::findLoadedComponent(const ComponentPtr& component, const std::string& relativeId)
+{
+    if (relativeId.empty())
+        return component;
+
+    std::string startStr;
+    std::string restStr;
+    const bool hasSubComponentStr = IdsParser::splitRelativeId(relativeId, startStr, restStr);
+    if (!hasSubComponentStr)
+        startStr = relativeId;
+
+    const auto folder = component.asPtrOrNull<IFolder>(true);
+    if (!folder.assigned() || !itemsLoaded(component))
+        return nullptr;
+
+    if (folder.hasItem(startStr))
+    {
+        const auto subComponent = folder.getItem(startStr);
+        if (hasSubComponentStr)
+            return findLoadedComponent(subComponent, restStr);
+
+        return subComponent;
+    }
+
+    return nullptr;
+}
+
 SignalPtr ConfigProtocolClientComm::findSignalByRemoteGlobalIdWithComponent(const ComponentPtr& component,
                                                                             const std::string& remoteGlobalId)
 {
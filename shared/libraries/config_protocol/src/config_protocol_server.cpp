@@ -4,8 +4,10 @@
 #include <config_protocol/config_server_component.h>
 #include <config_protocol/config_server_device.h>
 #include <config_protocol/config_server_input_port.h>
+#include <config_protocol/limited_depth_serializer_impl.h>
 #include <coreobjects/core_event_args_factory.h>
 #include <coretypes/cloneable.h>
+#include <algorithm>
 
 namespace daq::config_protocol
 {
@@ -40,7 +42,66 @@ ComponentPtr ComponentFinderRootDevice::findComponentInternal(const ComponentPtr
 }
 
 ComponentPtr ComponentFinderRootDevice::findComponent(const std::string& globalId)
-{         
+{
+    {
+        std::scoped_lock lock(indexSync);
+        if (const auto it = index.find(globalId); it != index.end())
+        {
+            const auto component = it->second.getRef();
+            if (component.assigned() && !component.isRemoved())
+                return component;
+
+            index.erase(it);
+        }
+    }
+
+    auto component = findComponentInTree(globalId);
+    if (component.assigned())
+    {
+        std::scoped_lock lock(indexSync);
+        index[globalId] = component;
+    }
+
+    return component;
+}
+
+void ComponentFinderRootDevice::onCoreEvent(const ComponentPtr& component, const CoreEventArgsPtr& eventArgs)
+{
+    if (!component.assigned())
+        return;
+
+    switch (static_cast<CoreEventId>(eventArgs.getEventId()))
+    {
+        case CoreEventId::ComponentAdded:
+        {
+            const ComponentPtr addedComponent = eventArgs.getParameters().get("Component");
+            std::scoped_lock lock(indexSync);
+            index[addedComponent.getGlobalId().toStdString()] = addedComponent;
+            break;
+        }
+        case CoreEventId::ComponentRemoved:
+        {
+            // the sender is the parent folder, drop the removed component and everything below it
+            const auto removedId = component.getGlobalId().toStdString() + "/" + static_cast<std::string>(eventArgs.getParameters().get("Id"));
+            const auto removedPrefix = removedId + "/";
+
+            std::scoped_lock lock(indexSync);
+            for (auto it = index.begin(); it != index.end();)
+            {
+                if (it->first == removedId || it->first.compare(0, removedPrefix.size(), removedPrefix) == 0)
+                    it = index.erase(it);
+                else
+                    ++it;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+ComponentPtr ComponentFinderRootDevice::findComponentInTree(const std::string& globalId) const
+{
     if (globalId.find("/") != 0)
         throw InvalidParameterException("Global id must start with /");
 
@@ -67,10 +128,14 @@ ConfigProtocolServer::ConfigProtocolServer(DevicePtr rootDevice,
     : rootDevice(std::move(rootDevice))
     , daqContext(this->rootDevice.getContext())
     , notificationReadyCallback(std::move(notificationReadyCallback))
-    , deserializer(JsonDeserializer())
-    , serializer(JsonSerializer())
+    , protocolVersion(JsonRpcProtocolVersion)
+    , deserializer(createRpcDeserializer(protocolVersion))
+    , serializer(createRpcSerializer(protocolVersion))
     , notificationSerializer(JsonSerializer())
     , componentFinder(std::make_unique<ComponentFinderRootDevice>(this->rootDevice))
+    , notificationBatchesSupported(false)
+    , notificationWindow(0)
+    , notificationThreadStopped(true)
 {
     buildRpcDispatchStructure();
 
@@ -82,6 +147,8 @@ ConfigProtocolServer::~ConfigProtocolServer()
 {
     if (daqContext.assigned())
         daqContext.getOnCoreEvent() -= event(this, &ConfigProtocolServer::coreEventCallback);
+
+    stopNotificationThread();
 }
 
 template <class SmartPtr, class F>
@@ -125,6 +192,7 @@ void ConfigProtocolServer::buildRpcDispatchStructure()
     using namespace std::placeholders;
 
     rpcDispatch.insert({"GetComponent", std::bind(&ConfigProtocolServer::getComponent, this,  _1)});
+    rpcDispatch.insert({"GetComponentItems", std::bind(&ConfigProtocolServer::getComponentItems, this,  _1)});
     rpcDispatch.insert({"GetTypeManager", std::bind(&ConfigProtocolServer::getTypeManager, this, _1)});
 
     addHandler<ComponentPtr>("SetPropertyValue", &ConfigServerComponent::setPropertyValue);
@@ -201,6 +269,112 @@ DevicePtr ConfigProtocolServer::getRootDevice()
     return rootDevice;
 }
 
+void ConfigProtocolServer::setNotificationCoalescingWindow(std::chrono::milliseconds window)
+{
+    stopNotificationThread();
+    flushNotifications();
+
+    std::scoped_lock lock(pendingNotificationsSync);
+    notificationWindow = window;
+    if (notificationWindow.count() > 0)
+    {
+        notificationThreadStopped = false;
+        notificationThread = std::thread(&ConfigProtocolServer::notificationThreadFunc, this);
+    }
+}
+
+bool ConfigProtocolServer::queueNotification(const ListPtr<IBaseObject>& packedEvent, const CoreEventArgsPtr& eventArgs)
+{
+    std::string propertyKey;
+    if (eventArgs.getEventId() == static_cast<Int>(CoreEventId::PropertyValueChanged))
+    {
+        const auto params = eventArgs.getParameters();
+        const StringPtr path = params.get("Path");
+        propertyKey = static_cast<std::string>(packedEvent[0]) + "/" + (path.assigned() ? path.toStdString() : "") + "/" +
+                      static_cast<std::string>(params.get("Name"));
+    }
+
+    std::scoped_lock lock(pendingNotificationsSync);
+    if (notificationThreadStopped)
+        return false;
+
+    if (!propertyKey.empty())
+    {
+        // the earlier change is dropped rather than overwritten in place so the new value
+        // still arrives after any update-end event queued in between
+        const auto it = pendingPropertyChanges.find(propertyKey);
+        if (it != pendingPropertyChanges.end())
+        {
+            pendingNotifications[it->second] = ListPtr<IBaseObject>();
+            it->second = pendingNotifications.size();
+        }
+        else
+        {
+            pendingPropertyChanges.emplace(propertyKey, pendingNotifications.size());
+        }
+    }
+
+    pendingNotifications.push_back(packedEvent);
+    pendingNotificationsCv.notify_one();
+    return true;
+}
+
+void ConfigProtocolServer::flushNotifications()
+{
+    std::scoped_lock flushLock(notificationFlushSync);
+
+    std::vector<ListPtr<IBaseObject>> notifications;
+    {
+        std::scoped_lock lock(pendingNotificationsSync);
+        notifications.swap(pendingNotifications);
+        pendingPropertyChanges.clear();
+    }
+
+    auto batch = List<IBaseObject>();
+    for (const auto& notification : notifications)
+    {
+        if (notification.assigned())
+            batch.pushBack(notification);
+    }
+
+    if (batch.getCount() == 1)
+        sendNotification(batch[0]);
+    else if (batch.getCount() > 1)
+        sendNotification(batch);
+}
+
+void ConfigProtocolServer::notificationThreadFunc()
+{
+    std::unique_lock lock(pendingNotificationsSync);
+    while (!notificationThreadStopped)
+    {
+        pendingNotificationsCv.wait(lock, [this] { return notificationThreadStopped || !pendingNotifications.empty(); });
+        if (notificationThreadStopped)
+            break;
+
+        // collect the events raised within the window after the first one
+        pendingNotificationsCv.wait_for(lock, notificationWindow, [this] { return notificationThreadStopped; });
+        if (notificationThreadStopped)
+            break;
+
+        lock.unlock();
+        flushNotifications();
+        lock.lock();
+    }
+}
+
+void ConfigProtocolServer::stopNotificationThread()
+{
+    {
+        std::scoped_lock lock(pendingNotificationsSync);
+        notificationThreadStopped = true;
+    }
+    pendingNotificationsCv.notify_all();
+
+    if (notificationThread.joinable())
+        notificationThread.join();
+}
+
 PacketBuffer ConfigProtocolServer::processPacket(const PacketBuffer& packetBuffer)
 {
     const auto requestId = packetBuffer.getId();
@@ -209,14 +383,25 @@ PacketBuffer ConfigProtocolServer::processPacket(const PacketBuffer& packetBuffe
         case PacketType::getProtocolInfo:
             {
                 packetBuffer.parseProtocolInfoRequest();
-                auto reply = PacketBuffer::createGetProtocolInfoReply(requestId, 0, {0});
+                auto reply = PacketBuffer::createGetProtocolInfoReply(requestId, protocolVersion, getSupportedProtocolVersions());
                 return reply;
             }
         case PacketType::upgradeProtocol:
             {
                 uint16_t version;
                 packetBuffer.parseProtocolUpgradeRequest(version);
-                auto reply = PacketBuffer::createUpgradeProtocolReply(requestId, version == 0);
+
+                const auto supportedVersions = getSupportedProtocolVersions();
+                const bool success = std::find(supportedVersions.begin(), supportedVersions.end(), version) != supportedVersions.end();
+                if (success && version != protocolVersion)
+                {
+                    protocolVersion = version;
+                    deserializer = createRpcDeserializer(version);
+                    serializer = createRpcSerializer(version);
+                    notificationBatchesSupported = version >= NotificationBatchProtocolVersion;
+                }
+
+                auto reply = PacketBuffer::createUpgradeProtocolReply(requestId, success);
                 return reply;
             }
         case PacketType::rpc:
@@ -226,9 +411,22 @@ PacketBuffer ConfigProtocolServer::processPacket(const PacketBuffer& packetBuffe
                 const auto jsonRequest = packetBuffer.parseRpcRequestOrReply();
                 const auto jsonReply = processRpc(jsonRequest);
 
+                // events raised by the call reach the client before the reply
+                flushNotifications();
+
                 auto reply = PacketBuffer::createRpcRequestOrReply(requestId, jsonReply.getCharPtr(), jsonReply.getLength());
                 return reply;
             }
+        case PacketType::rpcBatch:
+            {
+                const auto jsonRequest = packetBuffer.parseRpcBatchRequestOrReply();
+                const auto jsonReply = processRpcBatch(jsonRequest);
+
+                flushNotifications();
+
+                auto reply = PacketBuffer::createRpcBatchRequestOrReply(requestId, jsonReply.getCharPtr(), jsonReply.getLength());
+                return reply;
+            }
         default:
             auto reply = PacketBuffer::createInvalidRequestReply(requestId);
             return reply;
@@ -238,11 +436,70 @@ PacketBuffer ConfigProtocolServer::processPacket(const PacketBuffer& packetBuffe
 
 StringPtr ConfigProtocolServer::processRpc(const StringPtr& jsonStr)
 {
-    auto retObj = Dict<IString, IBaseObject>();
+    DictPtr<IString, IBaseObject> retObj;
     try
     {
         const auto obj = deserializer.deserialize(jsonStr, nullptr);
-        const DictPtr<IString, IBaseObject> dictObj = obj.asPtr<IDict>(true);
+        retObj = processRpcRequest(obj);
+    }
+    catch (const daq::DaqException& e)
+    {
+        retObj = Dict<IString, IBaseObject>();
+        retObj.set("ErrorCode", e.getErrCode());
+        retObj.set("ErrorMessage", e.what());
+    }
+    catch (const std::exception& e)
+    {
+        retObj = Dict<IString, IBaseObject>();
+        retObj.set("ErrorCode", OPENDAQ_ERR_GENERALERROR);
+        retObj.set("ErrorMessage", e.what());
+    }
+
+    serializer.reset();
+    retObj.serialize(serializer);
+    return serializer.getOutput();
+}
+
+StringPtr ConfigProtocolServer::processRpcBatch(const StringPtr& jsonStr)
+{
+    // requests are executed in order; a failed request does not stop the ones after it
+    BaseObjectPtr retObj;
+    try
+    {
+        const ListPtr<IBaseObject> requests = deserializer.deserialize(jsonStr, nullptr).asPtr<IList>(true);
+
+        auto replies = List<IBaseObject>();
+        for (const auto& request : requests)
+            replies.pushBack(processRpcRequest(request));
+        retObj = replies;
+    }
+    catch (const daq::DaqException& e)
+    {
+        // a batch that cannot be parsed gets a single error reply in place of the reply list
+        auto errorObj = Dict<IString, IBaseObject>();
+        errorObj.set("ErrorCode", e.getErrCode());
+        errorObj.set("ErrorMessage", e.what());
+        retObj = errorObj;
+    }
+    catch (const std::exception& e)
+    {
+        auto errorObj = Dict<IString, IBaseObject>();
+        errorObj.set("ErrorCode", OPENDAQ_ERR_GENERALERROR);
+        errorObj.set("ErrorMessage", e.what());
+        retObj = errorObj;
+    }
+
+    serializer.reset();
+    retObj.serialize(serializer);
+    return serializer.getOutput();
+}
+
+DictPtr<IString, IBaseObject> ConfigProtocolServer::processRpcRequest(const BaseObjectPtr& request)
+{
+    auto retObj = Dict<IString, IBaseObject>();
+    try
+    {
+        const DictPtr<IString, IBaseObject> dictObj = request.asPtr<IDict>(true);
 
         const auto funcName = dictObj.get("Name");
         ParamsDictPtr funcParams;
@@ -266,9 +523,7 @@ StringPtr ConfigProtocolServer::processRpc(const StringPtr& jsonStr)
         retObj.set("ErrorMessage", e.what());
     }
 
-    serializer.reset();
-    retObj.serialize(serializer);
-    return serializer.getOutput();
+    return retObj;
 }
 
 BaseObjectPtr ConfigProtocolServer::callRpc(const StringPtr& name, const ParamsDictPtr& params)
@@ -298,12 +553,37 @@ BaseObjectPtr ConfigProtocolServer::getComponent(const ParamsDictPtr& params) co
     if (!component.assigned())
         throw NotFoundException("Component not found");
 
+    if (params.hasKey("ItemsDepth"))
+        return LimitedDepthSerializable(ComponentHolder(component), static_cast<Int>(params.get("ItemsDepth")));
+
     return ComponentHolder(component);
 }
 
+BaseObjectPtr ConfigProtocolServer::getComponentItems(const ParamsDictPtr& params) const
+{
+    const auto componentGlobalId = static_cast<std::string>(params["ComponentGlobalId"]);
+    const FolderPtr folder = findComponent(componentGlobalId);
+
+    if (!folder.assigned())
+        throw NotFoundException("Component not found");
+
+    auto holders = List<IComponentHolder>();
+    for (const auto& item : folder.getItems(search::Any()))
+        holders.pushBack(ComponentHolder(item));
+
+    const Int itemsDepth = params.hasKey("ItemsDepth") ? static_cast<Int>(params.get("ItemsDepth")) : 0;
+    return LimitedDepthSerializable(holders, itemsDepth);
+}
+
 void ConfigProtocolServer::coreEventCallback(ComponentPtr& component, CoreEventArgsPtr& eventArgs)
 {
+    componentFinder->onCoreEvent(component, eventArgs);
+
     const auto packed = packCoreEvent(component, eventArgs);
+
+    if (notificationBatchesSupported && queueNotification(packed, eventArgs))
+        return;
+
     sendNotification(packed);
 }
 
@@ -0,0 +1,272 @@
+#include <config_protocol/limited_depth_serializer_impl.h>
+#include <opendaq/folder.h>
+#include <cstring>
+
+namespace daq::config_protocol
+{
+
+static constexpr char ItemsKey[] = "items";
+static constexpr char LazyItemsKey[] = "lazyItems";
+
+LimitedDepthSerializerImpl::LimitedDepthSerializerImpl(SerializerPtr serializer, SizeT maxItemsDepth)
+    : serializer(std::move(serializer))
+    , maxItemsDepth(maxItemsDepth)
+    , itemsDepth(0)
+    , itemsKeyWritten(false)
+    , skipValue(false)
+    , skippedLevels(0)
+{
+}
+
+ErrCode LimitedDepthSerializerImpl::startTaggedObject(ISerializable* serializable)
+{
+    OPENDAQ_PARAM_NOT_NULL(serializable);
+
+    const auto scope = BaseObjectPtr::Borrow(serializable).supportsInterface<IFolder>() ? Scope::Folder : Scope::Other;
+
+    bool forward;
+    const ErrCode errCode = start(scope, forward);
+    if (OPENDAQ_FAILED(errCode) || !forward)
+        return errCode;
+
+    return serializer->startTaggedObject(serializable);
+}
+
+ErrCode LimitedDepthSerializerImpl::startObject()
+{
+    bool forward;
+    const ErrCode errCode = start(Scope::Other, forward);
+    if (OPENDAQ_FAILED(errCode) || !forward)
+        return errCode;
+
+    return serializer->startObject();
+}
+
+ErrCode LimitedDepthSerializerImpl::endObject()
+{
+    if (end())
+        return serializer->endObject();
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode LimitedDepthSerializerImpl::startList()
+{
+    bool forward;
+    const ErrCode errCode = start(Scope::Other, forward);
+    if (OPENDAQ_FAILED(errCode) || !forward)
+        return errCode;
+
+    return serializer->startList();
+}
+
+ErrCode LimitedDepthSerializerImpl::endList()
+{
+    if (end())
+        return serializer->endList();
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode LimitedDepthSerializerImpl::getOutput(IString** output)
+{
+    return serializer->getOutput(output);
+}
+
+ErrCode LimitedDepthSerializerImpl::key(ConstCharPtr string)
+{
+    OPENDAQ_PARAM_NOT_NULL(string);
+
+    bool forward;
+    const ErrCode errCode = handleKey(string, std::strlen(string), forward);
+    if (OPENDAQ_FAILED(errCode) || !forward)
+        return errCode;
+
+    return serializer->key(string);
+}
+
+ErrCode LimitedDepthSerializerImpl::keyStr(IString* name)
+{
+    OPENDAQ_PARAM_NOT_NULL(name);
+
+    ConstCharPtr string;
+    ErrCode errCode = name->getCharPtr(&string);
+    if (OPENDAQ_FAILED(errCode))
+        return errCode;
+
+    SizeT length;
+    errCode = name->getLength(&length);
+    if (OPENDAQ_FAILED(errCode))
+        return errCode;
+
+    bool forward;
+    errCode = handleKey(string, length, forward);
+    if (OPENDAQ_FAILED(errCode) || !forward)
+        return errCode;
+
+    return serializer->keyStr(name);
+}
+
+ErrCode LimitedDepthSerializerImpl::keyRaw(ConstCharPtr string, SizeT length)
+{
+    OPENDAQ_PARAM_NOT_NULL(string);
+
+    bool forward;
+    const ErrCode errCode = handleKey(string, length, forward);
+    if (OPENDAQ_FAILED(errCode) || !forward)
+        return errCode;
+
+    return serializer->keyRaw(string, length);
+}
+
+ErrCode LimitedDepthSerializerImpl::writeInt(Int integer)
+{
+    if (!writeValue())
+        return OPENDAQ_SUCCESS;
+    return serializer->writeInt(integer);
+}
+
+ErrCode LimitedDepthSerializerImpl::writeBool(Bool boolean)
+{
+    if (!writeValue())
+        return OPENDAQ_SUCCESS;
+    return serializer->writeBool(boolean);
+}
+
+ErrCode LimitedDepthSerializerImpl::writeFloat(Float real)
+{
+    if (!writeValue())
+        return OPENDAQ_SUCCESS;
+    return serializer->writeFloat(real);
+}
+
+ErrCode LimitedDepthSerializerImpl::writeString(ConstCharPtr string, SizeT length)
+{
+    if (!writeValue())
+        return OPENDAQ_SUCCESS;
+    return serializer->writeString(string, length);
+}
+
+ErrCode LimitedDepthSerializerImpl::writeNull()
+{
+    if (!writeValue())
+        return OPENDAQ_SUCCESS;
+    return serializer->writeNull();
+}
+
+ErrCode LimitedDepthSerializerImpl::reset()
+{
+    itemsDepth = 0;
+    itemsKeyWritten = false;
+    skipValue = false;
+    skippedLevels = 0;
+    scopes.clear();
+
+    return serializer->reset();
+}
+
+ErrCode LimitedDepthSerializerImpl::isComplete(Bool* complete)
+{
+    return serializer->isComplete(complete);
+}
+
+ErrCode LimitedDepthSerializerImpl::handleKey(const char* string, SizeT length, bool& forward)
+{
+    forward = false;
+    if (skippedLevels > 0)
+        return OPENDAQ_SUCCESS;
+
+    const bool isItemsKey = length == sizeof(ItemsKey) - 1 && std::strncmp(string, ItemsKey, length) == 0;
+    itemsKeyWritten = isItemsKey && !scopes.empty() && scopes.back() == Scope::Folder;
+
+    if (itemsKeyWritten && itemsDepth >= maxItemsDepth)
+    {
+        itemsKeyWritten = false;
+        skipValue = true;
+
+        ErrCode errCode = serializer->key(LazyItemsKey);
+        if (OPENDAQ_FAILED(errCode))
+            return errCode;
+
+        return serializer->writeBool(True);
+    }
+
+    forward = true;
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode LimitedDepthSerializerImpl::start(Scope scope, bool& forward)
+{
+    forward = false;
+    if (skipValue || skippedLevels > 0)
+    {
+        skipValue = false;
+        skippedLevels++;
+        return OPENDAQ_SUCCESS;
+    }
+
+    if (itemsKeyWritten)
+    {
+        itemsKeyWritten = false;
+        scope = Scope::Items;
+        itemsDepth++;
+    }
+
+    scopes.push_back(scope);
+    forward = true;
+    return OPENDAQ_SUCCESS;
+}
+
+bool LimitedDepthSerializerImpl::end()
+{
+    if (skippedLevels > 0)
+    {
+        skippedLevels--;
+        return false;
+    }
+
+    if (!scopes.empty())
+    {
+        if (scopes.back() == Scope::Items)
+            itemsDepth--;
+        scopes.pop_back();
+    }
+
+    return true;
+}
+
+bool LimitedDepthSerializerImpl::writeValue()
+{
+    itemsKeyWritten = false;
+    if (skipValue)
+    {
+        skipValue = false;
+        return false;
+    }
+
+    return skippedLevels == 0;
+}
+
+LimitedDepthSerializableImpl::LimitedDepthSerializableImpl(BaseObjectPtr object, SizeT maxItemsDepth)
+    : object(std::move(object))
+    , maxItemsDepth(maxItemsDepth)
+{
+}
+
+ErrCode LimitedDepthSerializableImpl::serialize(ISerializer* serializer)
+{
+    OPENDAQ_PARAM_NOT_NULL(serializer);
+
+    return daqTry([this, &serializer]
+    {
+        const auto limitedSerializer =
+            createWithImplementation<ISerializer, LimitedDepthSerializerImpl>(SerializerPtr(serializer), maxItemsDepth);
+        object.asPtr<ISerializable>(true).serialize(limitedSerializer);
+        return OPENDAQ_SUCCESS;
+    });
+}
+
+ErrCode LimitedDepthSerializableImpl::getSerializeId(ConstCharPtr* id) const
+{
+    return object.asPtr<ISerializable>(true)->getSerializeId(id);
+}
+
+}
@@ -158,6 +158,20 @@ TEST_F(ConfigPacketTest, RpcRequest)
     ASSERT_EQ(json1, json);
 }
 
+TEST_F(ConfigPacketTest, RpcBatchRequest)
+{
+    const std::string json{"str"};
+    const auto packetBufferSource = PacketBuffer::createRpcBatchRequestOrReply(2, json.c_str(), json.length());
+
+    const PacketBuffer packetBuffer(packetBufferSource.getBuffer(), false);
+
+    ASSERT_EQ(packetBuffer.getId(), 2u);
+    const auto json1 = packetBuffer.parseRpcBatchRequestOrReply();
+
+    ASSERT_EQ(json1, json);
+    ASSERT_THROW(packetBuffer.parseRpcRequestOrReply(), ConfigProtocolException);
+}
+
 TEST_F(ConfigPacketTest, ServerNotification)
 {
     const std::string json{"str"};
@@ -11,6 +11,7 @@
 #include "coreobjects/callable_info_factory.h"
 #include "opendaq/context_factory.h"
 #include <config_protocol/config_client_device_impl.h>
+#include <config_protocol/config_client_folder_impl.h>
 
 using namespace daq;
 using namespace config_protocol;
@@ -69,6 +70,12 @@ TEST_F(ConfigProtocolIntegrationTest, Connect)
     ASSERT_EQ(serverDeviceSerialized, clientDeviceSerialized);
 }
 
+TEST_F(ConfigProtocolIntegrationTest, LatestProtocolNegotiated)
+{
+    ASSERT_EQ(client->getClientComm()->getProtocolVersion(), getSupportedProtocolVersions().back());
+    ASSERT_EQ(clientDevice.getName(), serverDevice.getName());
+}
+
 TEST_F(ConfigProtocolIntegrationTest, InputPortConnected)
 {
     ASSERT_EQ(serverDevice.getDevices()[0].getFunctionBlocks()[0].getInputPorts()[0].getSignal(),
@@ -173,6 +180,63 @@ TEST_F(ConfigProtocolIntegrationTest, SetPropertyValue)
     ASSERT_EQ(serverDevice.getChannels()[0].getPropertyValue("StrProp"), clientDevice.getChannels()[0].getPropertyValue("StrProp"));
 }
 
+TEST_F(ConfigProtocolIntegrationTest, SetPropertyValueAsync)
+{
+    const auto channelId = serverDevice.getChannels()[0].getGlobalId().toStdString();
+    const auto clientComm = client->getClientComm();
+
+    auto setFuture = clientComm->setPropertyValueAsync(channelId, "StrProp", "SomeValue");
+    auto getFuture = clientComm->getPropertyValueAsync(channelId, "StrProp");
+
+    setFuture.get();
+    ASSERT_EQ(getFuture.get(), "SomeValue");
+    ASSERT_EQ(serverDevice.getChannels()[0].getPropertyValue("StrProp"), "SomeValue");
+}
+
+TEST_F(ConfigProtocolIntegrationTest, SetPropertyValuesBatch)
+{
+    const auto channelId = serverDevice.getChannels()[0].getGlobalId().toStdString();
+    const auto clientComm = client->getClientComm();
+
+    std::vector<RpcCommand> commands;
+    commands.push_back(ConfigProtocolClientComm::createSetPropertyValueCommand(channelId, "StrProp", "SomeValue"));
+    commands.push_back({"GetPropertyValue", ParamsDict({{"ComponentGlobalId", String(channelId)}, {"PropertyName", String("StrProp")}})});
+
+    const auto results = clientComm->sendCommandBatchAsync(commands).get();
+    ASSERT_EQ(results.size(), 2u);
+    ASSERT_EQ(results[1], "SomeValue");
+    ASSERT_EQ(serverDevice.getChannels()[0].getPropertyValue("StrProp"), "SomeValue");
+}
+
+TEST_F(ConfigProtocolIntegrationTest, BatchExecutesAllCommands)
+{
+    const auto channelId = serverDevice.getChannels()[0].getGlobalId().toStdString();
+    const auto clientComm = client->getClientComm();
+
+    std::vector<RpcCommand> commands;
+    commands.push_back(ConfigProtocolClientComm::createSetPropertyValueCommand(channelId, "StrPropProtected", "SomeValue"));
+    commands.push_back(ConfigProtocolClientComm::createSetPropertyValueCommand(channelId, "StrProp", "SomeValue"));
+
+    auto future = clientComm->sendCommandBatchAsync(commands);
+    ASSERT_THROW(future.get(), AccessDeniedException);
+    ASSERT_EQ(serverDevice.getChannels()[0].getPropertyValue("StrProp"), "SomeValue");
+}
+
+TEST_F(ConfigProtocolIntegrationTest, MalformedBatchGetsErrorReply)
+{
+    // a valid json value that is not a list of requests
+    const std::string json = "5";
+    const auto request = PacketBuffer::createRpcBatchRequestOrReply(100, json.c_str(), json.length());
+
+    const auto reply = server->processRequestAndGetReply(request);
+    ASSERT_EQ(reply.getPacketType(), PacketType::rpcBatch);
+    ASSERT_EQ(reply.getId(), 100u);
+
+    const DictPtr<IString, IBaseObject> replyObj = JsonDeserializer().deserialize(reply.parseRpcBatchRequestOrReply());
+    const ErrCode errCode = replyObj.get("ErrorCode");
+    ASSERT_TRUE(OPENDAQ_FAILED(errCode));
+}
+
 TEST_F(ConfigProtocolIntegrationTest, SetProtectedPropertyValue)
 {
     ASSERT_THROW(clientDevice.getChannels()[0].setPropertyValue("StrPropProtected", "SomeValue"), AccessDeniedException);
@@ -330,6 +394,41 @@ TEST_F(ConfigProtocolIntegrationTest, RemoveFunctionBlock)
     ASSERT_EQ(clientSubDevice.getFunctionBlocks().getCount(), 0);
 }
 
+TEST_F(ConfigProtocolIntegrationTest, ComponentFinderIndex)
+{
+    ComponentFinderRootDevice finder(serverDevice);
+
+    const auto serverSubDevice = serverDevice.getDevices()[0];
+    const auto functionBlock = serverSubDevice.getFunctionBlocks()[0];
+    const auto functionBlockId = functionBlock.getGlobalId().toStdString();
+
+    ASSERT_EQ(finder.findComponent(functionBlockId), functionBlock);
+    ASSERT_EQ(finder.findComponent(functionBlockId), functionBlock);
+    ASSERT_FALSE(finder.findComponent(functionBlockId + "_").assigned());
+
+    // index entries of removed components are not returned even without a core event
+    serverDevice.asPtr<IPropertyObjectInternal>().disableCoreEventTrigger();
+    serverSubDevice.removeFunctionBlock(functionBlock);
+    ASSERT_FALSE(finder.findComponent(functionBlockId).assigned());
+}
+
+TEST_F(ConfigProtocolIntegrationTest, LazyLoading)
+{
+    const auto lazyClient = std::make_unique<ConfigProtocolClient<ConfigClientDeviceImpl>>(
+        NullContext(), std::bind(&ConfigProtocolIntegrationTest::sendRequest, this, std::placeholders::_1), nullptr);
+    lazyClient->getClientComm()->setLazyLoading(true);
+    const auto lazyDevice = lazyClient->connect();
+
+    const FolderPtr devicesFolder = lazyDevice.asPtr<IFolder>().getItem("Dev");
+    ASSERT_FALSE(devicesFolder.asPtr<IConfigClientFolderPrivate>(true)->getItemsLoaded());
+
+    ASSERT_EQ(lazyDevice.getDevices()[0].getFunctionBlocks()[0].getInputPorts()[0].getSignal(),
+              lazyDevice.getDevices()[0].getSignals()[0]);
+    ASSERT_TRUE(devicesFolder.asPtr<IConfigClientFolderPrivate>(true)->getItemsLoaded());
+
+    ASSERT_EQ(serializeComponent(lazyDevice), serializeComponent(serverDevice));
+}
+
 TEST_F(ConfigProtocolIntegrationTest, RemoveFunctionBlockWithEvent)
 {
     const auto serverSubDevice = serverDevice.getDevices()[0];
@@ -14,6 +14,7 @@
 #include <opendaq/component_status_container_private_ptr.h>
 #include <opendaq/component_status_container_ptr.h>
 #include <coreobjects/property_object_factory.h>
+#include <coreobjects/property_object_protected_ptr.h>
 #include "test_utils.h"
 #include "config_protocol/config_protocol_server.h"
 #include "config_protocol/config_protocol_client.h"
@@ -89,6 +90,34 @@ TEST_F(ConfigCoreEventTest, PropertyValueChanged)
     ASSERT_EQ(callCount, 3);
 }
 
+TEST_F(ConfigCoreEventTest, CoalescedPropertyValueChanged)
+{
+    // long window, the pending notifications are flushed by the next request
+    server->setNotificationCoalescingWindow(std::chrono::seconds(10));
+
+    const auto clientComponent = client->getDevice().findComponent("IO/ai/ch");
+    const auto serverComponent = serverDevice.findComponent("IO/ai/ch");
+
+    int callCount = 0;
+    clientContext.getOnCoreEvent() +=
+        [&](const ComponentPtr& comp, const CoreEventArgsPtr& args)
+        {
+            ASSERT_EQ(args.getEventId(), static_cast<Int>(CoreEventId::PropertyValueChanged));
+            ASSERT_EQ(comp, clientComponent);
+            callCount++;
+        };
+
+    serverComponent.setPropertyValue("StrProp", "foo");
+    serverComponent.asPtr<IPropertyObjectProtected>(true).setProtectedPropertyValue("StrPropProtected", "foo");
+    serverComponent.setPropertyValue("StrProp", "bar");
+    ASSERT_EQ(callCount, 0);
+
+    client->getClientComm()->sendCommand("GetTypeManager");
+    ASSERT_EQ(callCount, 2);
+    ASSERT_EQ(clientComponent.getPropertyValue("StrProp"), "bar");
+    ASSERT_EQ(clientComponent.getPropertyValue("StrPropProtected"), "foo");
+}
+
 TEST_F(ConfigCoreEventTest, PropertyChangedNested)
 {
     const auto clientComponent = client->getDevice().findComponent("AdvancedPropertiesComponent");
@@ -17,10 +17,12 @@
 #pragma once
 
 #include <native_streaming_protocol/base_session_handler.h>
+#include <native_streaming_protocol/shared_memory_ring.h>
 
 #include <opendaq/data_descriptor_ptr.h>
 
 #include <packet_streaming/packet_streaming_client.h>
+#include <packet_streaming/packet_buffer_arena.h>
 
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
 
@@ -34,7 +36,8 @@ public:
                          OnPacketReceivedCallback packetReceivedHandler,
                          OnProtocolInitDoneCallback protocolInitDoneHandler,
                          OnSubscriptionAckCallback subscriptionAckHandler,
-                         native_streaming::OnSessionErrorCallback errorHandler);
+                         native_streaming::OnSessionErrorCallback errorHandler,
+                         AllocatorPtr packetAllocator = nullptr);
 
     ~ClientSessionHandler();
 
@@ -43,17 +46,24 @@ public:
     void sendTransportLayerProperties(const PropertyObjectPtr& properties);
 
     EventPacketPtr getDataDescriptorChangedEventPacket(const SignalNumericIdType& signalNumericId);
+    packet_streaming::EventPacketStatistics getEventPacketStatistics() const;
+    packet_streaming::ReferenceStatistics getReferenceStatistics() const;
 
 private:
     daq::native_streaming::ReadTask readHeader(const void* data, size_t size) override;
 
     daq::native_streaming::ReadTask readPacket(const void* data, size_t size);
+    daq::native_streaming::ReadTask readSharedMemoryPacket(const void* data, size_t size);
+    daq::native_streaming::ReadTask readSharedMemoryTransportOffer(const void* data, size_t size);
     daq::native_streaming::ReadTask readSignalAvailable(const void* data, size_t size);
     daq::native_streaming::ReadTask readSignalUnavailable(const void* data, size_t size);
     daq::native_streaming::ReadTask readSignalSubscribedAck(const void* data, size_t size);
     daq::native_streaming::ReadTask readSignalUnsubscribedAck(const void* data, size_t size);
 
+    // returns nullptr for unsupported headers, the packet is then skipped
+    packet_streaming::PacketBufferPtr readPacketBufferHeader(const void* data, size_t size, size_t& bytesDone);
     void processReceivedPackets();
+    void sendSharedMemoryTransportReply(bool accepted);
 
     OnSignalCallback signalReceivedHandler;
     OnPacketReceivedCallback packetReceivedHandler;
@@ -61,5 +71,7 @@ private:
     OnSubscriptionAckCallback subscriptionAckHandler;
 
     packet_streaming::PacketStreamingClient packetStreamingClient;
+    packet_streaming::PacketBufferArenaPtr packetBufferArena;
+    SharedMemoryRingPtr sharedMemoryRing;
 };
 END_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
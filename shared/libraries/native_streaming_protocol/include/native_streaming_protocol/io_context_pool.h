@@ -0,0 +1,58 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <native_streaming_protocol/native_streaming_protocol.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
+
+/*
+ * Fixed set of io_contexts, each run by its own thread. Work posted to the same index
+ * is executed in order, work posted to different indices runs in parallel.
+ */
+class IoContextPool
+{
+public:
+    explicit IoContextPool(size_t size);
+    ~IoContextPool();
+
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+
+    size_t size() const;
+    boost::asio::io_context& getIoContext(size_t index);
+    void post(size_t index, std::function<void()> work);
+
+    void stop();
+
+private:
+    using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+
+    std::vector<std::unique_ptr<boost::asio::io_context>> ioContexts;
+    std::vector<WorkGuard> workGuards;
+    std::vector<std::thread> threads;
+};
+
+END_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
@@ -62,10 +62,15 @@ public:
     void subscribeSignal(const StringPtr& signalStringId);
     void unsubscribeSignal(const StringPtr& signalStringId);
     EventPacketPtr getDataDescriptorChangedEventPacket(const StringPtr& signalStringId);
+    /// Encodings of the event packets received within the current connection.
+    packet_streaming::EventPacketStatistics getEventPacketStatistics();
+    /// Packets referenced by the client within the current connection and how often their bound was hit.
+    packet_streaming::ReferenceStatistics getReferenceStatistics();
 
     void sendConfigRequest(const config_protocol::PacketBuffer& packet);
 
     void setIoContext(const std::shared_ptr<boost::asio::io_context>& ioContextPtr);
+    void setPacketAllocator(const AllocatorPtr& packetAllocator);
     void setSignalAvailableHandler(const OnSignalAvailableCallback& signalAvailableHandler);
     void setSignalUnavailableHandler(const OnSignalUnavailableCallback& signalUnavailableHandler);
     void setPacketHandler(const OnPacketCallback& packetHandler);
@@ -101,6 +106,7 @@ protected:
     ContextPtr context;
     PropertyObjectPtr transportLayerProperties;
     std::shared_ptr<boost::asio::io_context> ioContextPtr;
+    AllocatorPtr packetAllocator;
     LoggerPtr logger;
     LoggerComponentPtr loggerComponent;
     OnSignalAvailableCallback signalAvailableHandler;
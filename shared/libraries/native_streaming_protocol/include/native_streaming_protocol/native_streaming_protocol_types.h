@@ -68,7 +68,9 @@ enum class PayloadType
     PAYLOAD_TYPE_STREAMING_SIGNAL_SUBSCRIBE_ACK = 7,
     PAYLOAD_TYPE_STREAMING_SIGNAL_UNSUBSCRIBE_ACK = 8,
     PAYLOAD_TYPE_CONFIGURATION_PACKET = 9,
-    PAYLOAD_TYPE_TRANSPORT_LAYER_PROPERTIES = 10
+    PAYLOAD_TYPE_TRANSPORT_LAYER_PROPERTIES = 10,
+    PAYLOAD_TYPE_STREAMING_PACKET_SHARED_MEMORY = 11,
+    PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT = 12
 };
 
 constexpr std::initializer_list<PayloadType> allPayloadTypes =
@@ -82,7 +84,9 @@ constexpr std::initializer_list<PayloadType> allPayloadTypes =
         PayloadType::PAYLOAD_TYPE_STREAMING_SIGNAL_SUBSCRIBE_ACK,
         PayloadType::PAYLOAD_TYPE_STREAMING_SIGNAL_UNSUBSCRIBE_ACK,
         PayloadType::PAYLOAD_TYPE_CONFIGURATION_PACKET,
-        PayloadType::PAYLOAD_TYPE_TRANSPORT_LAYER_PROPERTIES
+        PayloadType::PAYLOAD_TYPE_TRANSPORT_LAYER_PROPERTIES,
+        PayloadType::PAYLOAD_TYPE_STREAMING_PACKET_SHARED_MEMORY,
+        PayloadType::PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT
     };
 
 inline std::string convertPayloadTypeToString(PayloadType type)
@@ -109,6 +113,10 @@ inline std::string convertPayloadTypeToString(PayloadType type)
             return "PAYLOAD_TYPE_CONFIGURATION_PACKET";
         case PayloadType::PAYLOAD_TYPE_TRANSPORT_LAYER_PROPERTIES:
             return "PAYLOAD_TYPE_TRANSPORT_LAYER_PROPERTIES";
+        case PayloadType::PAYLOAD_TYPE_STREAMING_PACKET_SHARED_MEMORY:
+            return "PAYLOAD_TYPE_STREAMING_PACKET_SHARED_MEMORY";
+        case PayloadType::PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT:
+            return "PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT";
     }
 
     return "PAYLOAD_TYPE_INVALID";
@@ -18,6 +18,7 @@
 
 #include <native_streaming_protocol/server_session_handler.h>
 #include <native_streaming_protocol/subscribers_registry.h>
+#include <native_streaming_protocol/io_context_pool.h>
 
 #include <opendaq/context_ptr.h>
 #include <opendaq/logger_ptr.h>
@@ -51,12 +52,43 @@ public:
     void removeComponentSignals(const StringPtr& componentId);
 
     void sendPacket(const SignalPtr& signal, const PacketPtr& packet);
+    void sendPacket(const SignalHandlePtr& signalHandle, const PacketPtr& packet);
+    void sendPackets(const SignalHandlePtr& signalHandle, const ListPtr<IPacket>& packets);
+
+    /// Packets sent within one call are written to the socket with a single vectored write;
+    /// a non-zero flush delay additionally collects packets across calls until the delay expires
+    /// or the batch exceeds the max size. Applies to sessions connected afterwards.
+    void setWriteBatchingParams(size_t maxBatchSize, std::chrono::microseconds flushDelay);
+
+    /// Each session is assigned to one of a pool of send threads when accepted, the packets are encoded
+    /// and queued for the session on its thread without blocking the caller of sendPackets. With 0 threads,
+    /// packets are encoded for all sessions on the thread calling sendPackets. Must be set before the
+    /// server is started.
+    void setSendThreadCount(size_t threadCount);
+
+    /// Encodes and queues the packets of all sessions on the thread running the io_context that serves
+    /// the sockets, instead of the send threads or the caller of sendPackets. Must be set before the
+    /// server is started.
+    void setEncodeOnSocketThread(bool encodeOnSocketThread);
+
+    /// Bounds the packets queued for each session, the policy decides how slow clients are handled.
+    /// Applies to sessions connected afterwards.
+    void setSendQueueLimits(const SendQueueLimits& limits);
+
+    /// Sum of the send queue counters of all connected sessions.
+    SendQueueStatistics getSendQueueStatistics();
+
+    /// Number of connected sessions assigned to each of the send threads.
+    std::vector<size_t> getSendThreadSessionCounts();
+
+    SignalHandlePtr getSignalHandle(const SignalPtr& signal);
 
 protected:
     void initSessionHandler(SessionPtr session);
     void handleTransportLayerProps(const PropertyObjectPtr& propertyObject, std::shared_ptr<ServerSessionHandler> sessionHandler);
     void setUpTransportLayerPropsCallback(std::shared_ptr<ServerSessionHandler> sessionHandler);
     void setUpConfigProtocolCallbacks(std::shared_ptr<ServerSessionHandler> sessionHandler);
+    void sendInitialSignals(const std::shared_ptr<ServerSessionHandler>& sessionHandler);
     void releaseSessionHandler(SessionPtr session);
 
     void removeSignalInternal(const SignalPtr& signal);
@@ -71,6 +103,10 @@ protected:
     SignalNumericIdType findSignalNumericId(const SignalPtr& signal);
 
     static EventPacketPtr createDataDescriptorChangedEventPacket(const SignalPtr& signal);
+    void queuePacketsForSubscribers(SignalNumericIdType signalNumericId,
+                                    const ListPtr<IPacket>& packets,
+                                    std::vector<std::shared_ptr<ServerSessionHandler>>& subscribers);
+    void postToSendThread(const std::shared_ptr<ServerSessionHandler>& sessionHandler, std::function<void()> work);
 
     ContextPtr context;
     std::shared_ptr<boost::asio::io_context> ioContextPtr;
@@ -87,6 +123,14 @@ protected:
     OnSignalUnsubscribedCallback signalUnsubscribedHandler;
     SetUpConfigProtocolServerCb setUpConfigProtocolServerCb;
 
+    size_t maxWriteBatchSize;
+    std::chrono::microseconds writeBatchFlushDelay;
+    size_t sendThreadCount;
+    bool encodeOnSocketThread;
+    SendQueueLimits sendQueueLimits;
+    std::unique_ptr<IoContextPool> sendThreadPool;
+    std::vector<size_t> sendThreadSessionCounts;
+
     std::mutex sync;
 };
 
@@ -17,15 +17,43 @@
 #pragma once
 
 #include <native_streaming_protocol/base_session_handler.h>
+#include <native_streaming_protocol/shared_memory_ring.h>
 
 #include <opendaq/context_ptr.h>
 #include <opendaq/signal_ptr.h>
 
 #include <packet_streaming/packet_streaming_server.h>
 
+#include <deque>
+#include <unordered_map>
+
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
 
-class ServerSessionHandler : public BaseSessionHandler
+enum class SlowConsumerPolicy
+{
+    DropData,   // data packets are dropped while the send queue is over the limit, event packets are always sent
+    Downsample, // every n-th data packet of a signal is sent while the send queue is over the limit
+    Disconnect  // the session is closed once the send queue exceeds the limit
+};
+
+// Limits of the streaming packets written to the socket but not yet completed, 0 disables a limit.
+// Once exceeded, the policy applies until the queue drains to half of the limits.
+struct SendQueueLimits
+{
+    size_t maxBytes{0};
+    size_t maxPackets{0};
+    SlowConsumerPolicy policy{SlowConsumerPolicy::DropData};
+    size_t downsampleFactor{10};
+};
+
+struct SendQueueStatistics
+{
+    size_t queuedBytes;
+    size_t queuedPackets;
+    uint64_t droppedPackets;
+};
+
+class ServerSessionHandler : public BaseSessionHandler, public std::enable_shared_from_this<ServerSessionHandler>
 {
 public:
     ServerSessionHandler(const ContextPtr& daqContext,
@@ -36,27 +64,98 @@ public:
 
     ~ServerSessionHandler();
 
+    /// Cancels the pending batched writes and closes the session.
+    void close();
+
+    /// Periodically sends the release notifications of packets held by the client for the max release delay.
+    void startReleaseTimer();
+
     void sendSignalAvailable(const SignalNumericIdType& signalNumericId, const SignalPtr &signal);
     void sendSignalUnavailable(const SignalNumericIdType& signalNumericId, const SignalPtr& signal);
     void sendInitializationDone();
     void sendPacket(const SignalNumericIdType signalId, const PacketPtr& packet);
+    void queuePacket(const SignalNumericIdType signalId, const PacketPtr& packet);
+    void queuePacket(const SignalNumericIdType signalId,
+                     const PacketPtr& packet,
+                     packet_streaming::SharedPacketEncoding& sharedEncoding);
+    void completeSendCycle();
+    void setEventPacketVersion(uint8_t version);
+    void setPayloadCompression(bool enabled);
+    void offerSharedMemoryTransport(size_t ringCapacity);
     void sendSubscribingDone(const SignalNumericIdType signalNumericId);
     void sendUnsubscribingDone(const SignalNumericIdType signalNumericId);
 
     void setTransportLayerPropsHandler(const OnTrasportLayerPropertiesCallback& transportLayerPropsHandler);
+    void setWriteBatchingParams(size_t maxBatchSize, std::chrono::microseconds flushDelay);
+    void setSendQueueLimits(const SendQueueLimits& limits);
+    SendQueueStatistics getSendQueueStatistics() const;
+    void setSendThreadIndex(size_t index);
+    size_t getSendThreadIndex() const;
+    /// Marks the signals available on connection as sent, returns false if they already were.
+    bool markInitialSignalsSent();
+    bool getInitialSignalsSent() const;
 
 private:
+    struct SendQueueCounters
+    {
+        std::atomic<size_t> queuedBytes{0};
+        std::atomic<size_t> queuedPackets{0};
+        std::atomic<uint64_t> droppedPackets{0};
+    };
+
     daq::native_streaming::ReadTask readHeader(const void* data, size_t size) override;
 
     daq::native_streaming::ReadTask readSignalSubscribe(const void* data, size_t size);
     daq::native_streaming::ReadTask readSignalUnsubscribe(const void* data, size_t size);
     daq::native_streaming::ReadTask readTransportLayerProperties(const void* data, size_t size);
+    daq::native_streaming::ReadTask readSharedMemoryTransportReply(const void* data, size_t size);
 
     void sendPacketBuffer(const packet_streaming::PacketBufferPtr& packetBuffer);
+    bool admitPacket(SignalNumericIdType signalId, const PacketPtr& packet);
+    bool admitDataPacket(SignalNumericIdType signalId, Int packetId);
+    bool decideAdmission(SignalNumericIdType signalId);
+    bool updateSendQueueOverLimit();
+    void scheduleWrite(const std::vector<daq::native_streaming::WriteTask>& tasks);
+    void flushPendingWrites();
+    void flushPendingWritesInternal();
+    void checkReleasedPackets();
 
     OnSignalSubscriptionCallback signalSubscriptionHandler;
     OnTrasportLayerPropertiesCallback transportLayerPropsHandler;
 
+    // guards the packet streaming server and the slow consumer state, packets of several signals are queued concurrently
+    std::mutex sendSync;
     packet_streaming::PacketStreamingServer packetStreamingServer;
+
+    // write tasks of streaming packets collected within a send cycle, written with a single vectored write
+    std::vector<daq::native_streaming::WriteTask> pendingWriteTasks;
+    size_t pendingWriteSize;
+    size_t maxBatchSize;
+    std::chrono::microseconds flushDelay;
+    std::shared_ptr<boost::asio::steady_timer> flushTimer;
+    bool flushTimerArmed;
+    std::mutex pendingWritesSync;
+    std::shared_ptr<boost::asio::steady_timer> releaseTimer;
+
+    // packets referenced by write tasks still held by the session, a slow client makes the queue grow
+    std::shared_ptr<SendQueueCounters> sendQueueCounters;
+    SendQueueLimits sendQueueLimits;
+    bool sendQueueOverLimit;
+    bool disconnectRequested;
+    uint64_t droppedPacketsAtLimit;
+    std::unordered_map<SignalNumericIdType, size_t> downsampleCounters;
+    // admission decided for recent packets, value packets follow the decision made for their domain packet
+    // whether it is queued before or after them
+    std::deque<Int> admissionDecisionsOrder;
+    std::unordered_map<Int, bool> admissionDecisions;
+
+    // send thread of the server the packets of the session are queued on
+    size_t sendThreadIndex;
+    // signals are announced once the client has declared its event packet encoding
+    std::atomic<bool> initialSignalsSent;
+
+    // payloads of data packets are placed in the ring once the client has mapped it
+    SharedMemoryRingPtr offeredSharedMemoryRing;
+    SharedMemoryRingPtr sharedMemoryRing;
 };
 END_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
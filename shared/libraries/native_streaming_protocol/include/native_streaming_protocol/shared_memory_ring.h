@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <native_streaming_protocol/native_streaming_protocol.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
+
+class SharedMemoryRing;
+using SharedMemoryRingPtr = std::shared_ptr<SharedMemoryRing>;
+
+// smaller payloads are cheaper to send inline than to reference in the ring
+static constexpr size_t SHARED_MEMORY_MIN_PAYLOAD_SIZE = 1024;
+static constexpr size_t SHARED_MEMORY_DEFAULT_RING_SIZE = 32 * 1024 * 1024;
+
+/*
+ * Single producer, single consumer byte ring placed in POSIX shared memory (Linux only). The
+ * server writes packet payloads into the ring and sends their positions in order over the
+ * session socket; the client acquires the payloads at those positions and references them
+ * directly from the packets it creates. Slots may be released in any order, the read position
+ * stored in the shared control block advances once all preceding slots are released. Every
+ * payload is stored contiguously.
+ */
+class SharedMemoryRing
+{
+public:
+    static bool isSupported();
+
+    // creates and owns a new uniquely named ring, the name is unlinked when the ring is destroyed
+    static SharedMemoryRingPtr create(size_t capacity);
+    // maps a ring created by another process, the token guards against opening a foreign segment
+    static SharedMemoryRingPtr open(const std::string& name, size_t capacity, uint64_t token);
+
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    const std::string& getName() const;
+    size_t getCapacity() const;
+    uint64_t getToken() const;
+
+    // removes the name of an owned ring, existing mappings stay valid
+    void unlink();
+
+    // producer side, returns false if the ring has not enough free space
+    bool tryWrite(const void* data, size_t size, uint64_t& position);
+
+    // consumer side, slots have to be acquired in the order they were written
+    const void* acquire(uint64_t position, size_t size);
+    void release(uint64_t position);
+
+private:
+    struct Control
+    {
+        uint64_t magic;
+        uint64_t token;
+        uint64_t capacity;
+        std::atomic<uint64_t> readPosition;
+    };
+
+    struct AcquiredSlot
+    {
+        uint64_t position;
+        uint64_t end;
+        bool released;
+    };
+
+    SharedMemoryRing(std::string name, size_t capacity, bool owner);
+
+    void map(int fd);
+
+    std::string name;
+    size_t capacity;
+    bool owner;
+    void* mapping;
+    size_t mappingSize;
+    Control* control;
+    uint8_t* data;
+    uint64_t writePosition;
+
+    std::mutex acquiredSlotsSync;
+    std::deque<AcquiredSlot> acquiredSlots;
+};
+
+END_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
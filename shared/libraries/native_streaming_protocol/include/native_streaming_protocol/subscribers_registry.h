@@ -26,6 +26,17 @@
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
 
 using SendToClientCallback = std::function<void(std::shared_ptr<ServerSessionHandler>& sessionHandler)>;
+using SendToSubscriberListCallback = std::function<void(std::vector<std::shared_ptr<ServerSessionHandler>>& subscribers)>;
+
+/// Pre-resolved signal entry which lets the packet sending path skip the string id lookups.
+/// The subscribers list is owned by the registry and accessed only under its lock, senders get a copy of it.
+struct SignalHandle
+{
+    SignalNumericIdType signalNumericId;
+    std::vector<std::shared_ptr<ServerSessionHandler>> subscribers;
+};
+
+using SignalHandlePtr = std::shared_ptr<SignalHandle>;
 
 class SubscribersRegistry
 {
@@ -34,10 +45,13 @@ public:
 
     void sendToClients(SendToClientCallback sendCallback);
     void sendToSubscribers(const SignalPtr& signal, SendToClientCallback sendCallback);
+    void sendToSubscribers(const SignalHandlePtr& signalHandle, const SendToClientCallback& sendCallback);
+    void sendToSubscriberList(const SignalHandlePtr& signalHandle, const SendToSubscriberListCallback& sendCallback);
     void sendToClient(SessionPtr session, SendToClientCallback sendCallback);
 
-    void registerSignal(const SignalPtr& signal);
+    void registerSignal(const SignalPtr& signal, SignalNumericIdType signalNumericId);
     bool removeSignal(const SignalPtr& signal);
+    SignalHandlePtr getSignalHandle(const SignalPtr& signal);
 
     void registerClient(std::shared_ptr<ServerSessionHandler> sessionHandler);
     std::vector<std::string> unregisterClient(SessionPtr session);
@@ -50,7 +64,7 @@ private:
     LoggerPtr logger;
     LoggerComponentPtr loggerComponent;
 
-    std::unordered_map<std::string, std::vector<std::shared_ptr<ServerSessionHandler>>> signalsSubscribers;
+    std::unordered_map<std::string, SignalHandlePtr> signalsSubscribers;
     std::vector<std::shared_ptr<ServerSessionHandler>> sessionHandlers;
     std::mutex sync;
 };
@@ -16,12 +16,15 @@ ClientSessionHandler::ClientSessionHandler(const ContextPtr& daqContext,
                                            OnPacketReceivedCallback packetReceivedHandler,
                                            OnProtocolInitDoneCallback protocolInitDoneHandler,
                                            OnSubscriptionAckCallback subscriptionAckHandler,
-                                           OnSessionErrorCallback errorHandler)
+                                           OnSessionErrorCallback errorHandler,
+                                           AllocatorPtr packetAllocator)
     : BaseSessionHandler(daqContext, session, ioContext, errorHandler, "NativeProtocolClientSessionHandler")
     , signalReceivedHandler(signalReceivedHandler)
     , packetReceivedHandler(packetReceivedHandler)
     , protocolInitDoneHandler(protocolInitDoneHandler)
     , subscriptionAckHandler(subscriptionAckHandler)
+    , packetStreamingClient(std::move(packetAllocator))
+    , packetBufferArena(std::make_shared<PacketBufferArena>())
 {
 }
 
@@ -88,43 +91,70 @@ EventPacketPtr ClientSessionHandler::getDataDescriptorChangedEventPacket(const S
     return packetStreamingClient.getDataDescriptorChangedEventPacket(signalNumericId);
 }
 
+EventPacketStatistics ClientSessionHandler::getEventPacketStatistics() const
+{
+    return packetStreamingClient.getEventPacketStatistics();
+}
+
+ReferenceStatistics ClientSessionHandler::getReferenceStatistics() const
+{
+    return packetStreamingClient.getReferenceStatistics();
+}
+
+PacketBufferPtr ClientSessionHandler::readPacketBufferHeader(const void* data, size_t size, size_t& bytesDone)
+{
+    decltype(GenericPacketHeader::size) headerSize;
+
+    // Get packet buffer header size from received buffer
+    copyData(&headerSize, data, sizeof(headerSize), bytesDone, size);
+    LOG_T("Received packet buffer header size: {}", headerSize);
+
+    if (headerSize < sizeof(GenericPacketHeader))
+    {
+        LOG_E("Unsupported streaming packet buffer header size: {}. Skipping payload.", headerSize);
+        return nullptr;
+    }
+    if (bytesDone + headerSize > size)
+        throw DaqException(OPENDAQ_ERR_GENERALERROR,
+                           fmt::format(R"(Streaming packet buffer header of {} bytes exceeds received data with size {} bytes)",
+                                       headerSize,
+                                       size));
+
+    // Get packet buffer header from received buffer into the inline header of the packet buffer,
+    // newer peers may send larger headers, the fields unknown to this version are skipped
+    const size_t knownHeaderSize = std::min<size_t>(headerSize, sizeof(PacketBuffer::InlineHeader));
+    auto recvPacketBuffer =
+        std::allocate_shared<PacketBuffer>(PacketBufferAllocator<PacketBuffer>(packetBufferArena), nullptr, nullptr);
+    copyData(recvPacketBuffer->packetHeader, data, knownHeaderSize, bytesDone, size);
+    recvPacketBuffer->packetHeader->size = static_cast<uint8_t>(knownHeaderSize);
+    LOG_T("Received packet buffer header: header size {}, payload size {}", headerSize, recvPacketBuffer->packetHeader->payloadSize);
+    bytesDone += headerSize;
+
+    return recvPacketBuffer;
+}
+
 ReadTask ClientSessionHandler::readPacket(const void* data, size_t size)
 {
     size_t bytesDone = 0;
 
-    GenericPacketHeader* packetBufferHeader {};
-    void* packetBufferPayload;
+    PacketBufferPtr recvPacketBuffer;
 
     try
     {
-        decltype(GenericPacketHeader::size) headerSize;
-
-        // Get packet buffer header size from received buffer
-        copyData(&headerSize, data, sizeof(headerSize), bytesDone, size);
-        LOG_T("Received packet buffer header size: {}", headerSize);
-
-        if (headerSize < sizeof(GenericPacketHeader))
-        {
-            LOG_E("Unsupported streaming packet buffer header size: {}. Skipping payload.", headerSize);
+        recvPacketBuffer = readPacketBufferHeader(data, size, bytesDone);
+        if (!recvPacketBuffer)
             return createReadHeaderTask();
-        }
-
-        // Get packet buffer header from received buffer
-        packetBufferHeader = static_cast<GenericPacketHeader*>(std::malloc(headerSize));
-        copyData(packetBufferHeader, data, headerSize, bytesDone, size);
-        LOG_T("Received packet buffer header: header size {}, payload size {}",
-              packetBufferHeader->size, packetBufferHeader->payloadSize);
-        bytesDone += headerSize;
 
-        // Get packet buffer payload from received buffer
-        if (packetBufferHeader->payloadSize > 0)
-        {
-            packetBufferPayload = std::malloc(packetBufferHeader->payloadSize);
-            copyData(packetBufferPayload, data, packetBufferHeader->payloadSize, bytesDone, size);
-        }
-        else
+        // Payload is referenced in the received buffer, packet streaming client copies it to the packet memory
+        const auto payloadSize = recvPacketBuffer->packetHeader->payloadSize;
+        if (payloadSize > 0)
         {
-            packetBufferPayload = nullptr;
+            if (bytesDone + payloadSize > size)
+                throw DaqException(OPENDAQ_ERR_GENERALERROR,
+                                   fmt::format(R"(Packet payload of {} bytes exceeds received data with size {} bytes)",
+                                               payloadSize,
+                                               size));
+            recvPacketBuffer->payload = static_cast<const char*>(data) + bytesDone;
         }
     }
     catch (const DaqException& e)
@@ -134,23 +164,125 @@ ReadTask ClientSessionHandler::readPacket(const void* data, size_t size)
         return createReadStopTask();
     }
 
-    auto recvPacketBuffer =
-        std::make_shared<PacketBuffer>(packetBufferHeader,
-                                       packetBufferPayload,
-                                       [packetBufferHeader, packetBufferPayload]()
-                                       {
-                                           std::free(packetBufferHeader);
-                                           if (packetBufferPayload != nullptr)
-                                               std::free(packetBufferPayload);
-                                       });
+    try
+    {
+        packetStreamingClient.addPacketBuffer(recvPacketBuffer);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_E("Protocol error: {}", e.what());
+        errorHandler(std::string("Protocol error - readPacket - ") + e.what(), session);
+        return createReadStopTask();
+    }
+
+    processReceivedPackets();
+
+    return createReadHeaderTask();
+}
+
+ReadTask ClientSessionHandler::readSharedMemoryPacket(const void* data, size_t size)
+{
+    size_t bytesDone = 0;
 
-    packetStreamingClient.addPacketBuffer(recvPacketBuffer);
+    PacketBufferPtr recvPacketBuffer;
+
+    try
+    {
+        if (!sharedMemoryRing)
+            throw DaqException(OPENDAQ_ERR_GENERALERROR, "Shared memory packet received without mapped ring");
+
+        recvPacketBuffer = readPacketBufferHeader(data, size, bytesDone);
+        if (!recvPacketBuffer)
+            return createReadHeaderTask();
+
+        // Get position of the payload in the shared memory ring
+        uint64_t ringPosition;
+        copyData(&ringPosition, data, sizeof(ringPosition), bytesDone, size);
+        const size_t payloadSize = recvPacketBuffer->packetHeader->payloadSize;
+        recvPacketBuffer->payload = sharedMemoryRing->acquire(ringPosition, payloadSize);
+
+        // the ring slot is handed back to the server once the last packet referencing it is destroyed
+        recvPacketBuffer->payloadHolder = std::shared_ptr<void>(
+            nullptr,
+            [ring = sharedMemoryRing, ringPosition](void*) { ring->release(ringPosition); });
+    }
+    catch (const std::exception& e)
+    {
+        LOG_E("Protocol error: {}", e.what());
+        errorHandler(std::string("Protocol error - readSharedMemoryPacket - ") + e.what(), session);
+        return createReadStopTask();
+    }
+
+    try
+    {
+        packetStreamingClient.addPacketBuffer(recvPacketBuffer);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_E("Protocol error: {}", e.what());
+        errorHandler(std::string("Protocol error - readSharedMemoryPacket - ") + e.what(), session);
+        return createReadStopTask();
+    }
 
     processReceivedPackets();
 
     return createReadHeaderTask();
 }
 
+ReadTask ClientSessionHandler::readSharedMemoryTransportOffer(const void* data, size_t size)
+{
+    size_t bytesDone = 0;
+
+    uint64_t ringCapacity;
+    uint64_t ringToken;
+    std::string ringName;
+
+    try
+    {
+        copyData(&ringCapacity, data, sizeof(ringCapacity), bytesDone, size);
+        bytesDone += sizeof(ringCapacity);
+        copyData(&ringToken, data, sizeof(ringToken), bytesDone, size);
+        bytesDone += sizeof(ringToken);
+        ringName = getStringFromData(data, size - bytesDone, bytesDone, size);
+    }
+    catch (const DaqException& e)
+    {
+        LOG_E("Protocol error: {}", e.what());
+        errorHandler(std::string("Protocol error - readSharedMemoryTransportOffer - ") + e.what(), session);
+        return createReadStopTask();
+    }
+
+    // opening fails if the server runs on another host, packets are then kept on the socket
+    try
+    {
+        sharedMemoryRing = SharedMemoryRing::open(ringName, ringCapacity, ringToken);
+        LOG_I("Shared memory transport accepted, ring \"{}\" of {} bytes", ringName, ringCapacity);
+    }
+    catch (const std::exception& e)
+    {
+        sharedMemoryRing.reset();
+        LOG_I("Shared memory transport declined: {}", e.what());
+    }
+
+    sendSharedMemoryTransportReply(sharedMemoryRing != nullptr);
+
+    return createReadHeaderTask();
+}
+
+void ClientSessionHandler::sendSharedMemoryTransportReply(bool accepted)
+{
+    std::vector<WriteTask> tasks;
+
+    tasks.push_back(createWriteNumberTask<uint8_t>(accepted ? 1 : 0));
+
+    // create write task for transport header
+    size_t payloadSize = calculatePayloadSize(tasks);
+    auto writeHeaderTask = createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT, payloadSize);
+    tasks.insert(tasks.begin(), writeHeaderTask);
+
+    session->scheduleWrite(tasks);
+}
+
 void ClientSessionHandler::processReceivedPackets()
 {
     auto [signalId, packet] = packetStreamingClient.getNextDaqPacket();
@@ -312,6 +444,26 @@ ReadTask ClientSessionHandler::readHeader(const void* data, size_t size)
             payloadSize
         );
     }
+    else if (payloadType == PayloadType::PAYLOAD_TYPE_STREAMING_PACKET_SHARED_MEMORY)
+    {
+        return ReadTask(
+            [this](const void* data, size_t size)
+            {
+                return readSharedMemoryPacket(data, size);
+            },
+            payloadSize
+        );
+    }
+    else if (payloadType == PayloadType::PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT)
+    {
+        return ReadTask(
+            [this](const void* data, size_t size)
+            {
+                return readSharedMemoryTransportOffer(data, size);
+            },
+            payloadSize
+        );
+    }
     else if (payloadType == PayloadType::PAYLOAD_TYPE_STREAMING_PROTOCOL_INIT_DONE)
     {
         protocolInitDoneHandler();
@@ -0,0 +1,56 @@
+#include <native_streaming_protocol/io_context_pool.h>
+
+#include <boost/asio/post.hpp>
+
+BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
+
+IoContextPool::IoContextPool(size_t size)
+{
+    ioContexts.reserve(size);
+    workGuards.reserve(size);
+    threads.reserve(size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        ioContexts.push_back(std::make_unique<boost::asio::io_context>(1));
+        workGuards.push_back(boost::asio::make_work_guard(*ioContexts.back()));
+    }
+
+    for (size_t i = 0; i < size; ++i)
+        threads.emplace_back([ioContext = ioContexts[i].get()]() { ioContext->run(); });
+}
+
+IoContextPool::~IoContextPool()
+{
+    stop();
+}
+
+size_t IoContextPool::size() const
+{
+    return ioContexts.size();
+}
+
+boost::asio::io_context& IoContextPool::getIoContext(size_t index)
+{
+    return *ioContexts.at(index);
+}
+
+void IoContextPool::post(size_t index, std::function<void()> work)
+{
+    boost::asio::post(*ioContexts.at(index), std::move(work));
+}
+
+void IoContextPool::stop()
+{
+    for (auto& workGuard : workGuards)
+        workGuard.reset();
+    for (auto& ioContext : ioContexts)
+        ioContext->stop();
+    for (auto& thread : threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+END_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
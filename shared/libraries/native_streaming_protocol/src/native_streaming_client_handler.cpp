@@ -105,6 +105,11 @@ void NativeStreamingClientHandler::setSignalUnavailableHandler(const OnSignalUna
     this->signalUnavailableHandler = signalUnavailableHandler;
 }
 
+void NativeStreamingClientHandler::setPacketAllocator(const AllocatorPtr& packetAllocator)
+{
+    this->packetAllocator = packetAllocator;
+}
+
 void NativeStreamingClientHandler::setSignalAvailableHandler(const OnSignalAvailableCallback& signalAvailableHandler)
 {
     this->signalAvailableHandler = signalAvailableHandler;
@@ -250,6 +255,22 @@ EventPacketPtr NativeStreamingClientHandler::getDataDescriptorChangedEventPacket
     return DataDescriptorChangedEventPacket(nullptr, nullptr);
 }
 
+packet_streaming::EventPacketStatistics NativeStreamingClientHandler::getEventPacketStatistics()
+{
+    std::scoped_lock lock(sync);
+    if (sessionHandler)
+        return sessionHandler->getEventPacketStatistics();
+    return {0, 0};
+}
+
+packet_streaming::ReferenceStatistics NativeStreamingClientHandler::getReferenceStatistics()
+{
+    std::scoped_lock lock(sync);
+    if (sessionHandler)
+        return sessionHandler->getReferenceStatistics();
+    return {0, 0, 0, 0};
+}
+
 void NativeStreamingClientHandler::sendConfigRequest(const config_protocol::PacketBuffer& packet)
 {
     if (sessionHandler)
@@ -318,7 +339,8 @@ void NativeStreamingClientHandler::initClientSessionHandler(SessionPtr session)
                                                             packetReceivedHandler,
                                                             protocolInitDoneHandler,
                                                             subscriptionAckCallback,
-                                                            errorHandler);
+                                                            errorHandler,
+                                                            packetAllocator);
 
     ConfigProtocolPacketCb configPacketReceivedHandler =
         [this](const config_protocol::PacketBuffer& packet)
@@ -9,10 +9,16 @@
 
 #include <coreobjects/property_object_factory.h>
 
+#include <algorithm>
+#include <optional>
+
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
 
 using namespace daq::native_streaming;
 
+// signals are announced to clients that do not send their transport layer properties after this delay
+static constexpr auto TRANSPORT_LAYER_PROPERTIES_TIMEOUT = std::chrono::milliseconds(500);
+
 NativeStreamingServerHandler::NativeStreamingServerHandler(const ContextPtr& context,
                                                            std::shared_ptr<boost::asio::io_context> ioContextPtr,
                                                            const ListPtr<ISignal>& signalsList,
@@ -27,13 +33,17 @@ NativeStreamingServerHandler::NativeStreamingServerHandler(const ContextPtr& con
     , signalSubscribedHandler(signalSubscribedHandler)
     , signalUnsubscribedHandler(signalUnsubscribedHandler)
     , setUpConfigProtocolServerCb(setUpConfigProtocolServerCb)
+    , maxWriteBatchSize(0)
+    , writeBatchFlushDelay(0)
+    , sendThreadCount(0)
+    , encodeOnSocketThread(false)
 {
     for (const auto& signal : signalsList)
     {
         if (signal.getPublic())
         {
-            registerSignal(signal);
-            subscribersRegistry.registerSignal(signal);
+            auto signalNumericId = registerSignal(signal);
+            subscribersRegistry.registerSignal(signal, signalNumericId);
         }
     }
 }
@@ -55,6 +65,13 @@ void NativeStreamingServerHandler::startServer(uint16_t port)
                                    msg,
                                    static_cast<LogLevel>(level));
     };
+
+    if (sendThreadCount > 0 && !encodeOnSocketThread && !sendThreadPool)
+    {
+        sendThreadPool = std::make_unique<IoContextPool>(sendThreadCount);
+        sendThreadSessionCounts.assign(sendThreadCount, 0);
+    }
+
     server = std::make_shared<daq::native_streaming::Server>(onNewSessionCallback, ioContextPtr, logCallback);
     server->start(port);
 }
@@ -77,14 +94,21 @@ void NativeStreamingServerHandler::addSignal(const SignalPtr& signal)
 
     auto signalNumericId = registerSignal(signal);
 
-    subscribersRegistry.registerSignal(signal);
-    subscribersRegistry.sendToClients([signalNumericId, signal](std::shared_ptr<ServerSessionHandler>& sessionHandler)
+    subscribersRegistry.registerSignal(signal, signalNumericId);
+    subscribersRegistry.sendToClients([this, signalNumericId, signal](std::shared_ptr<ServerSessionHandler>& sessionHandler)
                                       {
-                                          sessionHandler->sendSignalAvailable(signalNumericId, signal);
-
-                                          // create and send event packet to initialize packet streaming
-                                          sessionHandler->sendPacket(signalNumericId,
-                                                                     createDataDescriptorChangedEventPacket(signal));
+                                          // announced with the initial signals of the session otherwise
+                                          if (!sessionHandler->getInitialSignalsSent())
+                                              return;
+                                          postToSendThread(sessionHandler,
+                                                           [sessionHandler, signalNumericId, signal]()
+                                                           {
+                                                               sessionHandler->sendSignalAvailable(signalNumericId, signal);
+
+                                                               // create and send event packet to initialize packet streaming
+                                                               sessionHandler->sendPacket(signalNumericId,
+                                                                                          createDataDescriptorChangedEventPacket(signal));
+                                                           });
                                       });
 }
 
@@ -115,9 +139,16 @@ void NativeStreamingServerHandler::removeSignalInternal(const SignalPtr& signal)
     if (subscribersRegistry.removeSignal(signal))
         signalUnsubscribedHandler(signal);
     auto signalNumericId = findSignalNumericId(signal);
-    subscribersRegistry.sendToClients([signalNumericId, signal](std::shared_ptr<ServerSessionHandler>& sessionHandler)
+    // sent from the send thread of the session, so it follows the packets of the signal still queued there
+    subscribersRegistry.sendToClients([this, signalNumericId, signal](std::shared_ptr<ServerSessionHandler>& sessionHandler)
                                       {
-                                          sessionHandler->sendSignalUnavailable(signalNumericId, signal);
+                                          if (!sessionHandler->getInitialSignalsSent())
+                                              return;
+                                          postToSendThread(sessionHandler,
+                                                           [sessionHandler, signalNumericId, signal]()
+                                                           {
+                                                               sessionHandler->sendSignalUnavailable(signalNumericId, signal);
+                                                           });
                                       });
     unregisterSignal(signal);
 }
@@ -170,17 +201,165 @@ bool NativeStreamingServerHandler::handleSignalSubscription(const SignalNumericI
 
 void NativeStreamingServerHandler::sendPacket(const SignalPtr& signal, const PacketPtr& packet)
 {
-    auto signalNumericId = findSignalNumericId(signal);
-    subscribersRegistry.sendToSubscribers(
-        signal,
-        [signalNumericId, &packet](std::shared_ptr<ServerSessionHandler>& sessionHandler)
+    sendPacket(subscribersRegistry.getSignalHandle(signal), packet);
+}
+
+void NativeStreamingServerHandler::sendPacket(const SignalHandlePtr& signalHandle, const PacketPtr& packet)
+{
+    sendPackets(signalHandle, List<IPacket>(packet));
+}
+
+void NativeStreamingServerHandler::sendPackets(const SignalHandlePtr& signalHandle, const ListPtr<IPacket>& packets)
+{
+    const auto signalNumericId = signalHandle->signalNumericId;
+
+    subscribersRegistry.sendToSubscriberList(
+        signalHandle,
+        [this, signalNumericId, &packets](std::vector<std::shared_ptr<ServerSessionHandler>>& subscribers)
         {
-            sessionHandler->sendPacket(signalNumericId, packet);
+            queuePacketsForSubscribers(signalNumericId, packets, subscribers);
         });
 }
 
+void NativeStreamingServerHandler::queuePacketsForSubscribers(SignalNumericIdType signalNumericId,
+                                                              const ListPtr<IPacket>& packets,
+                                                              std::vector<std::shared_ptr<ServerSessionHandler>>& subscribers)
+{
+    if (subscribers.empty())
+        return;
+
+    // each packet is encoded once by the first subscriber and the encoded buffer is shared with the others,
+    // the release notifications are set up once all subscribers have queued the packets
+    std::shared_ptr<std::vector<packet_streaming::SharedPacketEncoding>> sharedEncodings(
+        new std::vector<packet_streaming::SharedPacketEncoding>(packets.getCount()),
+        [packets, loggerComponent = loggerComponent](std::vector<packet_streaming::SharedPacketEncoding>* encodings)
+        {
+            try
+            {
+                size_t index = 0;
+                for (const auto& packet : packets)
+                    packet_streaming::PacketStreamingServer::completeSharedEncoding(packet, (*encodings)[index++]);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_E("Failed to complete shared packet encoding: {}", e.what());
+            }
+            delete encodings;
+        });
+
+    for (const auto& sessionHandler : subscribers)
+    {
+        postToSendThread(sessionHandler,
+                         [sessionHandler, signalNumericId, packets, sharedEncodings]()
+                         {
+                             size_t index = 0;
+                             for (const auto& packet : packets)
+                                 sessionHandler->queuePacket(signalNumericId, packet, (*sharedEncodings)[index++]);
+                             sessionHandler->completeSendCycle();
+                         });
+    }
+}
+
+void NativeStreamingServerHandler::postToSendThread(const std::shared_ptr<ServerSessionHandler>& sessionHandler,
+                                                    std::function<void()> work)
+{
+    if (!sendThreadPool && !encodeOnSocketThread)
+    {
+        work();
+        return;
+    }
+
+    auto postedWork = [work = std::move(work), loggerComponent = loggerComponent]()
+    {
+        try
+        {
+            work();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_W("Failed to send to client: {}", e.what());
+        }
+    };
+
+    // the sockets are served by the single thread running the io_context, posting to it keeps the order
+    if (encodeOnSocketThread)
+    {
+        boost::asio::post(*ioContextPtr, std::move(postedWork));
+        return;
+    }
+
+    // the work of a session is queued on the thread assigned on accept, so it is executed in order
+    // without waiting, while sessions assigned to other threads are served in parallel
+    sendThreadPool->post(sessionHandler->getSendThreadIndex(), std::move(postedWork));
+}
+
+void NativeStreamingServerHandler::setSendThreadCount(size_t threadCount)
+{
+    this->sendThreadCount = threadCount;
+}
+
+void NativeStreamingServerHandler::setEncodeOnSocketThread(bool encodeOnSocketThread)
+{
+    this->encodeOnSocketThread = encodeOnSocketThread;
+}
+
+void NativeStreamingServerHandler::setWriteBatchingParams(size_t maxBatchSize, std::chrono::microseconds flushDelay)
+{
+    this->maxWriteBatchSize = maxBatchSize;
+    this->writeBatchFlushDelay = flushDelay;
+}
+
+void NativeStreamingServerHandler::setSendQueueLimits(const SendQueueLimits& limits)
+{
+    this->sendQueueLimits = limits;
+}
+
+SendQueueStatistics NativeStreamingServerHandler::getSendQueueStatistics()
+{
+    SendQueueStatistics statistics{0, 0, 0};
+    subscribersRegistry.sendToClients(
+        [&statistics](std::shared_ptr<ServerSessionHandler>& sessionHandler)
+        {
+            const auto sessionStatistics = sessionHandler->getSendQueueStatistics();
+            statistics.queuedBytes += sessionStatistics.queuedBytes;
+            statistics.queuedPackets += sessionStatistics.queuedPackets;
+            statistics.droppedPackets += sessionStatistics.droppedPackets;
+        });
+    return statistics;
+}
+
+std::vector<size_t> NativeStreamingServerHandler::getSendThreadSessionCounts()
+{
+    std::scoped_lock lock(sync);
+    return sendThreadSessionCounts;
+}
+
+SignalHandlePtr NativeStreamingServerHandler::getSignalHandle(const SignalPtr& signal)
+{
+    return subscribersRegistry.getSignalHandle(signal);
+}
+
 void NativeStreamingServerHandler::releaseSessionHandler(SessionPtr session)
 {
+    // stops the batched writes still pending for the session, before the handler is released
+    std::optional<size_t> releasedSendThreadIndex;
+    subscribersRegistry.sendToClients(
+        [this, &session, &releasedSendThreadIndex](std::shared_ptr<ServerSessionHandler>& sessionHandler)
+        {
+            if (sessionHandler->getSession() != session)
+                return;
+
+            sessionHandler->close();
+            if (sendThreadPool)
+                releasedSendThreadIndex = sessionHandler->getSendThreadIndex();
+        });
+
+    if (releasedSendThreadIndex.has_value())
+    {
+        std::scoped_lock lock(sync);
+        sendThreadSessionCounts[releasedSendThreadIndex.value()]--;
+    }
+
     auto toUnsubscribe = subscribersRegistry.unregisterClient(session);
     for (const auto& item : toUnsubscribe)
     {
@@ -217,6 +396,36 @@ void NativeStreamingServerHandler::handleTransportLayerProps(const PropertyObjec
     {
         LOG_W("Invalid transport layer properties");
     }
+
+    // optional, clients not declaring the property receive JSON encoded event packets
+    if (propertyObject.hasProperty("EventPacketVersion") &&
+        propertyObject.getProperty("EventPacketVersion").getValueType() == ctInt)
+    {
+        Int eventPacketVersion = propertyObject.getPropertyValue("EventPacketVersion");
+        LOG_I("Event packet version {}", eventPacketVersion);
+        if (eventPacketVersion > 0)
+            sessionHandler->setEventPacketVersion(static_cast<uint8_t>(std::min<Int>(eventPacketVersion, PACKET_EVENT_VERSION_BINARY)));
+    }
+
+    if (propertyObject.hasProperty("PayloadCompression") &&
+        propertyObject.getProperty("PayloadCompression").getValueType() == ctBool)
+    {
+        Bool payloadCompression = propertyObject.getPropertyValue("PayloadCompression");
+        LOG_I("Payload compression {}", payloadCompression ? "enabled" : "disabled");
+        sessionHandler->setPayloadCompression(payloadCompression);
+    }
+
+    // the offer fails on the client side if it runs on another host, the session then stays on the socket
+    if (propertyObject.hasProperty("SharedMemoryTransport") &&
+        propertyObject.getProperty("SharedMemoryTransport").getValueType() == ctBool)
+    {
+        Bool sharedMemoryTransport = propertyObject.getPropertyValue("SharedMemoryTransport");
+        if (sharedMemoryTransport && SharedMemoryRing::isSupported())
+            sessionHandler->offerSharedMemoryTransport(SHARED_MEMORY_DEFAULT_RING_SIZE);
+    }
+
+    // the event packets announcing the signals are encoded with the version requested above
+    sendInitialSignals(sessionHandler);
 }
 
 void NativeStreamingServerHandler::setUpTransportLayerPropsCallback(std::shared_ptr<ServerSessionHandler> sessionHandler)
@@ -273,9 +482,45 @@ void NativeStreamingServerHandler::initSessionHandler(SessionPtr session)
                                                                  session,
                                                                  signalSubscriptionHandler,
                                                                  errorHandler);
+    sessionHandler->setWriteBatchingParams(maxWriteBatchSize, writeBatchFlushDelay);
+    sessionHandler->setSendQueueLimits(sendQueueLimits);
+    if (sendThreadPool)
+    {
+        // the session is served by the send thread with the fewest sessions for its whole lifetime
+        std::scoped_lock lock(sync);
+        const auto leastLoaded = std::min_element(sendThreadSessionCounts.begin(), sendThreadSessionCounts.end());
+        sessionHandler->setSendThreadIndex(static_cast<size_t>(leastLoaded - sendThreadSessionCounts.begin()));
+        (*leastLoaded)++;
+    }
     setUpTransportLayerPropsCallback(sessionHandler);
     setUpConfigProtocolCallbacks(sessionHandler);
 
+    subscribersRegistry.registerClient(sessionHandler);
+    sessionHandler->startReading();
+    sessionHandler->startReleaseTimer();
+
+    // the signals are sent once the transport layer properties are received, clients that do not send them
+    // receive the signals with JSON encoded event packets after the timeout
+    auto initialSignalsTimer = std::make_shared<boost::asio::steady_timer>(*ioContextPtr);
+    initialSignalsTimer->expires_from_now(TRANSPORT_LAYER_PROPERTIES_TIMEOUT);
+    initialSignalsTimer->async_wait(
+        [this, initialSignalsTimer, sessionHandlerWeakPtr = std::weak_ptr<ServerSessionHandler>(sessionHandler)](const boost::system::error_code& ec)
+        {
+            if (ec)
+                return;
+            if (auto sessionHandlerPtr = sessionHandlerWeakPtr.lock())
+                sendInitialSignals(sessionHandlerPtr);
+        });
+}
+
+void NativeStreamingServerHandler::sendInitialSignals(const std::shared_ptr<ServerSessionHandler>& sessionHandler)
+{
+    // posted while locked, so the initial signals are queued on the send thread of the session
+    // before the signals added or removed afterwards
+    std::scoped_lock lock(sync);
+    if (!sessionHandler->markInitialSignalsSent())
+        return;
+
     // send sorted signals to newly connected client
     std::map<SignalNumericIdType, SignalPtr> sortedSignals;
     for (const auto& signalRegistryItem : signalRegistry)
@@ -283,17 +528,19 @@ void NativeStreamingServerHandler::initSessionHandler(SessionPtr session)
         sortedSignals.insert({std::get<1>(signalRegistryItem.second),
                               std::get<0>(signalRegistryItem.second)});
     }
-    for (const auto& sortedSignalsItem : sortedSignals)
-    {
-        sessionHandler->sendSignalAvailable(sortedSignalsItem.first, sortedSignalsItem.second);
-
-        // create and send event packet to initialize packet streaming
-        sessionHandler->sendPacket(sortedSignalsItem.first,
-                                   createDataDescriptorChangedEventPacket(sortedSignalsItem.second));
-    }
-    sessionHandler->sendInitializationDone();
-    subscribersRegistry.registerClient(sessionHandler);
-    sessionHandler->startReading();
+    postToSendThread(sessionHandler,
+                     [sessionHandler, sortedSignals = std::move(sortedSignals)]()
+                     {
+                         for (const auto& sortedSignalsItem : sortedSignals)
+                         {
+                             sessionHandler->sendSignalAvailable(sortedSignalsItem.first, sortedSignalsItem.second);
+
+                             // create and send event packet to initialize packet streaming
+                             sessionHandler->sendPacket(sortedSignalsItem.first,
+                                                        createDataDescriptorChangedEventPacket(sortedSignalsItem.second));
+                         }
+                         sessionHandler->sendInitializationDone();
+                     });
 }
 
 SignalNumericIdType NativeStreamingServerHandler::findSignalNumericId(const SignalPtr& signal)
@@ -2,14 +2,20 @@
 #include <native_streaming_protocol/native_streaming_protocol_types.h>
 
 #include <opendaq/custom_log.h>
+#include <opendaq/data_packet_ptr.h>
 
 #include <coretypes/json_serializer_factory.h>
 
+#include <boost/asio/post.hpp>
+
 BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
 
 using namespace daq::native_streaming;
 using namespace packet_streaming;
 
+// released packets are reported to the client at the latest after this delay, also when no more packets are sent
+static constexpr auto RELEASE_MAX_DELAY = std::chrono::milliseconds(100);
+
 ServerSessionHandler::ServerSessionHandler(const ContextPtr& daqContext,
                                            boost::asio::io_context& ioContext,
                                            SessionPtr session,
@@ -18,12 +24,72 @@ ServerSessionHandler::ServerSessionHandler(const ContextPtr& daqContext,
     : BaseSessionHandler(daqContext, session, ioContext, errorHandler, "NativeProtocolServerSessionHandler")
     , signalSubscriptionHandler(signalSubscriptionHandler)
     , transportLayerPropsHandler(nullptr)
-    , packetStreamingServer(10)
+    , packetStreamingServer(10, RELEASE_MAX_DELAY, 1024 * 1024)
+    , pendingWriteSize(0)
+    , maxBatchSize(0)
+    , flushDelay(0)
+    , flushTimer(std::make_shared<boost::asio::steady_timer>(ioContext))
+    , flushTimerArmed(false)
+    , releaseTimer(std::make_shared<boost::asio::steady_timer>(ioContext))
+    , sendQueueCounters(std::make_shared<SendQueueCounters>())
+    , sendQueueOverLimit(false)
+    , disconnectRequested(false)
+    , droppedPacketsAtLimit(0)
+    , sendThreadIndex(0)
+    , initialSignalsSent(false)
 {
 }
 
 ServerSessionHandler::~ServerSessionHandler()
 {
+    flushTimer->cancel();
+    releaseTimer->cancel();
+}
+
+void ServerSessionHandler::close()
+{
+    releaseTimer->cancel();
+    {
+        std::scoped_lock lock(pendingWritesSync);
+        flushTimer->cancel();
+        flushTimerArmed = false;
+        pendingWriteTasks.clear();
+        pendingWriteSize = 0;
+    }
+
+    if (session->isOpen())
+        session->close();
+}
+
+void ServerSessionHandler::setWriteBatchingParams(size_t maxBatchSize, std::chrono::microseconds flushDelay)
+{
+    std::scoped_lock lock(pendingWritesSync);
+    this->maxBatchSize = maxBatchSize;
+    this->flushDelay = flushDelay;
+}
+
+void ServerSessionHandler::scheduleWrite(const std::vector<WriteTask>& tasks)
+{
+    // preserves the order of messages relative to the streaming packets still waiting in the batch
+    std::scoped_lock lock(pendingWritesSync);
+    flushPendingWritesInternal();
+    session->scheduleWrite(tasks);
+}
+
+void ServerSessionHandler::flushPendingWrites()
+{
+    std::scoped_lock lock(pendingWritesSync);
+    flushPendingWritesInternal();
+}
+
+void ServerSessionHandler::flushPendingWritesInternal()
+{
+    if (pendingWriteTasks.empty())
+        return;
+
+    session->scheduleWrite(pendingWriteTasks);
+    pendingWriteTasks.clear();
+    pendingWriteSize = 0;
 }
 
 void ServerSessionHandler::sendSignalAvailable(const SignalNumericIdType& signalNumericId,
@@ -55,7 +121,7 @@ void ServerSessionHandler::sendSignalAvailable(const SignalNumericIdType& signal
     auto writeHeaderTask = createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_SIGNAL_AVAILABLE, payloadSize);
     tasks.insert(tasks.begin(), writeHeaderTask);
 
-    session->scheduleWrite(tasks);
+    scheduleWrite(tasks);
 }
 
 void ServerSessionHandler::sendSignalUnavailable(const SignalNumericIdType& signalNumericId,
@@ -74,7 +140,7 @@ void ServerSessionHandler::sendSignalUnavailable(const SignalNumericIdType& sign
     auto writeHeaderTask = createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_SIGNAL_UNAVAILABLE, payloadSize);
     tasks.insert(tasks.begin(), writeHeaderTask);
 
-    session->scheduleWrite(tasks);
+    scheduleWrite(tasks);
 }
 
 void ServerSessionHandler::sendInitializationDone()
@@ -83,11 +149,21 @@ void ServerSessionHandler::sendInitializationDone()
 
     tasks.push_back(createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_PROTOCOL_INIT_DONE, 0));
 
-    session->scheduleWrite(tasks);
+    scheduleWrite(tasks);
 }
 
 void ServerSessionHandler::sendPacket(const SignalNumericIdType signalId, const PacketPtr& packet)
 {
+    queuePacket(signalId, packet);
+    completeSendCycle();
+}
+
+void ServerSessionHandler::queuePacket(const SignalNumericIdType signalId, const PacketPtr& packet)
+{
+    std::scoped_lock lock(sendSync);
+    if (!admitPacket(signalId, packet))
+        return;
+
     packetStreamingServer.addDaqPacket(signalId, packet);
     while (const auto packetBuffer = packetStreamingServer.getNextPacketBuffer())
     {
@@ -95,6 +171,287 @@ void ServerSessionHandler::sendPacket(const SignalNumericIdType signalId, const
     }
 }
 
+void ServerSessionHandler::queuePacket(const SignalNumericIdType signalId,
+                                       const PacketPtr& packet,
+                                       packet_streaming::SharedPacketEncoding& sharedEncoding)
+{
+    std::scoped_lock lock(sendSync);
+    if (!admitPacket(signalId, packet))
+        return;
+
+    packetStreamingServer.addDaqPacket(signalId, packet, sharedEncoding);
+    while (const auto packetBuffer = packetStreamingServer.getNextPacketBuffer())
+    {
+        sendPacketBuffer(packetBuffer);
+    }
+}
+
+void ServerSessionHandler::setSendQueueLimits(const SendQueueLimits& limits)
+{
+    sendQueueLimits = limits;
+}
+
+SendQueueStatistics ServerSessionHandler::getSendQueueStatistics() const
+{
+    return {sendQueueCounters->queuedBytes, sendQueueCounters->queuedPackets, sendQueueCounters->droppedPackets};
+}
+
+void ServerSessionHandler::setSendThreadIndex(size_t index)
+{
+    sendThreadIndex = index;
+}
+
+size_t ServerSessionHandler::getSendThreadIndex() const
+{
+    return sendThreadIndex;
+}
+
+bool ServerSessionHandler::markInitialSignalsSent()
+{
+    return !initialSignalsSent.exchange(true);
+}
+
+bool ServerSessionHandler::getInitialSignalsSent() const
+{
+    return initialSignalsSent;
+}
+
+bool ServerSessionHandler::updateSendQueueOverLimit()
+{
+    const size_t queuedBytes = sendQueueCounters->queuedBytes;
+    const size_t queuedPackets = sendQueueCounters->queuedPackets;
+    const auto& limits = sendQueueLimits;
+
+    if (!sendQueueOverLimit)
+    {
+        sendQueueOverLimit = (limits.maxBytes > 0 && queuedBytes > limits.maxBytes) ||
+                             (limits.maxPackets > 0 && queuedPackets > limits.maxPackets);
+        if (sendQueueOverLimit)
+        {
+            droppedPacketsAtLimit = sendQueueCounters->droppedPackets;
+            LOG_W("Send queue limit exceeded with {} bytes in {} packets queued, client is not keeping up",
+                  queuedBytes,
+                  queuedPackets);
+        }
+    }
+    else
+    {
+        sendQueueOverLimit = (limits.maxBytes > 0 && queuedBytes > limits.maxBytes / 2) ||
+                             (limits.maxPackets > 0 && queuedPackets > limits.maxPackets / 2);
+        if (!sendQueueOverLimit)
+            LOG_I("Send queue drained, {} data packets dropped", sendQueueCounters->droppedPackets - droppedPacketsAtLimit);
+    }
+
+    return sendQueueOverLimit;
+}
+
+bool ServerSessionHandler::admitPacket(SignalNumericIdType signalId, const PacketPtr& packet)
+{
+    // event packets are never dropped, the client could not interpret the following data otherwise
+    if (packet.getType() != daq::PacketType::Data)
+        return true;
+    if (sendQueueLimits.maxBytes == 0 && sendQueueLimits.maxPackets == 0)
+        return true;
+
+    const DataPacketPtr dataPacket = packet;
+    const auto domainPacket = dataPacket.getDomainPacket();
+
+    // the client cannot reconstruct a value packet without its domain packet, and waits for a domain packet
+    // referenced by a value packet it received, so both are sent or dropped together
+    const auto packetId = domainPacket.assigned() ? domainPacket.getPacketId() : dataPacket.getPacketId();
+    if (admitDataPacket(signalId, packetId))
+        return true;
+
+    sendQueueCounters->droppedPackets++;
+    return false;
+}
+
+bool ServerSessionHandler::admitDataPacket(SignalNumericIdType signalId, Int packetId)
+{
+    constexpr size_t maxTrackedDecisions = 1024;
+
+    // packets of several signals are queued concurrently, a value packet can be queued before its domain packet
+    if (const auto it = admissionDecisions.find(packetId); it != admissionDecisions.end())
+        return it->second;
+
+    const bool admitted = decideAdmission(signalId);
+    admissionDecisions.insert({packetId, admitted});
+    admissionDecisionsOrder.push_back(packetId);
+    if (admissionDecisionsOrder.size() > maxTrackedDecisions)
+    {
+        admissionDecisions.erase(admissionDecisionsOrder.front());
+        admissionDecisionsOrder.pop_front();
+    }
+    return admitted;
+}
+
+bool ServerSessionHandler::decideAdmission(SignalNumericIdType signalId)
+{
+    if (!updateSendQueueOverLimit())
+        return true;
+
+    switch (sendQueueLimits.policy)
+    {
+        case SlowConsumerPolicy::Disconnect:
+            if (!disconnectRequested)
+            {
+                disconnectRequested = true;
+                // posted, the error handler releases the session and must not run within the send cycle
+                boost::asio::post(flushTimer->get_executor(),
+                                  [errorHandler = errorHandler, session = session]()
+                                  {
+                                      errorHandler("Send queue limit exceeded", session);
+                                  });
+            }
+            return false;
+        case SlowConsumerPolicy::Downsample:
+        {
+            const size_t factor = std::max<size_t>(sendQueueLimits.downsampleFactor, 1);
+            return downsampleCounters[signalId]++ % factor == 0;
+        }
+        case SlowConsumerPolicy::DropData:
+            break;
+    }
+
+    return false;
+}
+
+void ServerSessionHandler::setEventPacketVersion(uint8_t version)
+{
+    packetStreamingServer.setEventPacketVersion(version);
+}
+
+void ServerSessionHandler::setPayloadCompression(bool enabled)
+{
+    packetStreamingServer.setPayloadEncoding(enabled);
+}
+
+void ServerSessionHandler::offerSharedMemoryTransport(size_t ringCapacity)
+{
+    SharedMemoryRingPtr ring;
+    try
+    {
+        ring = SharedMemoryRing::create(ringCapacity);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Shared memory transport not offered: {}", e.what());
+        return;
+    }
+
+    {
+        std::scoped_lock lock(pendingWritesSync);
+        offeredSharedMemoryRing = ring;
+    }
+
+    std::vector<WriteTask> tasks;
+    tasks.push_back(createWriteNumberTask<uint64_t>(ring->getCapacity()));
+    tasks.push_back(createWriteNumberTask<uint64_t>(ring->getToken()));
+    tasks.push_back(createWriteStringTask(ring->getName()));
+
+    // create write task for transport header
+    size_t payloadSize = calculatePayloadSize(tasks);
+    auto writeHeaderTask = createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT, payloadSize);
+    tasks.insert(tasks.begin(), writeHeaderTask);
+
+    scheduleWrite(tasks);
+}
+
+ReadTask ServerSessionHandler::readSharedMemoryTransportReply(const void* data, size_t size)
+{
+    size_t bytesDone = 0;
+    uint8_t accepted;
+
+    try
+    {
+        copyData(&accepted, data, sizeof(accepted), bytesDone, size);
+    }
+    catch (const DaqException& e)
+    {
+        LOG_E("Protocol error: {}", e.what());
+        errorHandler(std::string("Protocol error - readSharedMemoryTransportReply - ") + e.what(), session);
+        return createReadStopTask();
+    }
+
+    std::scoped_lock lock(pendingWritesSync);
+    if (accepted && offeredSharedMemoryRing)
+    {
+        // the client has the ring mapped, so the name is not needed anymore
+        offeredSharedMemoryRing->unlink();
+        sharedMemoryRing = std::move(offeredSharedMemoryRing);
+        LOG_I("Shared memory transport enabled, ring size {} bytes", sharedMemoryRing->getCapacity());
+    }
+    else
+    {
+        offeredSharedMemoryRing.reset();
+        LOG_I("Shared memory transport declined by client");
+    }
+
+    return createReadHeaderTask();
+}
+
+void ServerSessionHandler::completeSendCycle()
+{
+    std::scoped_lock lock(pendingWritesSync);
+
+    if (flushDelay.count() == 0)
+    {
+        flushPendingWritesInternal();
+        return;
+    }
+
+    if (pendingWriteTasks.empty() || flushTimerArmed)
+        return;
+
+    // packets of following send cycles are added to the same batch until the flush deadline expires
+    flushTimerArmed = true;
+    flushTimer->expires_from_now(flushDelay);
+    flushTimer->async_wait(
+        [weakSelf = weak_from_this()](const boost::system::error_code& ec)
+        {
+            if (ec)
+                return;
+            if (auto self = weakSelf.lock())
+            {
+                std::scoped_lock lock(self->pendingWritesSync);
+                self->flushTimerArmed = false;
+                self->flushPendingWritesInternal();
+            }
+        });
+}
+
+void ServerSessionHandler::startReleaseTimer()
+{
+    // the release delay is otherwise only checked when a packet is added, so packets released after
+    // the last packet of a signal was sent would be held by the client until the next one arrives
+    releaseTimer->expires_from_now(RELEASE_MAX_DELAY);
+    releaseTimer->async_wait(
+        [weakSelf = weak_from_this()](const boost::system::error_code& ec)
+        {
+            if (ec)
+                return;
+            auto self = weakSelf.lock();
+            if (!self || !self->session->isOpen())
+                return;
+
+            self->checkReleasedPackets();
+            self->startReleaseTimer();
+        });
+}
+
+void ServerSessionHandler::checkReleasedPackets()
+{
+    {
+        std::scoped_lock lock(sendSync);
+        packetStreamingServer.checkAndSendReleasePacket(false);
+        while (const auto packetBuffer = packetStreamingServer.getNextPacketBuffer())
+        {
+            sendPacketBuffer(packetBuffer);
+        }
+    }
+    completeSendCycle();
+}
+
 void ServerSessionHandler::sendSubscribingDone(const SignalNumericIdType signalNumericId)
 {
     std::vector<WriteTask> tasks;
@@ -107,7 +464,7 @@ void ServerSessionHandler::sendSubscribingDone(const SignalNumericIdType signalN
     auto writeHeaderTask = createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_SIGNAL_SUBSCRIBE_ACK, payloadSize);
     tasks.insert(tasks.begin(), writeHeaderTask);
 
-    session->scheduleWrite(tasks);
+    scheduleWrite(tasks);
 }
 
 void ServerSessionHandler::sendUnsubscribingDone(const SignalNumericIdType signalNumericId)
@@ -122,18 +479,59 @@ void ServerSessionHandler::sendUnsubscribingDone(const SignalNumericIdType signa
     auto writeHeaderTask = createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_SIGNAL_UNSUBSCRIBE_ACK, payloadSize);
     tasks.insert(tasks.begin(), writeHeaderTask);
 
-    session->scheduleWrite(tasks);
+    scheduleWrite(tasks);
 }
 
 void ServerSessionHandler::sendPacketBuffer(const PacketBufferPtr& packetBuffer)
 {
-    std::vector<WriteTask> tasks;
+    const size_t payloadSize = packetBuffer->packetHeader->size + packetBuffer->packetHeader->payloadSize;
+    if (payloadSize > TransportHeader::MAX_PAYLOAD_SIZE)
+        throw NativeStreamingProtocolException("Size of message payload exceeds limit");
+
+    std::scoped_lock lock(pendingWritesSync);
+
+    // the counters are decreased once the session has written and released the write tasks of the packet
+    sendQueueCounters->queuedBytes += payloadSize;
+    sendQueueCounters->queuedPackets++;
+    std::shared_ptr<void> queuedPacketToken(nullptr,
+                                            [counters = sendQueueCounters, payloadSize](void*)
+                                            {
+                                                counters->queuedBytes -= payloadSize;
+                                                counters->queuedPackets--;
+                                            });
+
+    if (sharedMemoryRing &&
+        packetBuffer->packetHeader->type == PacketType::data &&
+        packetBuffer->packetHeader->payloadSize >= SHARED_MEMORY_MIN_PAYLOAD_SIZE)
+    {
+        // only the packet header and the position of the payload in the ring are sent over the socket,
+        // packets that do not fit into the ring at the moment are sent inline
+        uint64_t ringPosition;
+        if (sharedMemoryRing->tryWrite(packetBuffer->payload, packetBuffer->packetHeader->payloadSize, ringPosition))
+        {
+            const size_t sharedMemoryPayloadSize = packetBuffer->packetHeader->size + sizeof(ringPosition);
+            pendingWriteTasks.push_back(
+                createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_PACKET_SHARED_MEMORY, sharedMemoryPayloadSize));
+
+            boost::asio::const_buffer packetBufferHeader(packetBuffer->packetHeader, packetBuffer->packetHeader->size);
+            pendingWriteTasks.push_back(WriteTask(packetBufferHeader, [packetBuffer, queuedPacketToken]() {}));
+            pendingWriteTasks.push_back(createWriteNumberTask<uint64_t>(ringPosition));
+
+            pendingWriteSize += TransportHeader::PACKED_HEADER_SIZE + sharedMemoryPayloadSize;
+            if (maxBatchSize > 0 && pendingWriteSize >= maxBatchSize)
+                flushPendingWritesInternal();
+            return;
+        }
+    }
+
+    // create write task for transport header
+    pendingWriteTasks.push_back(createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_PACKET, payloadSize));
 
     // create write task for packet buffer header
     boost::asio::const_buffer packetBufferHeader(packetBuffer->packetHeader,
                                             packetBuffer->packetHeader->size);
-    WriteHandler packetBufferHeaderHandler = [packetBuffer]() {};
-    tasks.push_back(WriteTask(packetBufferHeader, packetBufferHeaderHandler));
+    WriteHandler packetBufferHeaderHandler = [packetBuffer, queuedPacketToken]() {};
+    pendingWriteTasks.push_back(WriteTask(packetBufferHeader, packetBufferHeaderHandler));
 
     if (packetBuffer->packetHeader->payloadSize > 0)
     {
@@ -141,15 +539,12 @@ void ServerSessionHandler::sendPacketBuffer(const PacketBufferPtr& packetBuffer)
         boost::asio::const_buffer packetBufferPayload(packetBuffer->payload,
                                                      packetBuffer->packetHeader->payloadSize);
         WriteHandler packetBufferPayloadHandler = [packetBuffer]() {};
-        tasks.push_back(WriteTask(packetBufferPayload, packetBufferPayloadHandler));
+        pendingWriteTasks.push_back(WriteTask(packetBufferPayload, packetBufferPayloadHandler));
     }
 
-    // create write task for transport header
-    size_t payloadSize = calculatePayloadSize(tasks);
-    auto writeHeaderTask = createWriteHeaderTask(PayloadType::PAYLOAD_TYPE_STREAMING_PACKET, payloadSize);
-    tasks.insert(tasks.begin(), writeHeaderTask);
-
-    session->scheduleWrite(tasks);
+    pendingWriteSize += TransportHeader::PACKED_HEADER_SIZE + payloadSize;
+    if (maxBatchSize > 0 && pendingWriteSize >= maxBatchSize)
+        flushPendingWritesInternal();
 }
 
 ReadTask ServerSessionHandler::readSignalSubscribe(const void *data, size_t size)
@@ -297,6 +692,16 @@ ReadTask ServerSessionHandler::readHeader(const void* data, size_t size)
             payloadSize
         );
     }
+    else if (payloadType == PayloadType::PAYLOAD_TYPE_SHARED_MEMORY_TRANSPORT)
+    {
+        return ReadTask(
+            [this](const void* data, size_t size)
+            {
+                return readSharedMemoryTransportReply(data, size);
+            },
+            payloadSize
+        );
+    }
     else
     {
         LOG_W("Received type: {} cannot be handled by server side", convertPayloadTypeToString(payloadType));
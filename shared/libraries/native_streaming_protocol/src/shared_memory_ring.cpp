@@ -0,0 +1,213 @@
+#include <native_streaming_protocol/shared_memory_ring.h>
+#include <native_streaming_protocol/native_streaming_protocol_types.h>
+
+#include <cstring>
+#include <new>
+#include <random>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+BEGIN_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
+
+static constexpr uint64_t SHARED_MEMORY_RING_MAGIC = 0x474E4952534E5144; // "DQNSRING"
+static constexpr size_t SHARED_MEMORY_RING_DATA_OFFSET = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+
+bool SharedMemoryRing::isSupported()
+{
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+SharedMemoryRing::SharedMemoryRing(std::string name, size_t capacity, bool owner)
+    : name(std::move(name))
+    , capacity(capacity)
+    , owner(owner)
+    , mapping(nullptr)
+    , mappingSize(SHARED_MEMORY_RING_DATA_OFFSET + capacity)
+    , control(nullptr)
+    , data(nullptr)
+    , writePosition(0)
+{
+}
+
+SharedMemoryRingPtr SharedMemoryRing::create(size_t capacity)
+{
+#if defined(__linux__)
+    std::random_device randomDevice;
+    const uint64_t token = (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+    const auto name = "/opendaq_ns_" + std::to_string(getpid()) + "_" + std::to_string(token);
+
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+        throw NativeStreamingProtocolException("Failed to create shared memory ring: " + std::string(std::strerror(errno)));
+
+    SharedMemoryRingPtr ring(new SharedMemoryRing(name, capacity, true));
+    if (ftruncate(fd, static_cast<off_t>(ring->mappingSize)) != 0)
+    {
+        close(fd);
+        throw NativeStreamingProtocolException("Failed to size shared memory ring: " + std::string(std::strerror(errno)));
+    }
+
+    ring->map(fd);
+
+    ring->control->magic = SHARED_MEMORY_RING_MAGIC;
+    ring->control->token = token;
+    ring->control->capacity = capacity;
+    new (&ring->control->readPosition) std::atomic<uint64_t>(0);
+
+    return ring;
+#else
+    throw NativeStreamingProtocolException("Shared memory transport is not supported on this platform");
+#endif
+}
+
+SharedMemoryRingPtr SharedMemoryRing::open(const std::string& name, size_t capacity, uint64_t token)
+{
+#if defined(__linux__)
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        throw NativeStreamingProtocolException("Failed to open shared memory ring: " + std::string(std::strerror(errno)));
+
+    struct stat fileStat {};
+    SharedMemoryRingPtr ring(new SharedMemoryRing(name, capacity, false));
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) != ring->mappingSize)
+    {
+        close(fd);
+        throw NativeStreamingProtocolException("Shared memory ring size mismatch");
+    }
+
+    ring->map(fd);
+
+    if (ring->control->magic != SHARED_MEMORY_RING_MAGIC || ring->control->token != token || ring->control->capacity != capacity)
+        throw NativeStreamingProtocolException("Shared memory ring validation failed");
+
+    return ring;
+#else
+    throw NativeStreamingProtocolException("Shared memory transport is not supported on this platform");
+#endif
+}
+
+void SharedMemoryRing::map(int fd)
+{
+#if defined(__linux__)
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw NativeStreamingProtocolException("Failed to map shared memory ring: " + std::string(std::strerror(errno)));
+    }
+
+    control = static_cast<Control*>(mapping);
+    data = static_cast<uint8_t*>(mapping) + SHARED_MEMORY_RING_DATA_OFFSET;
+#endif
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+#if defined(__linux__)
+    if (mapping != nullptr)
+        munmap(mapping, mappingSize);
+    unlink();
+#endif
+}
+
+const std::string& SharedMemoryRing::getName() const
+{
+    return name;
+}
+
+size_t SharedMemoryRing::getCapacity() const
+{
+    return capacity;
+}
+
+uint64_t SharedMemoryRing::getToken() const
+{
+    return control->token;
+}
+
+void SharedMemoryRing::unlink()
+{
+#if defined(__linux__)
+    if (owner)
+    {
+        shm_unlink(name.c_str());
+        owner = false;
+    }
+#endif
+}
+
+bool SharedMemoryRing::tryWrite(const void* source, size_t size, uint64_t& position)
+{
+    if (size == 0 || size > capacity)
+        return false;
+
+    // payloads are never split, the tail of the ring is skipped if the payload does not fit
+    uint64_t start = writePosition;
+    const auto offset = static_cast<size_t>(start % capacity);
+    if (offset + size > capacity)
+        start += capacity - offset;
+
+    const uint64_t end = start + size;
+    if (end - control->readPosition.load(std::memory_order_acquire) > capacity)
+        return false;
+
+    std::memcpy(data + (start % capacity), source, size);
+    writePosition = end;
+    position = start;
+    return true;
+}
+
+const void* SharedMemoryRing::acquire(uint64_t position, size_t size)
+{
+    if (size > capacity || (position % capacity) + size > capacity)
+        throw NativeStreamingProtocolException("Invalid shared memory ring position");
+
+    std::scoped_lock lock(acquiredSlotsSync);
+    if (!acquiredSlots.empty() && position < acquiredSlots.back().end)
+        throw NativeStreamingProtocolException("Shared memory ring slot acquired out of order");
+
+    acquiredSlots.push_back({position, position + size, false});
+    return data + (position % capacity);
+}
+
+void SharedMemoryRing::release(uint64_t position)
+{
+    std::scoped_lock lock(acquiredSlotsSync);
+
+    for (auto& slot : acquiredSlots)
+    {
+        if (slot.position == position && !slot.released)
+        {
+            slot.released = true;
+            break;
+        }
+    }
+
+    // the producer may only reuse memory up to the first slot still referenced by the consumer
+    uint64_t readPosition = 0;
+    bool advanced = false;
+    while (!acquiredSlots.empty() && acquiredSlots.front().released)
+    {
+        readPosition = acquiredSlots.front().end;
+        acquiredSlots.pop_front();
+        advanced = true;
+    }
+
+    if (advanced)
+        control->readPosition.store(readPosition, std::memory_order_release);
+}
+
+END_NAMESPACE_OPENDAQ_NATIVE_STREAMING_PROTOCOL
@@ -26,21 +26,37 @@ void SubscribersRegistry::sendToClients(SendToClientCallback sendCallback)
 
 void SubscribersRegistry::sendToSubscribers(const SignalPtr& signal, SendToClientCallback sendCallback)
 {
-    auto signalKey = signal.getGlobalId().toStdString();
-    auto iter = signalsSubscribers.find(signalKey);
-    if (iter != signalsSubscribers.end())
+    sendToSubscribers(getSignalHandle(signal), sendCallback);
+}
+
+void SubscribersRegistry::sendToSubscribers(const SignalHandlePtr& signalHandle, const SendToClientCallback& sendCallback)
+{
+    std::scoped_lock lock(sync);
+    for (auto& sessionHandler : signalHandle->subscribers)
+    {
+        sendCallback(sessionHandler);
+    }
+}
+
+void SubscribersRegistry::sendToSubscriberList(const SignalHandlePtr& signalHandle, const SendToSubscriberListCallback& sendCallback)
+{
+    // packets of different signals are sent concurrently, the session handlers serialize access to their own queues
+    std::vector<std::shared_ptr<ServerSessionHandler>> subscribers;
     {
-        auto& subscribers = iter->second;
         std::scoped_lock lock(sync);
-        for (auto& sessionHandler : subscribers)
-        {
-            sendCallback(sessionHandler);
-        }
+        subscribers = signalHandle->subscribers;
     }
+    sendCallback(subscribers);
+}
+
+SignalHandlePtr SubscribersRegistry::getSignalHandle(const SignalPtr& signal)
+{
+    auto signalKey = signal.getGlobalId().toStdString();
+    auto iter = signalsSubscribers.find(signalKey);
+    if (iter != signalsSubscribers.end())
+        return iter->second;
     else
-    {
         throw NativeStreamingProtocolException("Signal is not registered");
-    }
 }
 
 void SubscribersRegistry::sendToClient(SessionPtr session, SendToClientCallback sendCallback)
@@ -62,13 +78,15 @@ void SubscribersRegistry::sendToClient(SessionPtr session, SendToClientCallback
     }
 }
 
-void SubscribersRegistry::registerSignal(const SignalPtr& signal)
+void SubscribersRegistry::registerSignal(const SignalPtr& signal, SignalNumericIdType signalNumericId)
 {
     auto signalKey = signal.getGlobalId().toStdString();
     auto iter = signalsSubscribers.find(signalKey);
     if (iter == signalsSubscribers.end())
     {
-        signalsSubscribers.insert({signalKey, std::vector<std::shared_ptr<ServerSessionHandler>>()});
+        auto signalHandle = std::make_shared<SignalHandle>();
+        signalHandle->signalNumericId = signalNumericId;
+        signalsSubscribers.insert({signalKey, signalHandle});
     }
     else
     {
@@ -84,9 +102,11 @@ bool SubscribersRegistry::removeSignal(const SignalPtr& signal)
     if (signalIter != signalsSubscribers.end())
     {
         std::scoped_lock lock(sync);
-        auto& subscribers = signalIter->second;
+        auto& subscribers = signalIter->second->subscribers;
         if (!subscribers.empty())
             doSignalUnsubscribe = true;
+        // handles cached by the packet senders remain valid, but no longer reach any client
+        subscribers.clear();
         signalsSubscribers.erase(signalIter);
     }
     else
@@ -110,7 +130,7 @@ std::vector<std::string> SubscribersRegistry::unregisterClient(SessionPtr sessio
     for (auto& signalIter : signalsSubscribers)
     {
         std::scoped_lock lock(sync);
-        auto& subscribers = signalIter.second;
+        auto& subscribers = signalIter.second->subscribers;
         auto subscriberIter = std::find_if(subscribers.begin(),
                                            subscribers.end(),
                                            [&session](std::shared_ptr<ServerSessionHandler>& handler)
@@ -148,7 +168,7 @@ bool SubscribersRegistry::registerSignalSubscriber(const std::string& signalStri
     if (iter != signalsSubscribers.end())
     {
         std::scoped_lock lock(sync);
-        auto& subscribers = iter->second;
+        auto& subscribers = iter->second->subscribers;
         auto subscribersIter = std::find_if(subscribers.begin(),
                                             subscribers.end(),
                                             [&session](std::shared_ptr<ServerSessionHandler>& handler)
@@ -190,7 +210,7 @@ bool SubscribersRegistry::removeSignalSubscriber(const std::string& signalString
     if (iter != signalsSubscribers.end())
     {
         std::scoped_lock lock(sync);
-        auto& subscribers = iter->second;
+        auto& subscribers = iter->second->subscribers;
         auto subscribersIter = std::find_if(subscribers.begin(),
                                             subscribers.end(),
                                             [&session](std::shared_ptr<ServerSessionHandler>& handler)
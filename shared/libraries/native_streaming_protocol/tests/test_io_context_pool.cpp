@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <native_streaming_protocol/io_context_pool.h>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace daq;
+using namespace daq::opendaq_native_streaming_protocol;
+
+using IoContextPoolTest = testing::Test;
+
+TEST_F(IoContextPoolTest, WorkKeepsOrderPerIndex)
+{
+    IoContextPool pool(2);
+    ASSERT_EQ(pool.size(), 2u);
+
+    std::vector<int> executed;
+    std::promise<void> done;
+    for (int i = 0; i < 100; ++i)
+        pool.post(1, [&executed, i]() { executed.push_back(i); });
+    pool.post(1, [&done]() { done.set_value(); });
+
+    done.get_future().wait();
+    ASSERT_EQ(executed.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+        ASSERT_EQ(executed[i], i);
+}
+
+TEST_F(IoContextPoolTest, IndicesRunOnSeparateThreads)
+{
+    IoContextPool pool(2);
+
+    std::promise<std::thread::id> first;
+    std::promise<std::thread::id> second;
+    pool.post(0, [&first]() { first.set_value(std::this_thread::get_id()); });
+    pool.post(1, [&second]() { second.set_value(std::this_thread::get_id()); });
+
+    const auto firstId = first.get_future().get();
+    const auto secondId = second.get_future().get();
+    ASSERT_NE(firstId, secondId);
+    ASSERT_NE(firstId, std::this_thread::get_id());
+}
+
+TEST_F(IoContextPoolTest, Stop)
+{
+    IoContextPool pool(3);
+    ASSERT_NO_THROW(pool.stop());
+    ASSERT_NO_THROW(pool.stop());
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <native_streaming_protocol/shared_memory_ring.h>
+#include <native_streaming_protocol/native_streaming_protocol_types.h>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+using namespace daq;
+using namespace daq::opendaq_native_streaming_protocol;
+
+class SharedMemoryRingTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        if (!SharedMemoryRing::isSupported())
+            GTEST_SKIP() << "Shared memory transport is not supported on this platform";
+    }
+};
+
+TEST_F(SharedMemoryRingTest, WriteRead)
+{
+    auto producer = SharedMemoryRing::create(4096);
+    auto consumer = SharedMemoryRing::open(producer->getName(), producer->getCapacity(), producer->getToken());
+
+    std::vector<uint8_t> payload(1000);
+    std::iota(payload.begin(), payload.end(), 0);
+
+    uint64_t position;
+    ASSERT_TRUE(producer->tryWrite(payload.data(), payload.size(), position));
+    ASSERT_EQ(std::memcmp(consumer->acquire(position, payload.size()), payload.data(), payload.size()), 0);
+    consumer->release(position);
+}
+
+TEST_F(SharedMemoryRingTest, FullAndWrapAround)
+{
+    auto producer = SharedMemoryRing::create(4096);
+    auto consumer = SharedMemoryRing::open(producer->getName(), producer->getCapacity(), producer->getToken());
+
+    std::vector<uint8_t> payload(1500, 0xAB);
+
+    uint64_t first, second, third;
+    ASSERT_TRUE(producer->tryWrite(payload.data(), payload.size(), first));
+    ASSERT_TRUE(producer->tryWrite(payload.data(), payload.size(), second));
+    ASSERT_FALSE(producer->tryWrite(payload.data(), payload.size(), third));
+
+    // the payload does not fit at the tail, it is placed at the start of the ring once released
+    consumer->acquire(first, payload.size());
+    consumer->release(first);
+    ASSERT_TRUE(producer->tryWrite(payload.data(), payload.size(), third));
+    ASSERT_EQ(third % producer->getCapacity(), 0u);
+    ASSERT_EQ(std::memcmp(consumer->acquire(third, payload.size()), payload.data(), payload.size()), 0);
+}
+
+TEST_F(SharedMemoryRingTest, ReleaseOutOfOrder)
+{
+    auto producer = SharedMemoryRing::create(4096);
+    auto consumer = SharedMemoryRing::open(producer->getName(), producer->getCapacity(), producer->getToken());
+
+    std::vector<uint8_t> payload(1500, 0xCD);
+
+    uint64_t first, second, third;
+    ASSERT_TRUE(producer->tryWrite(payload.data(), payload.size(), first));
+    ASSERT_TRUE(producer->tryWrite(payload.data(), payload.size(), second));
+    consumer->acquire(first, payload.size());
+    consumer->acquire(second, payload.size());
+
+    // the first slot is still referenced, so releasing the second one does not free any memory
+    consumer->release(second);
+    ASSERT_FALSE(producer->tryWrite(payload.data(), payload.size(), third));
+
+    consumer->release(first);
+    ASSERT_TRUE(producer->tryWrite(payload.data(), payload.size(), third));
+}
+
+TEST_F(SharedMemoryRingTest, TokenMismatch)
+{
+    auto producer = SharedMemoryRing::create(4096);
+    ASSERT_THROW(SharedMemoryRing::open(producer->getName(), producer->getCapacity(), producer->getToken() + 1),
+                 NativeStreamingProtocolException);
+}
+
+TEST_F(SharedMemoryRingTest, OpenAfterUnlink)
+{
+    auto producer = SharedMemoryRing::create(4096);
+    producer->unlink();
+    ASSERT_THROW(SharedMemoryRing::open(producer->getName(), producer->getCapacity(), producer->getToken()),
+                 NativeStreamingProtocolException);
+}
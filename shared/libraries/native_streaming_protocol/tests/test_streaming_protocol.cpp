@@ -4,9 +4,12 @@
 #include <opendaq/opendaq.h>
 #include <opendaq/deserialize_component_ptr.h>
 #include <opendaq/component_deserialize_context_factory.h>
+#include <native_streaming_protocol/shared_memory_ring.h>
 
 #include <memory>
 #include <future>
+#include <condition_variable>
+#include <algorithm>
 
 using namespace daq;
 using namespace daq::opendaq_native_streaming_protocol;
@@ -177,10 +180,14 @@ public:
     }
 
     std::shared_ptr<NativeStreamingClientHandler> createClient(StreamingProtocolAttributes& client,
-                                                               OnSignalAvailableCallback signalAvailableHandler)
+                                                               OnSignalAvailableCallback signalAvailableHandler,
+                                                               PropertyObjectPtr transportLayerConfig = nullptr)
     {
+        if (!transportLayerConfig.assigned())
+            transportLayerConfig = ClientAttributesBase::createTransportLayerConfig();
+
         auto clientHandler = std::make_shared<NativeStreamingClientHandler>(
-            client.clientContext, ClientAttributesBase::createTransportLayerConfig());
+            client.clientContext, transportLayerConfig);
 
         clientHandler->setIoContext(client.ioContextPtrClient);
         clientHandler->setSignalAvailableHandler(signalAvailableHandler);
@@ -192,7 +199,7 @@ public:
         return clientHandler;
     }
 
-    void startServer(const ListPtr<ISignal>& signalsList)
+    void startServer(const ListPtr<ISignal>& signalsList, size_t sendThreadCount = 0, bool encodeOnSocketThread = false)
     {
         startIoOperations();
         serverHandler = std::make_shared<NativeStreamingServerHandler>(serverContext,
@@ -201,6 +208,8 @@ public:
                                                                        signalSubscribedHandler,
                                                                        signalUnsubscribedHandler,
                                                                        setUpConfigProtocolServerCb);
+        serverHandler->setSendThreadCount(sendThreadCount);
+        serverHandler->setEncodeOnSocketThread(encodeOnSocketThread);
         serverHandler->startServer(NATIVE_STREAMING_SERVER_PORT);
     }
 
@@ -515,6 +524,34 @@ TEST_P(StreamingProtocolTest, InitialEventPacket)
     }
 }
 
+TEST_P(StreamingProtocolTest, InitialEventPacketBinaryEncoding)
+{
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    auto initialEventPacket = DataDescriptorChangedEventPacket(valueDescriptor, nullptr);
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+
+    startServer(List<ISignal>(serverSignal));
+
+    for (auto& client : clients)
+    {
+        auto transportLayerConfig = ClientAttributesBase::createTransportLayerConfig();
+        transportLayerConfig.addProperty(IntProperty("EventPacketVersion", PACKET_EVENT_VERSION_BINARY));
+
+        client.clientHandler = createClient(client, client.signalAvailableHandler, transportLayerConfig);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        auto [signalId, packet] = client.packetReceivedFuture.get();
+        ASSERT_EQ(signalId, serverSignal.getGlobalId());
+        ASSERT_EQ(packet, initialEventPacket);
+
+        // the event packet sent on connection already uses the encoding requested by the client
+        const auto statistics = client.clientHandler->getEventPacketStatistics();
+        ASSERT_EQ(statistics.jsonEncodedPackets, 0u);
+        ASSERT_EQ(statistics.binaryEncodedPackets, 1u);
+    }
+}
+
 TEST_P(StreamingProtocolTest, SendEventPacket)
 {
     const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
@@ -630,6 +667,378 @@ TEST_P(StreamingProtocolTest, SendDataPacket)
     }
 }
 
+TEST_P(StreamingProtocolTest, SendDataPacketUsingSignalHandle)
+{
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    auto serverDataPacket = DataPacket(valueDescriptor, 100);
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+
+    startServer(List<ISignal>(serverSignal));
+
+    // handle is resolved before any client subscribes
+    auto signalHandle = serverHandler->getSignalHandle(serverSignal);
+    ASSERT_TRUE(signalHandle);
+
+    for (auto& client : clients)
+    {
+        client.clientHandler = createClient(client, client.signalAvailableHandler);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        ASSERT_EQ(client.signalAvailableFuture.wait_for(timeout), std::future_status::ready);
+        auto [clientSignalStringId, serializedSignal] =
+            client.signalAvailableFuture.get();
+
+        // wait for initial event packet
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        // reset packet future / promise
+        client.packetReceivedPromise = std::promise< std::tuple<StringPtr, PacketPtr> >();
+        client.packetReceivedFuture = client.packetReceivedPromise.get_future();
+
+        client.clientHandler->subscribeSignal(clientSignalStringId);
+        ASSERT_EQ(client.subscribedAckFuture.wait_for(timeout), std::future_status::ready);
+    }
+
+    ASSERT_EQ(signalSubscribedFuture.wait_for(timeout), std::future_status::ready);
+
+    serverHandler->sendPacket(signalHandle, serverDataPacket);
+
+    for (auto& client : clients)
+    {
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        auto [signalId, packet] = client.packetReceivedFuture.get();
+        ASSERT_EQ(signalId, serverSignal.getGlobalId());
+        ASSERT_EQ(packet, serverDataPacket);
+    }
+}
+
+TEST_P(StreamingProtocolTest, SendDataPacketsBatched)
+{
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    auto serverDataPacket = DataPacket(valueDescriptor, 100);
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+
+    startServer(List<ISignal>(serverSignal));
+    serverHandler->setWriteBatchingParams(65536, std::chrono::milliseconds(10));
+
+    for (auto& client : clients)
+    {
+        client.clientHandler = createClient(client, client.signalAvailableHandler);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        ASSERT_EQ(client.signalAvailableFuture.wait_for(timeout), std::future_status::ready);
+        auto [clientSignalStringId, serializedSignal] =
+            client.signalAvailableFuture.get();
+
+        // wait for initial event packet
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        // reset packet future / promise
+        client.packetReceivedPromise = std::promise< std::tuple<StringPtr, PacketPtr> >();
+        client.packetReceivedFuture = client.packetReceivedPromise.get_future();
+
+        client.clientHandler->subscribeSignal(clientSignalStringId);
+        ASSERT_EQ(client.subscribedAckFuture.wait_for(timeout), std::future_status::ready);
+    }
+
+    ASSERT_EQ(signalSubscribedFuture.wait_for(timeout), std::future_status::ready);
+
+    // packet stays in the batch until the flush delay expires
+    serverHandler->sendPackets(serverHandler->getSignalHandle(serverSignal), List<IPacket>(serverDataPacket));
+
+    for (auto& client : clients)
+    {
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        auto [signalId, packet] = client.packetReceivedFuture.get();
+        ASSERT_EQ(signalId, serverSignal.getGlobalId());
+        ASSERT_EQ(packet, serverDataPacket);
+    }
+}
+
+TEST_P(StreamingProtocolTest, SendDataPacketOnSendThreads)
+{
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    auto serverDataPacket = DataPacket(valueDescriptor, 100);
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+
+    startServer(List<ISignal>(serverSignal), 2);
+
+    for (auto& client : clients)
+    {
+        client.clientHandler = createClient(client, client.signalAvailableHandler);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        ASSERT_EQ(client.signalAvailableFuture.wait_for(timeout), std::future_status::ready);
+        auto [clientSignalStringId, serializedSignal] =
+            client.signalAvailableFuture.get();
+
+        // wait for initial event packet
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        // reset packet future / promise
+        client.packetReceivedPromise = std::promise< std::tuple<StringPtr, PacketPtr> >();
+        client.packetReceivedFuture = client.packetReceivedPromise.get_future();
+
+        client.clientHandler->subscribeSignal(clientSignalStringId);
+        ASSERT_EQ(client.subscribedAckFuture.wait_for(timeout), std::future_status::ready);
+    }
+
+    ASSERT_EQ(signalSubscribedFuture.wait_for(timeout), std::future_status::ready);
+
+    // sessions are spread evenly over the send threads when accepted
+    const auto sessionCounts = serverHandler->getSendThreadSessionCounts();
+    ASSERT_EQ(sessionCounts.size(), 2u);
+    ASSERT_EQ(sessionCounts[0] + sessionCounts[1], clients.size());
+    ASSERT_LE(std::max(sessionCounts[0], sessionCounts[1]) - std::min(sessionCounts[0], sessionCounts[1]), 1u);
+
+    serverHandler->sendPacket(serverSignal, serverDataPacket);
+
+    for (auto& client : clients)
+    {
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        auto [signalId, packet] = client.packetReceivedFuture.get();
+        ASSERT_EQ(signalId, serverSignal.getGlobalId());
+        ASSERT_EQ(packet, serverDataPacket);
+    }
+}
+
+TEST_P(StreamingProtocolTest, SendDataPacketOnSocketThread)
+{
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    auto serverDataPacket = DataPacket(valueDescriptor, 100);
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+
+    startServer(List<ISignal>(serverSignal), 2, true);
+
+    for (auto& client : clients)
+    {
+        client.clientHandler = createClient(client, client.signalAvailableHandler);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        ASSERT_EQ(client.signalAvailableFuture.wait_for(timeout), std::future_status::ready);
+        auto [clientSignalStringId, serializedSignal] =
+            client.signalAvailableFuture.get();
+
+        // wait for initial event packet
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        // reset packet future / promise
+        client.packetReceivedPromise = std::promise< std::tuple<StringPtr, PacketPtr> >();
+        client.packetReceivedFuture = client.packetReceivedPromise.get_future();
+
+        client.clientHandler->subscribeSignal(clientSignalStringId);
+        ASSERT_EQ(client.subscribedAckFuture.wait_for(timeout), std::future_status::ready);
+    }
+
+    ASSERT_EQ(signalSubscribedFuture.wait_for(timeout), std::future_status::ready);
+
+    // the send threads are not started when encoding on the socket thread
+    ASSERT_TRUE(serverHandler->getSendThreadSessionCounts().empty());
+
+    serverHandler->sendPacket(serverSignal, serverDataPacket);
+
+    for (auto& client : clients)
+    {
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        auto [signalId, packet] = client.packetReceivedFuture.get();
+        ASSERT_EQ(signalId, serverSignal.getGlobalId());
+        ASSERT_EQ(packet, serverDataPacket);
+    }
+}
+
+TEST_P(StreamingProtocolTest, SendQueueLimitDropsDataPackets)
+{
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    auto serverDataPacket = DataPacket(valueDescriptor, 100);
+    auto droppedDataPacket = DataPacket(valueDescriptor, 100);
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+
+    startServer(List<ISignal>(serverSignal));
+    // packets waiting in the batch count as queued, so the second one exceeds the limit
+    serverHandler->setWriteBatchingParams(65536, std::chrono::milliseconds(200));
+    SendQueueLimits limits;
+    limits.maxBytes = 100;
+    limits.policy = SlowConsumerPolicy::DropData;
+    serverHandler->setSendQueueLimits(limits);
+
+    for (auto& client : clients)
+    {
+        client.clientHandler = createClient(client, client.signalAvailableHandler);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        ASSERT_EQ(client.signalAvailableFuture.wait_for(timeout), std::future_status::ready);
+        auto [clientSignalStringId, serializedSignal] =
+            client.signalAvailableFuture.get();
+
+        // wait for initial event packet
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        // reset packet future / promise
+        client.packetReceivedPromise = std::promise< std::tuple<StringPtr, PacketPtr> >();
+        client.packetReceivedFuture = client.packetReceivedPromise.get_future();
+
+        client.clientHandler->subscribeSignal(clientSignalStringId);
+        ASSERT_EQ(client.subscribedAckFuture.wait_for(timeout), std::future_status::ready);
+    }
+
+    ASSERT_EQ(signalSubscribedFuture.wait_for(timeout), std::future_status::ready);
+
+    const auto signalHandle = serverHandler->getSignalHandle(serverSignal);
+    serverHandler->sendPackets(signalHandle, List<IPacket>(serverDataPacket));
+    serverHandler->sendPackets(signalHandle, List<IPacket>(droppedDataPacket));
+    ASSERT_EQ(serverHandler->getSendQueueStatistics().droppedPackets, clients.size());
+
+    for (auto& client : clients)
+    {
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        auto [signalId, packet] = client.packetReceivedFuture.get();
+        ASSERT_EQ(signalId, serverSignal.getGlobalId());
+        ASSERT_EQ(packet, serverDataPacket);
+    }
+}
+
+TEST_P(StreamingProtocolTest, SendQueueLimitKeepsDomainPacketsOfSentValuePackets)
+{
+    const auto domainDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int64).build();
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    auto serverDomainSignal = SignalWithDescriptor(serverContext, domainDescriptor, nullptr, "domainSignal");
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+    serverSignal.setDomainSignal(serverDomainSignal);
+
+    auto sentDomainPacket = DataPacket(domainDescriptor, 100);
+    auto sentValuePacket = DataPacketWithDomain(sentDomainPacket, valueDescriptor, 100);
+    auto droppedDomainPacket = DataPacket(domainDescriptor, 100);
+    auto droppedValuePacket = DataPacketWithDomain(droppedDomainPacket, valueDescriptor, 100);
+
+    struct ReceivedItems
+    {
+        std::mutex sync;
+        std::condition_variable cv;
+        std::vector<StringPtr> signalIds;
+        size_t subscribedCount{0};
+        std::vector<PacketPtr> dataPackets;
+    };
+    std::vector<std::shared_ptr<ReceivedItems>> receivedItems;
+
+    signalSubscribedHandler = [](const SignalPtr&) {};
+    startServer(List<ISignal>(serverDomainSignal, serverSignal));
+    // packets waiting in the batch count as queued, so the first value packet exceeds the limit
+    serverHandler->setWriteBatchingParams(65536, std::chrono::milliseconds(200));
+    SendQueueLimits limits;
+    limits.maxBytes = 100;
+    limits.policy = SlowConsumerPolicy::DropData;
+    serverHandler->setSendQueueLimits(limits);
+
+    for (auto& client : clients)
+    {
+        auto received = std::make_shared<ReceivedItems>();
+        receivedItems.push_back(received);
+
+        client.packetHandler = [received](const StringPtr&, const PacketPtr& packet)
+        {
+            if (packet.getType() != PacketType::Data)
+                return;
+            std::scoped_lock lock(received->sync);
+            received->dataPackets.push_back(packet);
+            received->cv.notify_all();
+        };
+        client.signalSubscriptionAckHandler = [received](const StringPtr&, bool subscribed)
+        {
+            std::scoped_lock lock(received->sync);
+            if (subscribed)
+                received->subscribedCount++;
+            received->cv.notify_all();
+        };
+        OnSignalAvailableCallback signalAvailableHandler = [received](const StringPtr& signalStringId, const StringPtr&)
+        {
+            std::scoped_lock lock(received->sync);
+            received->signalIds.push_back(signalStringId);
+            received->cv.notify_all();
+        };
+
+        client.clientHandler = createClient(client, signalAvailableHandler);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        std::vector<StringPtr> signalIds;
+        {
+            std::unique_lock lock(received->sync);
+            ASSERT_TRUE(received->cv.wait_for(lock, timeout, [&received] { return received->signalIds.size() == 2; }));
+            signalIds = received->signalIds;
+        }
+        for (const auto& signalId : signalIds)
+            client.clientHandler->subscribeSignal(signalId);
+
+        std::unique_lock lock(received->sync);
+        ASSERT_TRUE(received->cv.wait_for(lock, timeout, [&received] { return received->subscribedCount == 2; }));
+    }
+
+    // the value packets are queued before their domain packets, as with concurrently forwarded signals,
+    // the second pair is dropped as a whole once the queue is over the limit
+    const auto signalHandle = serverHandler->getSignalHandle(serverSignal);
+    const auto domainSignalHandle = serverHandler->getSignalHandle(serverDomainSignal);
+    serverHandler->sendPackets(signalHandle, List<IPacket>(sentValuePacket));
+    serverHandler->sendPackets(domainSignalHandle, List<IPacket>(sentDomainPacket));
+    serverHandler->sendPackets(signalHandle, List<IPacket>(droppedValuePacket));
+    serverHandler->sendPackets(domainSignalHandle, List<IPacket>(droppedDomainPacket));
+    ASSERT_EQ(serverHandler->getSendQueueStatistics().droppedPackets, 2 * clients.size());
+
+    // the client does not wait for a dropped domain packet, the sent value packet is completed
+    for (const auto& received : receivedItems)
+    {
+        std::unique_lock lock(received->sync);
+        ASSERT_TRUE(received->cv.wait_for(lock, timeout, [&received] { return received->dataPackets.size() == 2; }));
+        const auto& packets = received->dataPackets;
+        ASSERT_EQ(std::count(packets.begin(), packets.end(), sentDomainPacket), 1);
+        ASSERT_EQ(std::count(packets.begin(), packets.end(), sentValuePacket), 1);
+    }
+}
+
+TEST_P(StreamingProtocolTest, SendDataPacketSharedMemory)
+{
+    if (!SharedMemoryRing::isSupported())
+        GTEST_SKIP() << "Shared memory transport is not supported on this platform";
+
+    // payload is large enough to be placed in the shared memory ring
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float64).build();
+    auto serverDataPacket = DataPacket(valueDescriptor, 1000);
+    auto serverData = static_cast<double*>(serverDataPacket.getRawData());
+    for (size_t i = 0; i < 1000; ++i)
+        serverData[i] = static_cast<double>(i);
+    auto serverSignal = SignalWithDescriptor(serverContext, valueDescriptor, nullptr, "signal");
+
+    startServer(List<ISignal>(serverSignal));
+
+    for (auto& client : clients)
+    {
+        auto transportLayerConfig = ClientAttributesBase::createTransportLayerConfig();
+        transportLayerConfig.addProperty(BoolProperty("SharedMemoryTransport", True));
+
+        client.clientHandler = createClient(client, client.signalAvailableHandler, transportLayerConfig);
+        ASSERT_TRUE(client.clientHandler->connect(SERVER_ADDRESS, NATIVE_STREAMING_LISTENING_PORT));
+
+        ASSERT_EQ(client.signalAvailableFuture.wait_for(timeout), std::future_status::ready);
+        auto [clientSignalStringId, serializedSignal] =
+            client.signalAvailableFuture.get();
+
+        // wait for initial event packet
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        // reset packet future / promise
+        client.packetReceivedPromise = std::promise< std::tuple<StringPtr, PacketPtr> >();
+        client.packetReceivedFuture = client.packetReceivedPromise.get_future();
+
+        // the ring is negotiated right after the streaming init, ahead of the subscription
+        client.clientHandler->subscribeSignal(clientSignalStringId);
+        ASSERT_EQ(client.subscribedAckFuture.wait_for(timeout), std::future_status::ready);
+    }
+
+    ASSERT_EQ(signalSubscribedFuture.wait_for(timeout), std::future_status::ready);
+
+    serverHandler->sendPacket(serverSignal, serverDataPacket);
+
+    for (auto& client : clients)
+    {
+        ASSERT_EQ(client.packetReceivedFuture.wait_for(timeout), std::future_status::ready);
+        auto [signalId, packet] = client.packetReceivedFuture.get();
+        ASSERT_EQ(signalId, serverSignal.getGlobalId());
+        ASSERT_EQ(packet, serverDataPacket);
+    }
+}
+
 TEST_P(StreamingProtocolTest, AddNotPublicSignal)
 {
     startServer(List<ISignal>());
@@ -42,7 +42,7 @@ public:
 private:
     using ResultMap = std::unordered_map<OpcUaNodeId, std::unordered_map<UA_UInt32, OpcUaVariant>>;
 
-    void readBatch(tsl::ordered_set<OpcUaAttribute>::iterator& attrIterator, size_t size);
+    OpcUaObject<UA_ReadRequest> createBatchRequest(tsl::ordered_set<OpcUaAttribute>::iterator& attrIterator, size_t size);
     void addBatchToResultMap(tsl::ordered_set<OpcUaAttribute>::iterator attrIterator, const OpcUaObject<UA_ReadResponse>& response);
 
     OpcUaClientPtr client;
@@ -59,12 +59,22 @@ public:
     OpcUaNodeId getChildNodeId(const OpcUaNodeId& nodeId, const std::string& browseName);
     CachedReferences browseFiltered(const OpcUaNodeId& nodeId, const BrowseFilter& filter);
 
+    // Persists all cached references, including browsed type hierarchies. The cache key identifies the
+    // server and its model version; loading a file written with a different key leaves the cache untouched.
+    void saveToFile(const std::string& filePath, const std::string& cacheKey) const;
+    bool loadFromFile(const std::string& filePath, const std::string& cacheKey);
+
 private:
     void invalidate(const OpcUaNodeId& nodeId, bool recursive);
     bool isCached(const OpcUaNodeId& nodeId);
     void markAsCached(const OpcUaNodeId& nodeId);
     void browseMultiple(const std::vector<OpcUaNodeId>& nodes);
-    size_t browseBatch(const std::vector<OpcUaNodeId>& nodes, size_t startIndex, size_t size, std::vector<OpcUaNodeId>& browseNext);
+    OpcUaObject<UA_BrowseRequest> createBatchRequest(const std::vector<OpcUaNodeId>& nodes, size_t startIndex, size_t size);
+    void processBatchResponse(const std::vector<OpcUaNodeId>& nodes,
+                              size_t startIndex,
+                              size_t size,
+                              const OpcUaObject<UA_BrowseResponse>& response,
+                              std::vector<OpcUaNodeId>& browseNext);
     void processBrowseResults(const std::vector<OpcUaNodeId>& nodes,
                               size_t startIndex,
                               size_t requestedSize,
@@ -41,4 +41,15 @@ public:
     void setEventFilter(UA_EventFilter* eventFilter);
 };
 
+class DataChangeMonitoredItemCreateRequest : public MonitoredItemCreateRequest
+{
+public:
+    using MonitoredItemCreateRequest::MonitoredItemCreateRequest;
+    DataChangeMonitoredItemCreateRequest();
+    DataChangeMonitoredItemCreateRequest(const OpcUaNodeId& nodeId);
+
+    void setItemToMonitor(const OpcUaNodeId& nodeId);
+    void setSamplingInterval(double samplingIntervalMs);
+};
+
 END_NAMESPACE_OPENDAQ_OPCUA
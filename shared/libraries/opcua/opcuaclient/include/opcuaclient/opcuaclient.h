@@ -99,6 +99,7 @@ public:
     ~OpcUaClient();
 
     static constexpr size_t CONNECTION_TIMEOUT_SECONDS = 10;
+    static constexpr size_t DEFAULT_MAX_PENDING_REQUESTS = 8;
 
     void initialize();
     bool connect();
@@ -149,18 +150,31 @@ public:
 
     void readNodeAttributes(const std::vector<OpcUaReadValueIdWithCallback>& request);
 
+    // Sends all requests asynchronously, keeping up to maxPendingRequests in flight at once, and
+    // returns the responses in request order. Service results are not checked. If the client iterate
+    // fails, the outstanding requests are cancelled and an exception is thrown, the connection is kept.
+    std::vector<OpcUaObject<UA_ReadResponse>> readNodeAttributes(const std::vector<OpcUaObject<UA_ReadRequest>>& requests);
+    std::vector<OpcUaObject<UA_BrowseResponse>> browse(const std::vector<OpcUaObject<UA_BrowseRequest>>& requests);
+
+    void setMaxPendingRequests(size_t maxPendingRequests);
+    size_t getMaxPendingRequests() const;
+
     Subscription* createSubscription(const OpcUaObject<UA_CreateSubscriptionRequest>& request,
                                      const StatusChangeNotificationCallbackType& statusChangeCallback = nullptr);
 
 protected:
     static void timerTaskCallback(UA_Client* client, void* data);
 
+    template <typename RequestType, typename ResponseType>
+    std::vector<OpcUaObject<ResponseType>> sendPipelinedRequests(const std::vector<OpcUaObject<RequestType>>& requests);
+
     void executeIterateCallback();
 
     UA_Client* uaclient{};
     OpcUaEndpoint endpoint;
     uint32_t timeoutMs{CONNECTION_TIMEOUT_SECONDS * 1000};
     uint32_t connectivityCheckInterval{CONNECTION_TIMEOUT_SECONDS * 1000};
+    size_t maxPendingRequests{DEFAULT_MAX_PENDING_REQUESTS};
 
     std::recursive_mutex lock;
 
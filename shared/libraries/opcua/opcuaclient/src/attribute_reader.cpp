@@ -55,29 +55,47 @@ void AttributeReader::read()
         return;
 
     const size_t batchSize = (maxBatchSize > 0) ? maxBatchSize : attributes.size();
-    size_t read = 0;
-    size_t toRead = batchSize;
+    std::vector<OpcUaObject<UA_ReadRequest>> requests;
+    std::vector<tsl::ordered_set<OpcUaAttribute>::iterator> batchStarts;
+
     auto attrIterator = attributes.begin();
+    size_t read = 0;
 
     while (read < attributes.size())
     {
-        toRead = batchSize;
+        size_t toRead = batchSize;
         if (read + toRead > attributes.size())
             toRead = attributes.size() - read;
 
-        readBatch(attrIterator, toRead);
+        batchStarts.push_back(attrIterator);
+        requests.push_back(createBatchRequest(attrIterator, toRead));
         read += toRead;
     }
+
+    // Batches are independent, so they are pipelined instead of waiting for each response in turn
+    const auto responses = client->readNodeAttributes(requests);
+
+    for (size_t i = 0; i < responses.size(); i++)
+    {
+        const auto& response = responses[i];
+        const auto status = response->responseHeader.serviceResult;
+
+        if (status != UA_STATUSCODE_GOOD)
+            throw OpcUaException(status, "Attribute read request failed");
+        if (response->resultsSize != requests[i]->nodesToReadSize)
+            throw OpcUaException(UA_STATUSCODE_BADINVALIDSTATE, "Read request returned incorrect number of results");
+
+        addBatchToResultMap(batchStarts[i], response);
+    }
 }
 
-void AttributeReader::readBatch(tsl::ordered_set<OpcUaAttribute>::iterator& attrIterator, size_t size)
+OpcUaObject<UA_ReadRequest> AttributeReader::createBatchRequest(tsl::ordered_set<OpcUaAttribute>::iterator& attrIterator, size_t size)
 {
     assert(size > 0);
-    auto batchStartIterator = attrIterator;
 
     OpcUaObject<UA_ReadRequest> request;
     request->nodesToReadSize = size;
-    request->nodesToRead = (UA_ReadValueId*) UA_Array_new(attributes.size(), &UA_TYPES[UA_TYPES_READVALUEID]);
+    request->nodesToRead = (UA_ReadValueId*) UA_Array_new(size, &UA_TYPES[UA_TYPES_READVALUEID]);
 
     for (size_t i = 0; i < size; i++)
     {
@@ -87,15 +105,7 @@ void AttributeReader::readBatch(tsl::ordered_set<OpcUaAttribute>::iterator& attr
         attrIterator++;
     }
 
-    OpcUaObject<UA_ReadResponse> response = UA_Client_Service_read(client->getLockedUaClient(), *request);
-    const auto status = response->responseHeader.serviceResult;
-
-    if (status != UA_STATUSCODE_GOOD)
-        throw OpcUaException(status, "Attribute read request failed");
-    if (response->resultsSize != size)
-        throw OpcUaException(UA_STATUSCODE_BADINVALIDSTATE, "Read request returned incorrect number of results");
-
-    addBatchToResultMap(batchStartIterator, response);
+    return request;
 }
 
 void AttributeReader::addBatchToResultMap(tsl::ordered_set<OpcUaAttribute>::iterator attrIterator,
@@ -1,8 +1,29 @@
 #include <opcuaclient/cached_reference_browser.h>
 #include <iostream>
+#include <fstream>
+#include <iterator>
 
 BEGIN_NAMESPACE_OPENDAQ_OPCUA
 
+namespace
+{
+    constexpr char CacheFileMagic[] = "DAQBRWS";
+    constexpr UA_UInt32 CacheFileVersion = 1;
+
+    void appendEncoded(std::string& out, const void* value, const UA_DataType* type)
+    {
+        UA_ByteString buffer = UA_BYTESTRING_NULL;
+        CheckStatusCodeException(UA_encodeBinary(value, type, &buffer), "Failed to encode browse cache entry");
+        out.append(reinterpret_cast<const char*>(buffer.data), buffer.length);
+        UA_ByteString_clear(&buffer);
+    }
+
+    void decode(const UA_ByteString& buffer, size_t& offset, void* value, const UA_DataType* type)
+    {
+        CheckStatusCodeException(UA_decodeBinary(&buffer, &offset, value, type, nullptr), "Failed to decode browse cache entry");
+    }
+}
+
 CachedReferenceBrowser::CachedReferenceBrowser(const OpcUaClientPtr& client, size_t maxNodesPerBrowse)
     : client(client)
     , maxNodesPerBrowse(maxNodesPerBrowse)
@@ -116,6 +137,96 @@ CachedReferences CachedReferenceBrowser::browseFiltered(const OpcUaNodeId& nodeI
     return filtered;
 }
 
+void CachedReferenceBrowser::saveToFile(const std::string& filePath, const std::string& cacheKey) const
+{
+    std::string data(CacheFileMagic, sizeof(CacheFileMagic));
+    appendEncoded(data, &CacheFileVersion, &UA_TYPES[UA_TYPES_UINT32]);
+
+    const UA_String key = UA_STRING(const_cast<char*>(cacheKey.c_str()));
+    appendEncoded(data, &key, &UA_TYPES[UA_TYPES_STRING]);
+
+    const UA_UInt64 entryCount = references.size();
+    appendEncoded(data, &entryCount, &UA_TYPES[UA_TYPES_UINT64]);
+
+    for (const auto& [nodeId, cached] : references)
+    {
+        appendEncoded(data, nodeId.get(), &UA_TYPES[UA_TYPES_NODEID]);
+
+        const UA_UInt32 referenceCount = static_cast<UA_UInt32>(cached.byNodeId.size());
+        appendEncoded(data, &referenceCount, &UA_TYPES[UA_TYPES_UINT32]);
+
+        for (const auto& [refNodeId, ref] : cached.byNodeId)
+            appendEncoded(data, ref.get(), &UA_TYPES[UA_TYPES_REFERENCEDESCRIPTION]);
+    }
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw OpcUaException(UA_STATUSCODE_BADINTERNALERROR, "Failed to open browse cache file for writing");
+
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+bool CachedReferenceBrowser::loadFromFile(const std::string& filePath, const std::string& cacheKey)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+        return false;
+
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(CacheFileMagic) || data.compare(0, sizeof(CacheFileMagic), CacheFileMagic, sizeof(CacheFileMagic)) != 0)
+        return false;
+
+    UA_ByteString buffer;
+    buffer.data = reinterpret_cast<UA_Byte*>(const_cast<char*>(data.data()));
+    buffer.length = data.size();
+    size_t offset = sizeof(CacheFileMagic);
+
+    std::unordered_map<OpcUaNodeId, CachedReferences> loaded;
+
+    try
+    {
+        UA_UInt32 version = 0;
+        decode(buffer, offset, &version, &UA_TYPES[UA_TYPES_UINT32]);
+        if (version != CacheFileVersion)
+            return false;
+
+        OpcUaObject<UA_String> key;
+        decode(buffer, offset, key.get(), &UA_TYPES[UA_TYPES_STRING]);
+        if (utils::ToStdString(*key) != cacheKey)
+            return false;
+
+        UA_UInt64 entryCount = 0;
+        decode(buffer, offset, &entryCount, &UA_TYPES[UA_TYPES_UINT64]);
+
+        for (UA_UInt64 i = 0; i < entryCount; i++)
+        {
+            OpcUaNodeId nodeId;
+            decode(buffer, offset, nodeId.get(), &UA_TYPES[UA_TYPES_NODEID]);
+
+            UA_UInt32 referenceCount = 0;
+            decode(buffer, offset, &referenceCount, &UA_TYPES[UA_TYPES_UINT32]);
+
+            auto& cached = loaded[nodeId];
+            for (UA_UInt32 j = 0; j < referenceCount; j++)
+            {
+                OpcUaObject<UA_ReferenceDescription> ref;
+                decode(buffer, offset, ref.get(), &UA_TYPES[UA_TYPES_REFERENCEDESCRIPTION]);
+
+                const std::string browseName = utils::ToStdString(ref->browseName.name);
+                cached.byNodeId.insert({OpcUaNodeId(ref->nodeId.nodeId), ref});
+                cached.byBrowseName.insert({browseName, ref});
+            }
+        }
+    }
+    catch (const OpcUaException&)
+    {
+        return false;
+    }
+
+    references = std::move(loaded);
+    return true;
+}
+
 bool CachedReferenceBrowser::isCached(const OpcUaNodeId& nodeId)
 {
     return references.count(nodeId) > 0;
@@ -130,24 +241,30 @@ void CachedReferenceBrowser::markAsCached(const OpcUaNodeId& nodeId)
 void CachedReferenceBrowser::browseMultiple(const std::vector<OpcUaNodeId>& nodes)
 {
     const size_t batchSize = (maxNodesPerBrowse > 0) ? maxNodesPerBrowse : nodes.size();
-    std::vector<OpcUaNodeId> browseNext;
-    size_t i = 0;
+    std::vector<OpcUaObject<UA_BrowseRequest>> requests;
+    std::vector<size_t> batchStarts;
 
-    while (i < nodes.size())
-        i += browseBatch(nodes, i, batchSize, browseNext);
+    for (size_t i = 0; i < nodes.size(); i += batchSize)
+    {
+        batchStarts.push_back(i);
+        requests.push_back(createBatchRequest(nodes, i, std::min(batchSize, nodes.size() - i)));
+    }
+
+    // All batches of one tree level are pipelined; the next level is browsed once they are processed
+    const auto responses = client->browse(requests);
+
+    std::vector<OpcUaNodeId> browseNext;
+    for (size_t i = 0; i < responses.size(); i++)
+        processBatchResponse(nodes, batchStarts[i], requests[i]->nodesToBrowseSize, responses[i], browseNext);
 
     if (!browseNext.empty())
         browseMultiple(browseNext);
 }
 
-size_t CachedReferenceBrowser::browseBatch(const std::vector<OpcUaNodeId>& nodes,
-                                           size_t startIndex,
-                                           size_t size,
-                                           std::vector<OpcUaNodeId>& browseNext)
+OpcUaObject<UA_BrowseRequest> CachedReferenceBrowser::createBatchRequest(const std::vector<OpcUaNodeId>& nodes,
+                                                                         size_t startIndex,
+                                                                         size_t size)
 {
-    if ((startIndex + size) > nodes.size())
-        size = nodes.size() - startIndex;
-
     assert(size > 0);
 
     OpcUaObject<UA_BrowseRequest> request;
@@ -165,12 +282,20 @@ size_t CachedReferenceBrowser::browseBatch(const std::vector<OpcUaNodeId>& nodes
         request->nodesToBrowse[i].browseDirection = UA_BROWSEDIRECTION_FORWARD;
     }
 
-    UA_ByteString* continuationPoint = nullptr;
-    OpcUaObject<UA_BrowseResponse> response = UA_Client_Service_browse(client->getLockedUaClient(), *request);
+    return request;
+}
+
+void CachedReferenceBrowser::processBatchResponse(const std::vector<OpcUaNodeId>& nodes,
+                                                  size_t startIndex,
+                                                  size_t size,
+                                                  const OpcUaObject<UA_BrowseResponse>& response,
+                                                  std::vector<OpcUaNodeId>& browseNext)
+{
     CheckStatusCodeException(response->responseHeader.serviceResult, "Browse result error");
 
     processBrowseResults(nodes, startIndex, size, response->results, response->resultsSize, browseNext);
 
+    UA_ByteString* continuationPoint = nullptr;
     while (getContinuationPoint(response->results, &continuationPoint))
     {
         OpcUaObject<UA_BrowseNextRequest> nextRequest;
@@ -182,8 +307,6 @@ size_t CachedReferenceBrowser::browseBatch(const std::vector<OpcUaNodeId>& nodes
 
         processBrowseResults(nodes, startIndex, size, nextResponse->results, nextResponse->resultsSize, browseNext);
     }
-
-    return size;
 }
 
 void CachedReferenceBrowser::processBrowseResults(const std::vector<OpcUaNodeId>& nodes,
@@ -56,4 +56,30 @@ void EventMonitoredItemCreateRequest::setEventFilter(UA_EventFilter* eventFilter
     value.requestedParameters.filter.content.decoded.type = &UA_TYPES[UA_TYPES_EVENTFILTER];
 }
 
+/*DataChangeMonitoredItemCreateRequest*/
+
+DataChangeMonitoredItemCreateRequest::DataChangeMonitoredItemCreateRequest()
+    : MonitoredItemCreateRequest()
+{
+    value.itemToMonitor.attributeId = UA_ATTRIBUTEID_VALUE;
+    value.monitoringMode = UA_MONITORINGMODE_REPORTING;
+}
+
+DataChangeMonitoredItemCreateRequest::DataChangeMonitoredItemCreateRequest(const OpcUaNodeId& nodeId)
+    : DataChangeMonitoredItemCreateRequest()
+{
+    setItemToMonitor(nodeId);
+}
+
+void DataChangeMonitoredItemCreateRequest::setItemToMonitor(const OpcUaNodeId& nodeId)
+{
+    UA_NodeId_clear(&value.itemToMonitor.nodeId);
+    value.itemToMonitor.nodeId = nodeId.copyAndGetDetachedValue();
+}
+
+void DataChangeMonitoredItemCreateRequest::setSamplingInterval(double samplingIntervalMs)
+{
+    value.requestedParameters.samplingInterval = samplingIntervalMs;
+}
+
 END_NAMESPACE_OPENDAQ_OPCUA
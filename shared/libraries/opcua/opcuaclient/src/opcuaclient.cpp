@@ -435,6 +435,120 @@ void OpcUaClient::readNodeAttributes(const std::vector<OpcUaReadValueIdWithCallb
     }
 }
 
+namespace
+{
+    template <typename ResponseType>
+    struct PipelinedResponses
+    {
+        explicit PipelinedResponses(size_t count)
+            : responses(count)
+            , received(count, false)
+        {
+        }
+
+        std::vector<OpcUaObject<ResponseType>> responses;
+        std::vector<bool> received;
+    };
+
+    // Owned by the callback of its request, which may still run after sendPipelinedRequests has thrown
+    template <typename ResponseType>
+    struct PendingResponse
+    {
+        std::shared_ptr<PipelinedResponses<ResponseType>> pipelined;
+        size_t index;
+    };
+
+    template <typename ResponseType>
+    void PendingResponseCallback(UA_Client* /*client*/, void* userdata, UA_UInt32 /*requestId*/, void* response)
+    {
+        std::unique_ptr<PendingResponse<ResponseType>> pending(static_cast<PendingResponse<ResponseType>*>(userdata));
+        auto& pipelined = *pending->pipelined;
+        if (response != nullptr)
+            pipelined.responses[pending->index].setValue(*static_cast<ResponseType*>(response));
+        else
+            pipelined.responses[pending->index]->responseHeader.serviceResult = UA_STATUSCODE_BADUNEXPECTEDERROR;
+        pipelined.received[pending->index] = true;
+    }
+}
+
+template <typename RequestType, typename ResponseType>
+std::vector<OpcUaObject<ResponseType>> OpcUaClient::sendPipelinedRequests(const std::vector<OpcUaObject<RequestType>>& requests)
+{
+    const auto pipelined = std::make_shared<PipelinedResponses<ResponseType>>(requests.size());
+    std::vector<UA_UInt32> requestIds(requests.size());
+    const size_t window = maxPendingRequests > 0 ? maxPendingRequests : requests.size();
+
+    auto client = getLockedUaClient();
+    size_t sent = 0;
+    size_t received = 0;
+
+    while (received < requests.size())
+    {
+        while (sent < requests.size() && sent - received < window)
+        {
+            auto pending = std::make_unique<PendingResponse<ResponseType>>(PendingResponse<ResponseType>{pipelined, sent});
+            const auto status = UA_Client_sendAsyncRequest(client,
+                                                           requests[sent].get(),
+                                                           GetUaDataType<RequestType>(),
+                                                           PendingResponseCallback<ResponseType>,
+                                                           GetUaDataType<ResponseType>(),
+                                                           pending.get(),
+                                                           &requestIds[sent]);
+            if (status == UA_STATUSCODE_GOOD)
+            {
+                pending.release();
+            }
+            else
+            {
+                pipelined->responses[sent]->responseHeader.serviceResult = status;
+                pipelined->received[sent] = true;
+            }
+            sent++;
+        }
+
+        // Responses are delivered from the client iterate, timed out requests are completed with a bad status
+        const auto status = UA_Client_run_iterate(client, 10);
+        if (status != UA_STATUSCODE_GOOD)
+        {
+            // The connection is left to its owner to close or reconnect. Outstanding requests are cancelled,
+            // their callbacks release the pending responses once they complete or the connection is closed.
+            for (size_t i = received; i < sent; i++)
+            {
+                if (!pipelined->received[i])
+                    UA_Client_cancelByRequestId(client, requestIds[i], nullptr);
+            }
+            throw OpcUaException(status, "Pipelined request failed");
+        }
+
+        received = 0;
+        while (received < sent && pipelined->received[received])
+            received++;
+    }
+
+    return std::move(pipelined->responses);
+}
+
+std::vector<OpcUaObject<UA_ReadResponse>> OpcUaClient::readNodeAttributes(const std::vector<OpcUaObject<UA_ReadRequest>>& requests)
+{
+    return sendPipelinedRequests<UA_ReadRequest, UA_ReadResponse>(requests);
+}
+
+std::vector<OpcUaObject<UA_BrowseResponse>> OpcUaClient::browse(const std::vector<OpcUaObject<UA_BrowseRequest>>& requests)
+{
+    return sendPipelinedRequests<UA_BrowseRequest, UA_BrowseResponse>(requests);
+}
+
+void OpcUaClient::setMaxPendingRequests(size_t maxPendingRequests)
+{
+    std::lock_guard guard(getLock());
+    this->maxPendingRequests = maxPendingRequests;
+}
+
+size_t OpcUaClient::getMaxPendingRequests() const
+{
+    return maxPendingRequests;
+}
+
 OpcUaObject<UA_CallResponse> OpcUaClient::callMethods(const OpcUaObject<UA_CallRequest>& request)
 {
     return UA_Client_Service_call(getLockedUaClient(), *request);
@@ -4,6 +4,7 @@
 #include "opcuashared/opcua.h"
 #include "opcuashared/opcuacommon.h"
 #include "opcuaclient/cached_reference_browser.h"
+#include <filesystem>
 
 BEGIN_NAMESPACE_OPENDAQ_OPCUA
 
@@ -172,5 +173,39 @@ TEST_F(CachedReferenceBrowserTest, MaxNodesPerBrowse)
     ASSERT_THROW(missconfiguredBrowser.browse(nodeId), OpcUaException);
 }
 
+TEST_F(CachedReferenceBrowserTest, SaveAndLoad)
+{
+    auto client = std::make_shared<OpcUaClient>(getServerUrl());
+    client->connect();
+
+    const auto filePath = (std::filesystem::temp_directory_path() / "cached_reference_browser_test.cache").string();
+    const auto nodeId = OpcUaNodeId(UA_NS0ID_SERVER_SERVERSTATUS);
+
+    auto browser = CachedReferenceBrowser(client);
+    const auto& references = browser.browse(nodeId);
+    ASSERT_NO_THROW(browser.saveToFile(filePath, "key"));
+
+    client->disconnect();
+
+    auto loadedBrowser = CachedReferenceBrowser(client);
+    ASSERT_FALSE(loadedBrowser.loadFromFile(filePath, "otherKey"));
+    ASSERT_TRUE(loadedBrowser.loadFromFile(filePath, "key"));
+
+    // Served from the loaded cache, the client is no longer connected
+    const auto& loadedReferences = loadedBrowser.browse(nodeId);
+    ASSERT_EQ(loadedReferences.byBrowseName.size(), references.byBrowseName.size());
+
+    auto it = references.byBrowseName.begin();
+    auto loadedIt = loadedReferences.byBrowseName.begin();
+    for (; it != references.byBrowseName.end(); ++it, ++loadedIt)
+    {
+        ASSERT_EQ(loadedIt.key(), it.key());
+        ASSERT_EQ(OpcUaNodeId(loadedIt.value()->nodeId.nodeId), OpcUaNodeId(it.value()->nodeId.nodeId));
+    }
+
+    ASSERT_EQ(loadedBrowser.getChildNodeId(nodeId, "StartTime"), browser.getChildNodeId(nodeId, "StartTime"));
+
+    std::filesystem::remove(filePath);
+}
 
 END_NAMESPACE_OPENDAQ_OPCUA
@@ -233,4 +233,42 @@ TEST_F(OpcUaClientTest, CallMethodsWithCallback)
     ASSERT_EQ(outputArgs, "Hello! (R:Test)");
 }
 
+TEST_F(OpcUaClientTest, PipelinedReadRequests)
+{
+    auto client = prepareAndConnectClient();
+    client->setMaxPendingRequests(2);
+
+    const std::vector<OpcUaNodeId> nodeIds{OpcUaNodeId(UA_NS0ID_SERVER_NAMESPACEARRAY),
+                                           OpcUaNodeId(UA_NS0ID_SERVER_SERVERSTATUS_STARTTIME),
+                                           OpcUaNodeId(UA_NS0ID_SERVER_SERVERSTATUS_STATE),
+                                           OpcUaNodeId(1, "unknown"),
+                                           OpcUaNodeId(UA_NS0ID_SERVER_SERVERARRAY)};
+
+    std::vector<OpcUaObject<UA_ReadRequest>> requests;
+    for (const auto& nodeId : nodeIds)
+    {
+        OpcUaObject<UA_ReadRequest> request;
+        request->nodesToReadSize = 1;
+        request->nodesToRead = UA_ReadValueId_new();
+        request->nodesToRead[0].nodeId = nodeId.copyAndGetDetachedValue();
+        request->nodesToRead[0].attributeId = UA_ATTRIBUTEID_VALUE;
+        requests.push_back(request);
+    }
+
+    const auto responses = client->readNodeAttributes(requests);
+    ASSERT_EQ(responses.size(), nodeIds.size());
+
+    for (size_t i = 0; i < responses.size(); i++)
+    {
+        ASSERT_EQ(responses[i]->responseHeader.serviceResult, UA_STATUSCODE_GOOD);
+        ASSERT_EQ(responses[i]->resultsSize, 1u);
+
+        const auto expected = client->readNodeAttributes(requests[i]);
+        ASSERT_EQ(responses[i]->results[0].status, expected->results[0].status);
+        ASSERT_EQ(responses[i]->results[0].value.type, expected->results[0].value.type);
+    }
+
+    ASSERT_EQ(responses[3]->results[0].status, UA_STATUSCODE_BADNODEIDUNKNOWN);
+}
+
 END_NAMESPACE_OPENDAQ_OPCUA
@@ -18,6 +18,9 @@
 
 #include <opendaq/utils/thread_ex.h>
 #include <unordered_set>
+#include <functional>
+#include <mutex>
+#include <vector>
 
 #include <opcuashared/node/opcuanodeobject.h>
 #include <opcuashared/opcuasecurity_config.h>
@@ -52,6 +55,12 @@ public:
     void start() override;
     void stop() override;
 
+    // Runs the work on the server thread between iterations, outside of any service or access control callback.
+    // Work posted while handling a request runs before any request sent after its response is processed.
+    // Work posted by running work runs after the next iteration, so long work can be split into slices
+    // between which requests are served. The work must not throw.
+    void postToServerThread(std::function<void()> work);
+
     OpcUaServerNode getNode(const OpcUaNodeId& nodeId);
     OpcUaServerObjectNode getRootNode();
     OpcUaServerObjectNode getObjectsNode();
@@ -128,6 +137,8 @@ private:
     void prepareAccessControl(UA_ServerConfig* config);
     void configureAppUri(UA_ServerConfig* config);
     void shutdownServer();
+    void runPostedWork();
+    bool hasPostedWork();
 
     static UA_StatusCode activateSession(UA_Server* server,
                                          UA_AccessControl* ac,
@@ -158,6 +169,8 @@ private:
     ServerEventManagerPtr eventManager;
     static std::mutex serverMappingMutex;
     static std::map<UA_Server*, OpcUaServer*> serverMapping;
+    std::mutex postedWorkMutex;
+    std::vector<std::function<void()>> postedWork;
 };
 
 END_NAMESPACE_OPENDAQ_OPCUA
@@ -79,6 +79,30 @@ void OpcUaServer::stop()
     shutdownServer();
 }
 
+void OpcUaServer::postToServerThread(std::function<void()> work)
+{
+    std::lock_guard<std::mutex> guard(postedWorkMutex);
+    postedWork.push_back(std::move(work));
+}
+
+void OpcUaServer::runPostedWork()
+{
+    std::vector<std::function<void()>> work;
+    {
+        std::lock_guard<std::mutex> guard(postedWorkMutex);
+        work.swap(postedWork);
+    }
+
+    for (const auto& item : work)
+        item();
+}
+
+bool OpcUaServer::hasPostedWork()
+{
+    std::lock_guard<std::mutex> guard(postedWorkMutex);
+    return !postedWork.empty();
+}
+
 void OpcUaServer::prepare()
 {
     try
@@ -220,7 +244,9 @@ void OpcUaServer::execute()
     setThreadName("OpcUaServer");
     while (!terminated)
     {
-        UA_Server_run_iterate(server, true);
+        // does not wait for network events while work is pending
+        UA_Server_run_iterate(server, !hasPostedWork());
+        runPostedWork();
     }
     shutdownServer();
 }
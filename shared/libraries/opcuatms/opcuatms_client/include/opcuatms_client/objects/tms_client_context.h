@@ -18,8 +18,11 @@
 #include "opcuatms/opcuatms.h"
 #include "opcuaclient/opcuaclient.h"
 #include <mutex>
+#include <atomic>
+#include <list>
 #include <opcuaclient/cached_reference_browser.h>
 #include <opcuaclient/attribute_reader.h>
+#include <opcuaclient/subscriptions.h>
 #include <opendaq/logger_component_ptr.h>
 #include <opendaq/context_ptr.h>
 #include <opendaq/component_ptr.h>
@@ -34,6 +37,7 @@ class TmsClientContext
 {
 public:
     explicit TmsClientContext(const opcua::OpcUaClientPtr& client, const ContextPtr& context);
+    ~TmsClientContext();
 
     const opcua::OpcUaClientPtr& getClient() const;
 
@@ -46,9 +50,25 @@ public:
     CachedReferenceBrowserPtr getReferenceBrowser();
     AttributeReaderPtr getAttributeReader();
     void readObjectAttributes(const OpcUaNodeId& nodeId, bool forceRead = false);
+    void readObjectAttributes(const std::vector<OpcUaNodeId>& nodeIds, bool forceRead = false);
+    void readFunctionBlockTypesAttributes(const OpcUaNodeId& typesFolderId);
     size_t getMaxNodesPerBrowse();
     size_t getMaxNodesPerRead();
 
+    // When value monitoring is enabled, each node read through readValue is subscribed to with a
+    // monitored item on first access; later reads are served from the locally updated value.
+    // At most maxMonitoredValues nodes are monitored, the least recently read one is dropped first.
+    void setValueMonitoring(bool enabled,
+                            double samplingIntervalMs = DefaultMonitoringSamplingInterval,
+                            size_t maxMonitoredValues = DefaultMaxMonitoredValues);
+    bool getValueMonitoringEnabled() const;
+    opcua::OpcUaVariant readValue(const opcua::OpcUaNodeId& nodeId);
+    void writeValue(const opcua::OpcUaNodeId& nodeId, const opcua::OpcUaVariant& value);
+    void invalidateMonitoredValue(const opcua::OpcUaNodeId& nodeId);
+
+    static constexpr double DefaultMonitoringSamplingInterval = 100.0;
+    static constexpr size_t DefaultMaxMonitoredValues = 1000;
+
     template <class I, class Ptr = typename InterfaceToSmartPtr<I>::SmartPtr>
     Ptr getObject(const opcua::OpcUaNodeId& nodeId)
     {
@@ -77,8 +97,32 @@ protected:
     size_t maxNodesPerRead = 0;
     WeakRefPtr<IDevice> rootDevice;
 
+    struct MonitoredValue
+    {
+        opcua::OpcUaVariant value;
+        bool valid = false;
+        UA_UInt32 monitoredItemId = 0;
+        std::list<opcua::OpcUaNodeId>::iterator lruPosition;
+    };
+
+    std::atomic<bool> valueMonitoringEnabled = false;
+    double monitoringSamplingInterval = DefaultMonitoringSamplingInterval;
+    size_t maxMonitoredValues = DefaultMaxMonitoredValues;
+    opcua::Subscription* valueSubscription = nullptr;
+    std::mutex monitoredValuesMutex;
+    std::unordered_map<opcua::OpcUaNodeId, MonitoredValue> monitoredValues;
+    // most recently read node first
+    std::list<opcua::OpcUaNodeId> monitoredValuesLru;
+
     void initReferenceBrowser();
     void initAttributeReader();
+    void monitorValue(const opcua::OpcUaNodeId& nodeId);
+    void deleteMonitoredItems(const std::vector<UA_UInt32>& monitoredItemIds);
+    void revalidateMonitoredValue(const opcua::OpcUaNodeId& nodeId);
+    opcua::Subscription* getValueSubscription();
+    void onMonitoredValueChanged(const opcua::OpcUaNodeId& nodeId, const UA_DataValue* value);
+    void onValueSubscriptionStatusChanged(const UA_StatusChangeNotification* notification);
+    void deleteValueSubscription();
 };
 
 END_NAMESPACE_OPENDAQ_OPCUA_TMS
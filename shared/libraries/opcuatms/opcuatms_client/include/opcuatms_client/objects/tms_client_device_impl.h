@@ -63,6 +63,7 @@ protected:
     bool isRootDevice;
 
 private:
+    void prefetchChildAttributes(const CachedReferences& references);
     void fetchTimeDomain();
     void fetchTicksSinceOrigin();
 
@@ -28,8 +28,11 @@ public:
     TmsAttributeCollector(const CachedReferenceBrowserPtr& browser);
 
     tsl::ordered_set<OpcUaAttribute> collectAttributes(const OpcUaNodeId& nodeId);
+    tsl::ordered_set<OpcUaAttribute> collectAttributes(const std::vector<OpcUaNodeId>& nodeIds);
+    tsl::ordered_set<OpcUaAttribute> collectFunctionBlockTypesAttributes(const OpcUaNodeId& typesFolderId);
 
 private:
+    void collectNodeAttributes(const OpcUaNodeId& nodeId);
     void collectDeviceAttributes(const OpcUaNodeId& nodeId);
     void collectFunctionBlockAttributes(const OpcUaNodeId& nodeId);
     void collectInputPortAttributes(const OpcUaNodeId& nodeId);
@@ -41,6 +44,7 @@ private:
     void collectBaseObjectAttributes(const OpcUaNodeId& nodeId);
     void collectMethodAttributes(const OpcUaNodeId& nodeId);
     void collectVariableBlockAttributes(const OpcUaNodeId& nodeId);
+    void collectFunctionBlockTypeAttributes(const OpcUaNodeId& nodeId);
 
     void collectIoNode(const OpcUaNodeId& nodeId);
     void collectInputPortNode(const OpcUaNodeId& nodeId);
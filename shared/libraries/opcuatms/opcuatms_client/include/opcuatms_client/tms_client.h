@@ -32,10 +32,22 @@ public:
               const std::string& opcUaUrl,
               const FunctionPtr& createStreamingCallback);
 
+    void setValueMonitoring(bool enabled,
+                            double samplingIntervalMs = tms::TmsClientContext::DefaultMonitoringSamplingInterval,
+                            size_t maxMonitoredValues = tms::TmsClientContext::DefaultMaxMonitoredValues);
+    // Browse results are stored in the given directory and reused on reconnect while the server's
+    // namespaces, start time and the references of every node reachable from the device set are
+    // unchanged. An empty directory disables the persistent cache.
+    void setBrowseCacheDirectory(const std::string& directory);
     daq::DevicePtr connect();
 
 protected:
     void getRootDeviceNodeAttributes(OpcUaNodeId& nodeIdOut, std::string& browseNameOut);
+    std::string getBrowseCacheKey(const ListPtr<IString>& namespaces);
+    size_t getModelHash();
+    std::string getBrowseCacheFilePath() const;
+    void loadBrowseCache(const std::string& cacheKey);
+    void saveBrowseCache(const std::string& cacheKey);
 
     tms::TmsClientContextPtr tmsClientContext;
     ContextPtr context;
@@ -44,6 +56,10 @@ protected:
     FunctionPtr createStreamingCallback;
     ComponentPtr parent;
     LoggerComponentPtr loggerComponent;
+    bool valueMonitoring = false;
+    double monitoringSamplingInterval = tms::TmsClientContext::DefaultMonitoringSamplingInterval;
+    size_t maxMonitoredValues = tms::TmsClientContext::DefaultMaxMonitoredValues;
+    std::string browseCacheDirectory;
 
 private:
     StringPtr getUniqueLocalId(const StringPtr& localId, int iteration = 0);
@@ -1,6 +1,8 @@
 #include "opcuatms_client/objects/tms_client_context.h"
 #include <opcuatms_client/tms_attribute_collector.h>
+#include <opcuaclient/monitored_item_create_request.h>
 #include <opendaq/custom_log.h>
+#include <algorithm>
 
 BEGIN_NAMESPACE_OPENDAQ_OPCUA_TMS
 
@@ -17,6 +19,11 @@ TmsClientContext::TmsClientContext(const opcua::OpcUaClientPtr& client, const Co
     initAttributeReader();
 }
 
+TmsClientContext::~TmsClientContext()
+{
+    deleteValueSubscription();
+}
+
 const opcua::OpcUaClientPtr& TmsClientContext::getClient() const
 {
     return client;
@@ -88,6 +95,34 @@ void TmsClientContext::readObjectAttributes(const OpcUaNodeId& nodeId, bool forc
     attributeReader->read();
 }
 
+void TmsClientContext::readObjectAttributes(const std::vector<OpcUaNodeId>& nodeIds, bool forceRead)
+{
+    std::vector<OpcUaNodeId> toRead;
+    for (const auto& nodeId : nodeIds)
+    {
+        if (forceRead || !attributeReader->hasAnyValue(nodeId))
+            toRead.push_back(nodeId);
+    }
+
+    if (toRead.empty())
+        return;
+
+    auto collector = TmsAttributeCollector(referenceBrowser);
+    auto attributes = collector.collectAttributes(toRead);
+
+    attributeReader->setAttibutes(attributes);
+    attributeReader->read();
+}
+
+void TmsClientContext::readFunctionBlockTypesAttributes(const OpcUaNodeId& typesFolderId)
+{
+    auto collector = TmsAttributeCollector(referenceBrowser);
+    auto attributes = collector.collectFunctionBlockTypesAttributes(typesFolderId);
+
+    attributeReader->setAttibutes(attributes);
+    attributeReader->read();
+}
+
 size_t TmsClientContext::getMaxNodesPerBrowse()
 {
     return maxNodesPerBrowse;
@@ -98,6 +133,225 @@ size_t TmsClientContext::getMaxNodesPerRead()
     return maxNodesPerRead;
 }
 
+void TmsClientContext::setValueMonitoring(bool enabled, double samplingIntervalMs, size_t maxMonitoredValues)
+{
+    monitoringSamplingInterval = samplingIntervalMs;
+    this->maxMonitoredValues = maxMonitoredValues;
+    valueMonitoringEnabled = enabled;
+
+    if (!enabled)
+        deleteValueSubscription();
+}
+
+bool TmsClientContext::getValueMonitoringEnabled() const
+{
+    return valueMonitoringEnabled;
+}
+
+OpcUaVariant TmsClientContext::readValue(const OpcUaNodeId& nodeId)
+{
+    if (!valueMonitoringEnabled)
+        return client->readValue(nodeId);
+
+    bool monitored;
+    {
+        std::lock_guard guard(monitoredValuesMutex);
+        const auto it = monitoredValues.find(nodeId);
+        monitored = it != monitoredValues.end();
+        if (monitored)
+        {
+            monitoredValuesLru.splice(monitoredValuesLru.begin(), monitoredValuesLru, it->second.lruPosition);
+            if (it->second.valid)
+                return it->second.value;
+        }
+    }
+
+    if (!monitored)
+        monitorValue(nodeId);
+
+    return client->readValue(nodeId);
+}
+
+void TmsClientContext::writeValue(const OpcUaNodeId& nodeId, const OpcUaVariant& value)
+{
+    // Reads go to the server until the value is read back, as a write that leaves the value
+    // unchanged is not reported by the monitored item
+    invalidateMonitoredValue(nodeId);
+    client->writeValue(nodeId, value);
+    revalidateMonitoredValue(nodeId);
+}
+
+void TmsClientContext::revalidateMonitoredValue(const OpcUaNodeId& nodeId)
+{
+    {
+        std::lock_guard guard(monitoredValuesMutex);
+        if (monitoredValues.find(nodeId) == monitoredValues.end())
+            return;
+    }
+
+    OpcUaVariant value;
+    try
+    {
+        value = client->readValue(nodeId);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Failed to read back written monitored value: {}", e.what());
+        return;
+    }
+
+    std::lock_guard guard(monitoredValuesMutex);
+    const auto it = monitoredValues.find(nodeId);
+
+    // a notification received in the meantime holds a newer value
+    if (it != monitoredValues.end() && !it->second.valid)
+    {
+        it->second.value = value;
+        it->second.valid = true;
+    }
+}
+
+void TmsClientContext::invalidateMonitoredValue(const OpcUaNodeId& nodeId)
+{
+    std::lock_guard guard(monitoredValuesMutex);
+    if (const auto it = monitoredValues.find(nodeId); it != monitoredValues.end())
+        it->second.valid = false;
+}
+
+void TmsClientContext::monitorValue(const OpcUaNodeId& nodeId)
+{
+    std::vector<UA_UInt32> evictedItemIds;
+    {
+        std::lock_guard guard(monitoredValuesMutex);
+        const auto [it, inserted] = monitoredValues.emplace(nodeId, MonitoredValue());
+        if (!inserted)
+            return;
+        it->second.lruPosition = monitoredValuesLru.insert(monitoredValuesLru.begin(), nodeId);
+
+        while (monitoredValues.size() > std::max<size_t>(maxMonitoredValues, 1))
+        {
+            const auto evicted = monitoredValues.find(monitoredValuesLru.back());
+            // an item still being created is deleted by its creator once it finds the entry gone
+            if (evicted->second.monitoredItemId != 0)
+                evictedItemIds.push_back(evicted->second.monitoredItemId);
+            monitoredValues.erase(evicted);
+            monitoredValuesLru.pop_back();
+        }
+    }
+
+    // The client lock is taken before the monitored values mutex here and in the notification
+    // callbacks, which are invoked from the client iterate thread while it holds the client lock.
+    std::lock_guard clientGuard(client->getLock());
+    deleteMonitoredItems(evictedItemIds);
+
+    try
+    {
+        auto request = DataChangeMonitoredItemCreateRequest(nodeId);
+        request.setSamplingInterval(monitoringSamplingInterval);
+
+        const auto monitoredItem = getValueSubscription()->monitoredItemsCreateDataChange(
+            UA_TIMESTAMPSTORETURN_BOTH,
+            *request,
+            [this, nodeId](OpcUaClient*, Subscription*, MonitoredItem*, UA_DataValue* value) { onMonitoredValueChanged(nodeId, value); });
+
+        bool evicted = false;
+        {
+            std::lock_guard guard(monitoredValuesMutex);
+            if (const auto it = monitoredValues.find(nodeId); it != monitoredValues.end())
+                it->second.monitoredItemId = monitoredItem->getMonitoredItemId();
+            else
+                evicted = true;
+        }
+
+        // the entry was dropped by a concurrent read of other nodes while the item was created
+        if (evicted)
+            deleteMonitoredItems({monitoredItem->getMonitoredItemId()});
+    }
+    catch (const std::exception& e)
+    {
+        // The entry stays invalid, so the value keeps being read from the server
+        LOG_W("Failed to create monitored item for value monitoring: {}", e.what());
+    }
+}
+
+void TmsClientContext::deleteMonitoredItems(const std::vector<UA_UInt32>& monitoredItemIds)
+{
+    if (!valueSubscription)
+        return;
+
+    for (const auto monitoredItemId : monitoredItemIds)
+    {
+        const auto status =
+            UA_Client_MonitoredItems_deleteSingle(client->getUaClient(), valueSubscription->getSubscriptionId(), monitoredItemId);
+        if (status != UA_STATUSCODE_GOOD)
+            LOG_W("Failed to delete monitored item of value monitoring: {}", UA_StatusCode_name(status));
+    }
+}
+
+Subscription* TmsClientContext::getValueSubscription()
+{
+    std::lock_guard guard(client->getLock());
+
+    if (!valueSubscription)
+    {
+        OpcUaObject<UA_CreateSubscriptionRequest> request = UA_CreateSubscriptionRequest_default();
+        request->requestedPublishingInterval = monitoringSamplingInterval;
+
+        valueSubscription = client->createSubscription(
+            request, [this](OpcUaClient*, Subscription*, UA_StatusChangeNotification* notification) { onValueSubscriptionStatusChanged(notification); });
+    }
+
+    return valueSubscription;
+}
+
+void TmsClientContext::onMonitoredValueChanged(const OpcUaNodeId& nodeId, const UA_DataValue* value)
+{
+    std::lock_guard guard(monitoredValuesMutex);
+
+    const auto it = monitoredValues.find(nodeId);
+    if (it == monitoredValues.end())
+        return;
+
+    if (value->hasValue && (!value->hasStatus || value->status == UA_STATUSCODE_GOOD))
+    {
+        it->second.value = OpcUaVariant(value->value);
+        it->second.valid = true;
+    }
+    else
+    {
+        it->second.valid = false;
+    }
+}
+
+void TmsClientContext::onValueSubscriptionStatusChanged(const UA_StatusChangeNotification* notification)
+{
+    if (notification->status == UA_STATUSCODE_GOOD)
+        return;
+
+    // The subscription is removed by the client; values are monitored again on next access
+    LOG_W("Value monitoring subscription status changed: {}", UA_StatusCode_name(notification->status));
+
+    valueSubscription = nullptr;
+    std::lock_guard guard(monitoredValuesMutex);
+    monitoredValues.clear();
+    monitoredValuesLru.clear();
+}
+
+void TmsClientContext::deleteValueSubscription()
+{
+    std::lock_guard guard(client->getLock());
+
+    if (valueSubscription)
+    {
+        UA_Client_Subscriptions_deleteSingle(client->getUaClient(), valueSubscription->getSubscriptionId());
+        valueSubscription = nullptr;
+    }
+
+    std::lock_guard valuesGuard(monitoredValuesMutex);
+    monitoredValues.clear();
+    monitoredValuesLru.clear();
+}
+
 void TmsClientContext::initReferenceBrowser()
 {
     try
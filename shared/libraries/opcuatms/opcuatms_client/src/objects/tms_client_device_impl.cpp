@@ -92,6 +92,7 @@ void TmsClientDeviceImpl::findAndCreateSubdevices()
     std::vector<DevicePtr> unorderedDevices;
 
     const auto& references = getChildReferencesOfType(nodeId, OpcUaNodeId(NAMESPACE_DAQDEVICE, UA_DAQDEVICEID_DAQDEVICETYPE));
+    prefetchChildAttributes(references);
 
     for (const auto& [browseName, ref] : references.byBrowseName)
     {
@@ -118,6 +119,16 @@ void TmsClientDeviceImpl::findAndCreateSubdevices()
         addSubDevice(val);
 }
 
+void TmsClientDeviceImpl::prefetchChildAttributes(const CachedReferences& references)
+{
+    std::vector<OpcUaNodeId> childNodeIds;
+    childNodeIds.reserve(references.byNodeId.size());
+    for (const auto& [childNodeId, ref] : references.byNodeId)
+        childNodeIds.push_back(childNodeId);
+
+    clientContext->readObjectAttributes(childNodeIds);
+}
+
 DevicePtr TmsClientDeviceImpl::onAddDevice(const StringPtr& /*connectionString*/, const PropertyObjectPtr& /*config*/)
 {
     throw OpcUaClientCallNotAvailableException();
@@ -189,7 +200,9 @@ void TmsClientDeviceImpl::fetchTimeDomain()
     if (timeDomainFetched)
         return;
     auto timeDomainNodeId = getNodeId("Domain");
-    auto variant = client->readValue(timeDomainNodeId);
+    const auto reader = clientContext->getAttributeReader();
+    auto variant = reader->hasAnyValue(timeDomainNodeId) ? reader->getValue(timeDomainNodeId, UA_ATTRIBUTEID_VALUE)
+                                                         : client->readValue(timeDomainNodeId);
 
     UA_DeviceDomainStructure* deviceDomain;
     deviceDomain = (UA_DeviceDomainStructure*) variant.getValue().data;
@@ -231,10 +244,9 @@ RatioPtr TmsClientDeviceImpl::onGetResolution()
 
 uint64_t TmsClientDeviceImpl::onGetTicksSinceOrigin()
 {
-    if(!timeDomainFetched)
-        fetchTimeDomain();
-    else
-        fetchTicksSinceOrigin();
+    // The static domain info may come from the batched tree read; ticks are always read live
+    fetchTimeDomain();
+    fetchTicksSinceOrigin();
 
     return ticksSinceOrigin;
 }
@@ -259,6 +271,7 @@ void TmsClientDeviceImpl::findAndCreateFunctionBlocks()
 
     auto functionBlocksNodeId = getNodeId("FB");
     const auto& references = getChildReferencesOfType(functionBlocksNodeId, OpcUaNodeId(NAMESPACE_DAQBSP, UA_DAQBSPID_FUNCTIONBLOCKTYPE));
+    prefetchChildAttributes(references);
 
     for (const auto& [browseName, ref] : references.byBrowseName)
     {
@@ -292,6 +305,7 @@ void TmsClientDeviceImpl::findAndCreateSignals()
     
     const auto signalsNodeId = getNodeId("Sig");
     const auto& references = getChildReferencesOfType(signalsNodeId, OpcUaNodeId(NAMESPACE_DAQBSP, UA_DAQBSPID_SIGNALTYPE));
+    prefetchChildAttributes(references);
 
     for (const auto& [signalNodeId, ref] : references.byNodeId)
     {
@@ -468,6 +482,7 @@ DictPtr<IString, IFunctionBlockType> TmsClientDeviceImpl::onGetAvailableFunction
     filter.nodeClass = UA_NODECLASS_VARIABLE;
 
     auto fbTypesReferences = browser->browseFiltered(availableTypesId, filter);
+    clientContext->readFunctionBlockTypesAttributes(availableTypesId);
 
     for (const auto& [refNodeId, ref] : fbTypesReferences.byNodeId)
     {
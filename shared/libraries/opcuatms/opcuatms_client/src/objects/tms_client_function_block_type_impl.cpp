@@ -49,7 +49,8 @@ ErrCode TmsClientFunctionBlockTypeImpl::createDefaultConfig(IPropertyObject** de
 
 void TmsClientFunctionBlockTypeImpl::readAttributes()
 {
-    const auto value = client->readValue(nodeId);
+    const auto reader = clientContext->getAttributeReader();
+    const auto value = reader->hasAnyValue(nodeId) ? reader->getValue(nodeId, UA_ATTRIBUTEID_VALUE) : client->readValue(nodeId);
     this->type = VariantConverter<IFunctionBlockType>::ToDaqObject(value);
 
     const auto defaultConfigId = getNodeId("DefaultConfig");
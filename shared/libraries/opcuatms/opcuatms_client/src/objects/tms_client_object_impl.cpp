@@ -43,13 +43,13 @@ OpcUaNodeId TmsClientObjectImpl::getNodeId(const std::string& nodeName)
 void TmsClientObjectImpl::writeValue(const std::string& nodeName, const OpcUaVariant& value)
 {
     const auto nodeId = getNodeId(nodeName);
-    client->writeValue(nodeId, value);
+    clientContext->writeValue(nodeId, value);
 }
 
 OpcUaVariant TmsClientObjectImpl::readValue(const std::string& nodeName)
 {
     const auto nodeId = getNodeId(nodeName);
-    return client->readValue(nodeId);
+    return clientContext->readValue(nodeId);
 }
 
 MonitoredItem* TmsClientObjectImpl::monitoredItemsCreateEvent(const EventMonitoredItemCreateRequest& item,
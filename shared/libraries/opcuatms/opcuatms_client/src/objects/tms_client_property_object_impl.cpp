@@ -47,7 +47,7 @@ ErrCode TmsClientPropertyObjectBaseImpl<Impl>::setPropertyValueInternal(IString*
 
                 lastProccessDescription = "Writting property value";
                 const auto variant = VariantConverter<IBaseObject>::ToVariant(value, nullptr, daqContext);
-                client->writeValue(it->second, variant);
+                clientContext->writeValue(it->second, variant);
                 return OPENDAQ_SUCCESS;
             }
 
@@ -112,7 +112,7 @@ ErrCode INTERFACE_FUNC TmsClientPropertyObjectBaseImpl<Impl>::getPropertyValue(I
     ErrCode errCode = daqTry([&]() {
         if (const auto& introIt = introspectionVariableIdMap.find(propertyNamePtr); introIt != introspectionVariableIdMap.cend())
         {
-            const auto variant = client->readValue(introIt->second);
+            const auto variant = clientContext->readValue(introIt->second);
             const auto object = VariantConverter<IBaseObject>::ToDaqObject(variant, daqContext);
             Impl::setProtectedPropertyValue(propertyName, object);
         }
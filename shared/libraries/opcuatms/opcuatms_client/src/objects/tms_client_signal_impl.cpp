@@ -176,7 +176,7 @@ ErrCode TmsClientSignalImpl::getLastValue(IBaseObject** value)
             try
             {
                 const auto valueNodeId = clientContext->getReferenceBrowser()->getChildNodeId(nodeId, nodeName);
-                OpcUaVariant opcUaVariant = client->readValue(*valueNodeId);
+                OpcUaVariant opcUaVariant = clientContext->readValue(valueNodeId);
                 if (!opcUaVariant.isNull())
                 {
                     BaseObjectPtr valuePtr = VariantConverter<IBaseObject, BaseObjectPtr>::ToDaqObject(opcUaVariant);
@@ -49,7 +49,7 @@ void TmsClientTagsImpl::refreshTags()
 {
     try
     {
-        const ListPtr<IString> tagValues = VariantConverter<IString>::ToDaqList(client->readValue(nodeId));
+        const ListPtr<IString> tagValues = VariantConverter<IString>::ToDaqList(clientContext->readValue(nodeId));
         this->tags.clear();
         for (const auto& tag : tagValues)
             this->tags.insert(tag);
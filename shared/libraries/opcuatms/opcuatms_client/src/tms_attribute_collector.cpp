@@ -28,11 +28,43 @@ TmsAttributeCollector::TmsAttributeCollector(const CachedReferenceBrowserPtr& br
 tsl::ordered_set<OpcUaAttribute> TmsAttributeCollector::collectAttributes(const OpcUaNodeId& nodeId)
 {
     attributes.clear();
+    collectNodeAttributes(nodeId);
+    return attributes;
+}
+
+tsl::ordered_set<OpcUaAttribute> TmsAttributeCollector::collectAttributes(const std::vector<OpcUaNodeId>& nodeIds)
+{
+    attributes.clear();
+
+    for (const auto& nodeId : nodeIds)
+        collectNodeAttributes(nodeId);
+
+    return attributes;
+}
+
+tsl::ordered_set<OpcUaAttribute> TmsAttributeCollector::collectFunctionBlockTypesAttributes(const OpcUaNodeId& typesFolderId)
+{
+    attributes.clear();
+
+    auto filter = BrowseFilter();
+    filter.direction = UA_BROWSEDIRECTION_FORWARD;
+    filter.referenceTypeId = OpcUaNodeId(UA_NS0ID_HASPROPERTY);
+    filter.nodeClass = UA_NODECLASS_VARIABLE;
+
+    const auto references = browser->browseFiltered(typesFolderId, filter);
 
+    for (const auto& [refNodeId, ref] : references.byNodeId)
+        collectFunctionBlockTypeAttributes(refNodeId);
+
+    return attributes;
+}
+
+void TmsAttributeCollector::collectNodeAttributes(const OpcUaNodeId& nodeId)
+{
     const auto typeDefinition = browser->getTypeDefinition(nodeId);
 
     if (typeDefinition.isNull())
-        return attributes;
+        return;
 
     if (typeEquals(typeDefinition, NodeIdDeviceType))
         collectDeviceAttributes(nodeId);
@@ -48,8 +80,6 @@ tsl::ordered_set<OpcUaAttribute> TmsAttributeCollector::collectAttributes(const
         collectPropertyObjectAttributes(nodeId);
     else if (isSubtypeOf(typeDefinition, NodeIdBaseVariableType))
         collectPropertyAttributes(nodeId);
-
-    return attributes;
 }
 
 void TmsAttributeCollector::collectDeviceAttributes(const OpcUaNodeId& nodeId)
@@ -83,6 +113,9 @@ void TmsAttributeCollector::collectDeviceAttributes(const OpcUaNodeId& nodeId)
 
     const auto methodSetId = browser->getChildNodeId(nodeId, "MethodSet");
     collectMethodSetNode(methodSetId);
+
+    if (browser->hasReference(nodeId, "Domain"))
+        attributes.insert({browser->getChildNodeId(nodeId, "Domain"), UA_ATTRIBUTEID_VALUE});
 }
 
 void TmsAttributeCollector::collectFunctionBlockAttributes(const OpcUaNodeId& nodeId)
@@ -209,6 +242,14 @@ void TmsAttributeCollector::collectVariableBlockAttributes(const OpcUaNodeId& no
     collectPropertyObjectAttributes(nodeId);
 }
 
+void TmsAttributeCollector::collectFunctionBlockTypeAttributes(const OpcUaNodeId& nodeId)
+{
+    attributes.insert({nodeId, UA_ATTRIBUTEID_VALUE});
+
+    if (browser->hasReference(nodeId, "DefaultConfig"))
+        collectPropertyObjectAttributes(browser->getChildNodeId(nodeId, "DefaultConfig"));
+}
+
 void TmsAttributeCollector::collectIoNode(const OpcUaNodeId& nodeId)
 {
     const auto& references = browser->browse(nodeId);
@@ -12,6 +12,9 @@
 
 
 #include <iostream>
+#include <filesystem>
+#include <deque>
+#include <unordered_set>
 #include <opcuatms_client/tms_attribute_collector.h>
 
 using namespace daq::opcua;
@@ -32,6 +35,18 @@ TmsClient::TmsClient(const ContextPtr& context,
 {
 }
 
+void TmsClient::setValueMonitoring(bool enabled, double samplingIntervalMs, size_t maxMonitoredValues)
+{
+    valueMonitoring = enabled;
+    monitoringSamplingInterval = samplingIntervalMs;
+    this->maxMonitoredValues = maxMonitoredValues;
+}
+
+void TmsClient::setBrowseCacheDirectory(const std::string& directory)
+{
+    browseCacheDirectory = directory;
+}
+
 daq::DevicePtr TmsClient::connect()
 {
     const auto startTime = std::chrono::steady_clock::now();
@@ -56,6 +71,14 @@ daq::DevicePtr TmsClient::connect()
     client->runIterate();
 
     tmsClientContext = std::make_shared<TmsClientContext>(client, context);
+    tmsClientContext->setValueMonitoring(valueMonitoring, monitoringSamplingInterval, maxMonitoredValues);
+
+    std::string browseCacheKey;
+    if (!browseCacheDirectory.empty())
+    {
+        browseCacheKey = getBrowseCacheKey(namespaces);
+        loadBrowseCache(browseCacheKey);
+    }
 
     OpcUaNodeId rootDeviceNodeId;
     std::string rootDeviceBrowseName;
@@ -64,6 +87,9 @@ daq::DevicePtr TmsClient::connect()
     const auto localId = getUniqueLocalId(rootDeviceBrowseName);
     auto device = TmsClientRootDevice(context, parent, localId, tmsClientContext, rootDeviceNodeId, createStreamingCallback);
 
+    if (!browseCacheKey.empty())
+        saveBrowseCache(browseCacheKey);
+
     const auto deviceInfo = device.getInfo();
     if (deviceInfo.hasProperty("OpenDaqPackageVersion"))
     {
@@ -100,6 +126,96 @@ void TmsClient::getRootDeviceNodeAttributes(OpcUaNodeId& nodeIdOut, std::string&
     browseNameOut = references.byBrowseName.begin().key();
 }
 
+std::string TmsClient::getBrowseCacheKey(const ListPtr<IString>& namespaces)
+{
+    try
+    {
+        // The start time changes whenever the server is restarted and its address space is rebuilt
+        const auto startTime = client->readValue(OpcUaNodeId(UA_NS0ID_SERVER_SERVERSTATUS_STARTTIME));
+        if (startTime->type != &UA_TYPES[UA_TYPES_DATETIME] || startTime->data == nullptr)
+            return {};
+
+        std::string key = opcUaUrl + ";" + std::to_string(*static_cast<UA_DateTime*>(startTime->data));
+        for (const auto& ns : namespaces)
+            key += ";" + ns.toStdString();
+
+        // Nodes added or removed while the server runs change the address space without a restart
+        key += ";" + std::to_string(getModelHash());
+
+        return key;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Failed to read OPC UA browse cache key for {}: {}", opcUaUrl, e.what());
+    }
+
+    return {};
+}
+
+size_t TmsClient::getModelHash()
+{
+    // Browsed through a separate browser, so that the references come from the server rather than the loaded cache.
+    // Browsing the device set fetches every node reachable from it, so the hash covers each node the cache can return.
+    CachedReferenceBrowser browser(client, tmsClientContext->getMaxNodesPerBrowse());
+    const auto deviceSetId = OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET);
+    browser.browse(deviceSetId);
+
+    std::string model;
+    std::unordered_set<OpcUaNodeId> visited{deviceSetId};
+    std::deque<OpcUaNodeId> queue{deviceSetId};
+    while (!queue.empty())
+    {
+        const auto nodeId = queue.front();
+        queue.pop_front();
+
+        model += nodeId.toString() + ":";
+        for (const auto& [childId, reference] : browser.browse(nodeId).byNodeId)
+        {
+            model += utils::ToStdString(reference->browseName.name) + "=" + childId.toString() + ";";
+            if (reference->isForward && visited.insert(childId).second)
+                queue.push_back(childId);
+        }
+        model += "\n";
+    }
+
+    return std::hash<std::string>{}(model);
+}
+
+std::string TmsClient::getBrowseCacheFilePath() const
+{
+    const auto fileName = "opcua_browse_" + std::to_string(std::hash<std::string>{}(opcUaUrl)) + ".cache";
+    return (std::filesystem::path(browseCacheDirectory) / fileName).string();
+}
+
+void TmsClient::loadBrowseCache(const std::string& cacheKey)
+{
+    if (cacheKey.empty())
+        return;
+
+    try
+    {
+        if (tmsClientContext->getReferenceBrowser()->loadFromFile(getBrowseCacheFilePath(), cacheKey))
+            LOG_D("Loaded OPC UA browse cache for {}", opcUaUrl);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Failed to load OPC UA browse cache for {}: {}", opcUaUrl, e.what());
+    }
+}
+
+void TmsClient::saveBrowseCache(const std::string& cacheKey)
+{
+    try
+    {
+        std::filesystem::create_directories(browseCacheDirectory);
+        tmsClientContext->getReferenceBrowser()->saveToFile(getBrowseCacheFilePath(), cacheKey);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Failed to save OPC UA browse cache for {}: {}", opcUaUrl, e.what());
+    }
+}
+
 StringPtr TmsClient::getUniqueLocalId(const StringPtr& localId, int iteration)
 {
     if (!parent.assigned())
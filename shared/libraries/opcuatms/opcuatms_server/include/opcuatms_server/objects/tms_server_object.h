@@ -129,16 +129,36 @@ protected:
             tmsObject->addHierarchicalReference(parentNodeId);
             return tmsObject;
         }
-        else
+
+        // components are registered later in slices while registration is deferred, see TmsServerContext
+        const auto requestedNodeId = RequestedNodeId<DAQ_T>{}(daqObject);
+        if (const auto deferredObject = findDeferredObject(requestedNodeId))
+        {
+            auto tmsObject = std::dynamic_pointer_cast<TMS_T>(deferredObject);
+            deferRegistration({}, nullptr, [tmsObject, parentNodeId]() { tmsObject->addHierarchicalReference(parentNodeId); });
+            return tmsObject;
+        }
+
+        auto tmsObject = std::make_shared<TMS_T>(daqObject, this->server, daqContext, tmsContext, std::forward<Params>(params)...);
+        auto registration = [tmsObject, parentNodeId, numberInList]()
         {
-            auto tmsObject = std::make_shared<TMS_T>(daqObject, this->server, daqContext, tmsContext, std::forward<Params>(params)...);
             tmsObject->registerOpcUaNode(parentNodeId);
             if(numberInList != std::numeric_limits<uint32_t>::max())
                 tmsObject->setNumberInList(numberInList);
-            return tmsObject;
-        }
+        };
+
+        if (!requestedNodeId.isNull() && isRegistrationDeferred())
+            deferRegistration(requestedNodeId, tmsObject, std::move(registration));
+        else
+            registration();
+
+        return tmsObject;
     }
 
+    bool isRegistrationDeferred() const;
+    TmsServerObjectPtr findDeferredObject(const opcua::OpcUaNodeId& nodeId) const;
+    void deferRegistration(const opcua::OpcUaNodeId& nodeId, const TmsServerObjectPtr& obj, std::function<void()> registration) const;
+
     opcua::OpcUaServerPtr server;
     std::string typeBrowseName;
     std::mutex valueMutex;
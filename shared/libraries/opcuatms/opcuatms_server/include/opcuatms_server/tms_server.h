@@ -21,6 +21,8 @@
 #include "opcuaserver/opcuaserver.h"
 #include <opcuatms_server/objects/tms_server_device.h>
 #include <opcuatms_server/tms_server_context.h>
+#include <mutex>
+#include <atomic>
 
 BEGIN_NAMESPACE_OPENDAQ_OPCUA
 
@@ -32,16 +34,26 @@ public:
     ~TmsServer();
 
     void setOpcUaPort(uint16_t port);
+    void setLazyNodeCreation(bool lazyNodeCreation);
     void start();
     void stop();
 
 protected:
+    void createDeviceNodes();
+    void createDeviceNodesSlice(const daq::opcua::tms::TmsServerContextPtr& nodesContext);
+    void removeDeviceNode(daq::opcua::tms::TmsServerDevice& tmsServerDevice);
+
     DevicePtr device;
     ContextPtr context;
     std::unique_ptr<daq::opcua::tms::TmsServerDevice> tmsDevice;
+    // device of which the nodes are being created lazily, accessed on the server thread only
+    std::unique_ptr<daq::opcua::tms::TmsServerDevice> pendingDevice;
     std::shared_ptr<daq::opcua::tms::TmsServerContext> tmsContext;
     daq::opcua::OpcUaServerPtr server;
     uint16_t opcUaPort = 4840;
+    bool lazyNodeCreation = false;
+    std::mutex deviceNodesSync;
+    std::atomic<bool> deviceNodesRequested = false;
 
 };
 
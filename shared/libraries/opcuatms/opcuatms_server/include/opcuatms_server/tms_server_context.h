@@ -19,6 +19,8 @@
 #include <opendaq/context_ptr.h>
 #include <opendaq/device_ptr.h>
 #include <opcuatms_server/objects/tms_server_object.h>
+#include <deque>
+#include <mutex>
 
 BEGIN_NAMESPACE_OPENDAQ_OPCUA_TMS
 
@@ -31,13 +33,34 @@ public:
     DevicePtr getRootDevice();
     ComponentPtr findComponent(const std::string& globalId);
 
+    // While deferred, components found below a registered node are queued instead of being registered
+    // recursively, so that a large tree can be registered in slices. Each queued registration creates
+    // a single component with its properties and queues the components below it.
+    void setRegistrationDeferred(bool deferred);
+    bool isRegistrationDeferred();
+    void deferRegistration(const opcua::OpcUaNodeId& nodeId, const TmsServerObjectPtr& obj, std::function<void()> registration);
+    TmsServerObjectPtr findDeferredObject(const opcua::OpcUaNodeId& nodeId);
+    bool runNextDeferredRegistration();
+    void clearDeferredRegistrations();
+
 private:
+    struct DeferredRegistration
+    {
+        opcua::OpcUaNodeId nodeId;
+        std::function<void()> registration;
+    };
+
     ContextPtr context;
     DevicePtr rootDevice;
 
     std::unordered_map<std::string, std::weak_ptr<tms::TmsServerObject>> idToObjMap;
     void coreEventCallback(ComponentPtr& component, CoreEventArgsPtr& eventArgs);
     std::string toRelativeGlobalId(const std::string& globalId);
+
+    std::mutex deferredSync;
+    bool registrationDeferred = false;
+    std::deque<DeferredRegistration> deferredRegistrations;
+    std::unordered_map<opcua::OpcUaNodeId, TmsServerObjectPtr> deferredObjects;
 };
 
 using TmsServerContextPtr = std::shared_ptr<TmsServerContext>;
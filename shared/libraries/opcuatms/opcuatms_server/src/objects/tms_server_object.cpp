@@ -1,4 +1,5 @@
 #include <opcuatms_server/objects/tms_server_object.h>
+#include <opcuatms_server/tms_server_context.h>
 #include <opendaq/instance_ptr.h>
 #include <opendaq/signal_ptr.h>
 #include <coreobjects/eval_value_ptr.h>
@@ -164,6 +165,21 @@ OpcUaNodeId TmsServerObject::findSignalNodeId(const SignalPtr& signal) const
     return findTmsObjectNodeId(signal);
 }
 
+bool TmsServerObject::isRegistrationDeferred() const
+{
+    return tmsContext && tmsContext->isRegistrationDeferred();
+}
+
+TmsServerObjectPtr TmsServerObject::findDeferredObject(const OpcUaNodeId& nodeId) const
+{
+    return tmsContext ? tmsContext->findDeferredObject(nodeId) : nullptr;
+}
+
+void TmsServerObject::deferRegistration(const OpcUaNodeId& nodeId, const TmsServerObjectPtr& obj, std::function<void()> registration) const
+{
+    tmsContext->deferRegistration(nodeId, obj, std::move(registration));
+}
+
 void TmsServerObject::bindCallbacksInternal()
 {
     if (hasChildNode("NumberInList"))
@@ -1,14 +1,19 @@
 #include <opendaq/packet.h>
 #include <opendaq/reader_factory.h>
 #include <opcuatms_server/tms_server.h>
+#include <opendaq/custom_log.h>
 #include <open62541/di_nodeids.h>
 #include <iostream>
+#include <chrono>
 
 using namespace daq::opcua;
 using namespace daq::opcua::tms;
 
 BEGIN_NAMESPACE_OPENDAQ_OPCUA
 
+// upper bound of the time the server thread spends creating lazy device nodes before serving requests again
+static constexpr std::chrono::milliseconds LazyNodeCreationSliceDuration{20};
+
 TmsServer::~TmsServer()
 {
     tmsContext = nullptr;
@@ -31,6 +36,11 @@ void TmsServer::setOpcUaPort(uint16_t port)
     this->opcUaPort = port;
 }
 
+void TmsServer::setLazyNodeCreation(bool lazyNodeCreation)
+{
+    this->lazyNodeCreation = lazyNodeCreation;
+}
+
 void TmsServer::start()
 {
     if (!device.assigned())
@@ -45,19 +55,111 @@ void TmsServer::start()
     tmsContext = std::make_shared<TmsServerContext>(context, device);
     auto signals = device.getSignals();
 
-    tmsDevice = std::make_unique<TmsServerDevice>(device, server, context, tmsContext);
-    tmsDevice->registerOpcUaNode(OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET));
-    tmsDevice->createNonhierarchicalReferences();
+    if (lazyNodeCreation)
+    {
+        // Device nodes are created when the first client session is activated. The session activation
+        // only posts the work, which creates the nodes on the server thread in bounded slices. Requests
+        // are served between the slices, clients connected while the tree is built see it grow.
+        auto createSessionContext = server->createSessionContextCallback;
+        server->createSessionContextCallback = [this, createSessionContext, nodesContext = tmsContext](const OpcUaNodeId& sessionId)
+        {
+            if (!deviceNodesRequested.exchange(true))
+                server->postToServerThread([this, nodesContext] { createDeviceNodesSlice(nodesContext); });
+
+            return createSessionContext(sessionId);
+        };
+    }
+    else
+    {
+        createDeviceNodes();
+    }
 
     server->start();
 }
 
+void TmsServer::createDeviceNodesSlice(const TmsServerContextPtr& nodesContext)
+{
+    const auto sliceEnd = std::chrono::steady_clock::now() + LazyNodeCreationSliceDuration;
+    bool pending = true;
+
+    try
+    {
+        // each registration creates a single component, the components below it are queued
+        nodesContext->setRegistrationDeferred(true);
+        if (!pendingDevice)
+        {
+            pendingDevice = std::make_unique<TmsServerDevice>(device, server, context, nodesContext);
+            pendingDevice->registerOpcUaNode(OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET));
+        }
+
+        while (pending && std::chrono::steady_clock::now() < sliceEnd)
+            pending = nodesContext->runNextDeferredRegistration();
+        nodesContext->setRegistrationDeferred(false);
+
+        if (!pending)
+            pendingDevice->createNonhierarchicalReferences();
+    }
+    catch ([[maybe_unused]] const std::exception& e)
+    {
+        const auto loggerComponent = context.getLogger().getOrAddComponent("OpcUaServer");
+        LOG_E("Failed to create OPC UA device nodes: {}", e.what());
+
+        nodesContext->setRegistrationDeferred(false);
+        nodesContext->clearDeferredRegistrations();
+        if (pendingDevice)
+            removeDeviceNode(*pendingDevice);
+        pendingDevice.reset();
+
+        // retried when the next session is activated
+        deviceNodesRequested = false;
+        return;
+    }
+
+    if (pending)
+    {
+        server->postToServerThread([this, nodesContext] { createDeviceNodesSlice(nodesContext); });
+        return;
+    }
+
+    std::scoped_lock lock(deviceNodesSync);
+    tmsDevice = std::move(pendingDevice);
+}
+
+void TmsServer::createDeviceNodes()
+{
+    std::scoped_lock lock(deviceNodesSync);
+    if (tmsDevice)
+        return;
+
+    auto newDevice = std::make_unique<TmsServerDevice>(device, server, context, tmsContext);
+    try
+    {
+        newDevice->registerOpcUaNode(OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET));
+        newDevice->createNonhierarchicalReferences();
+    }
+    catch (...)
+    {
+        removeDeviceNode(*newDevice);
+        throw;
+    }
+
+    tmsDevice = std::move(newDevice);
+}
+
+void TmsServer::removeDeviceNode(TmsServerDevice& tmsServerDevice)
+{
+    // removes the partially created device tree, so that it can be created again
+    if (const auto nodeId = tmsServerDevice.getNodeId(); !nodeId.isNull() && server->nodeExists(nodeId))
+        server->deleteNode(nodeId);
+}
+
 void TmsServer::stop()
 {
     if (server)
         server->stop();
 
     server.reset();
+    pendingDevice.reset();
     tmsDevice.reset();
 }
 
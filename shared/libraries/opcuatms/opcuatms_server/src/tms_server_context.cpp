@@ -33,6 +33,65 @@ ComponentPtr TmsServerContext::findComponent(const std::string& globalId)
     return rootDevice.findComponent(relativeGlobalId);
 }
 
+void TmsServerContext::setRegistrationDeferred(bool deferred)
+{
+    std::scoped_lock lock(deferredSync);
+    registrationDeferred = deferred;
+}
+
+bool TmsServerContext::isRegistrationDeferred()
+{
+    std::scoped_lock lock(deferredSync);
+    return registrationDeferred;
+}
+
+void TmsServerContext::deferRegistration(const opcua::OpcUaNodeId& nodeId, const TmsServerObjectPtr& obj, std::function<void()> registration)
+{
+    std::scoped_lock lock(deferredSync);
+    if (obj)
+        deferredObjects.insert({nodeId, obj});
+    deferredRegistrations.push_back({nodeId, std::move(registration)});
+}
+
+TmsServerObjectPtr TmsServerContext::findDeferredObject(const opcua::OpcUaNodeId& nodeId)
+{
+    if (nodeId.isNull())
+        return nullptr;
+
+    std::scoped_lock lock(deferredSync);
+    if (const auto it = deferredObjects.find(nodeId); it != deferredObjects.end())
+        return it->second;
+    return nullptr;
+}
+
+bool TmsServerContext::runNextDeferredRegistration()
+{
+    DeferredRegistration next;
+    {
+        std::scoped_lock lock(deferredSync);
+        if (deferredRegistrations.empty())
+            return false;
+
+        next = std::move(deferredRegistrations.front());
+        deferredRegistrations.pop_front();
+    }
+
+    next.registration();
+
+    // the node exists from now on and is found in the address space
+    std::scoped_lock lock(deferredSync);
+    if (!next.nodeId.isNull())
+        deferredObjects.erase(next.nodeId);
+    return true;
+}
+
+void TmsServerContext::clearDeferredRegistrations()
+{
+    std::scoped_lock lock(deferredSync);
+    deferredRegistrations.clear();
+    deferredObjects.clear();
+}
+
 void TmsServerContext::coreEventCallback(ComponentPtr& component, CoreEventArgsPtr& eventArgs)
 {
     if (!component.assigned())
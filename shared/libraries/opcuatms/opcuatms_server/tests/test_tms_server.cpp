@@ -5,6 +5,8 @@
 #include <tms_object_test.h>
 #include "test_helpers.h"
 #include <opcuaclient/cached_reference_browser.h>
+#include <chrono>
+#include <thread>
 
 using TmsServerTest = testing::Test;
 
@@ -13,6 +15,49 @@ using namespace daq::opcua;
 using namespace daq::opcua;
 using namespace test_helpers;
 
+// exposes the device nodes of the server's address space
+class LazyTmsServer : public TmsServer
+{
+public:
+    using TmsServer::TmsServer;
+
+    size_t getDeviceSetDeviceCount()
+    {
+        OpcUaObject<UA_BrowseDescription> browseDesc;
+        browseDesc->nodeId = OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET).copyAndGetDetachedValue();
+        browseDesc->referenceTypeId = OpcUaNodeId(UA_NS0ID_HASCOMPONENT).copyAndGetDetachedValue();
+        browseDesc->browseDirection = UA_BROWSEDIRECTION_FORWARD;
+        browseDesc->includeSubtypes = true;
+        browseDesc->resultMask = UA_BROWSERESULTMASK_TYPEDEFINITION;
+
+        const auto browseResult = server->browse(browseDesc);
+        const auto deviceType = OpcUaNodeId(NAMESPACE_DAQDEVICE, UA_DAQDEVICEID_DAQDEVICETYPE);
+
+        size_t count = 0;
+        for (size_t i = 0; i < browseResult->referencesSize; i++)
+        {
+            if (deviceType == browseResult->references[i].typeDefinition.nodeId)
+                count++;
+        }
+        return count;
+    }
+
+    // the device nodes are created in slices on the server thread after the first session is activated
+    bool waitForDeviceNodes(std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        const auto end = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < end)
+        {
+            {
+                std::scoped_lock lock(deviceNodesSync);
+                if (tmsDevice)
+                    return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+};
 
 TEST_F(TmsServerTest, Create)
 {
@@ -45,12 +90,37 @@ TEST_F(TmsServerTest, DeviceTopology)
     server.start();
 
     auto client = TmsObjectTest::CreateAndConnectTestClient();
+    ASSERT_TRUE(server.waitForDeviceNodes());
+
+    auto firstLvlDevices = BrowseSubDevices(client, OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET));
+    ASSERT_EQ(firstLvlDevices.size(), 1u);
+
+    auto secondLvlDevices = BrowseSubDevices(client, firstLvlDevices[0]);
+    ASSERT_EQ(secondLvlDevices.size(), 2u);
+}
+
+TEST_F(TmsServerTest, LazyNodeCreation)
+{
+    auto daqInstance = SetupInstance();
+    LazyTmsServer server(daqInstance);
+    server.setLazyNodeCreation(true);
+    server.start();
+
+    // no device nodes exist until a session is activated
+    ASSERT_EQ(server.getDeviceSetDeviceCount(), 0u);
+
+    auto client = TmsObjectTest::CreateAndConnectTestClient();
+    ASSERT_TRUE(server.waitForDeviceNodes());
 
     auto firstLvlDevices = BrowseSubDevices(client, OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET));
     ASSERT_EQ(firstLvlDevices.size(), 1u);
 
     auto secondLvlDevices = BrowseSubDevices(client, firstLvlDevices[0]);
     ASSERT_EQ(secondLvlDevices.size(), 2u);
+
+    auto secondClient = TmsObjectTest::CreateAndConnectTestClient();
+    ASSERT_EQ(BrowseSubDevices(secondClient, OpcUaNodeId(NAMESPACE_DI, UA_DIID_DEVICESET)).size(), 1u);
+    ASSERT_EQ(server.getDeviceSetDeviceCount(), 1u);
 }
 
 TEST_F(TmsServerTest, Channels)
@@ -16,6 +16,26 @@ struct RegisteredComponent
     ComponentPtr clientComponent;
 };
 
+// exposes the state of the value monitoring cache
+class MonitoringClientContext : public TmsClientContext
+{
+public:
+    using TmsClientContext::TmsClientContext;
+
+    bool isValueCached(const OpcUaNodeId& nodeId)
+    {
+        std::lock_guard guard(monitoredValuesMutex);
+        const auto it = monitoredValues.find(nodeId);
+        return it != monitoredValues.end() && it->second.valid;
+    }
+
+    size_t getMonitoredValueCount()
+    {
+        std::lock_guard guard(monitoredValuesMutex);
+        return monitoredValues.size();
+    }
+};
+
 class TmsComponentTest : public TmsObjectIntegrationTest
 {
 public:
@@ -74,6 +94,54 @@ TEST_F(TmsComponentTest, Active)
     ASSERT_EQ(component.serverComponent.getActive(), component.clientComponent.getActive());
 }
 
+TEST_F(TmsComponentTest, MonitoredValueRevalidatedAfterWrite)
+{
+    auto monitoringContext = std::make_shared<MonitoringClientContext>(client, ctx);
+    monitoringContext->setValueMonitoring(true, 10);
+
+    auto component = createTestComponent();
+    auto serverObject = TmsServerComponent(component, this->getServer(), ctx, serverContext);
+    const auto nodeId = serverObject.registerOpcUaNode();
+    const auto activeId = monitoringContext->getReferenceBrowser()->getChildNodeId(nodeId, "Active");
+
+    ASSERT_TRUE(monitoringContext->readValue(activeId).toBool());
+
+    // writing the current value produces no data change notification
+    monitoringContext->writeValue(activeId, OpcUaVariant(true));
+    ASSERT_TRUE(monitoringContext->isValueCached(activeId));
+    ASSERT_TRUE(monitoringContext->readValue(activeId).toBool());
+
+    monitoringContext->writeValue(activeId, OpcUaVariant(false));
+    ASSERT_TRUE(monitoringContext->isValueCached(activeId));
+    ASSERT_FALSE(monitoringContext->readValue(activeId).toBool());
+}
+
+TEST_F(TmsComponentTest, MonitoredValuesBounded)
+{
+    auto monitoringContext = std::make_shared<MonitoringClientContext>(client, ctx);
+    monitoringContext->setValueMonitoring(true, 10, 2);
+
+    auto component = createTestComponent();
+    auto serverObject = TmsServerComponent(component, this->getServer(), ctx, serverContext);
+    const auto nodeId = serverObject.registerOpcUaNode();
+    const auto browser = monitoringContext->getReferenceBrowser();
+    const auto activeId = browser->getChildNodeId(nodeId, "Active");
+    const auto visibleId = browser->getChildNodeId(nodeId, "Visible");
+    const auto fooId = browser->getChildNodeId(nodeId, "foo");
+
+    monitoringContext->readValue(activeId);
+    monitoringContext->readValue(visibleId);
+    monitoringContext->readValue(activeId);
+    ASSERT_EQ(monitoringContext->getMonitoredValueCount(), 2u);
+
+    // the least recently read node is no longer monitored
+    ASSERT_EQ(monitoringContext->readValue(fooId).toString(), "bar");
+    ASSERT_EQ(monitoringContext->getMonitoredValueCount(), 2u);
+    monitoringContext->writeValue(activeId, OpcUaVariant(false));
+    ASSERT_TRUE(monitoringContext->isValueCached(activeId));
+    ASSERT_FALSE(monitoringContext->isValueCached(visibleId));
+}
+
 TEST_F(TmsComponentTest, Tags)
 {
     auto component = registerTestComponent();
@@ -7,6 +7,7 @@
 #include <opendaq/search_filter_factory.h>
 #include <chrono>
 #include <thread>
+#include <filesystem>
 #include <testutils/test_comparators.h>
 
 using namespace daq;
@@ -320,6 +321,33 @@ TEST_F(TmsIntegrationTest, RemoveFunctionBlock)
     ASSERT_EQ(1, clientDevice.getFunctionBlocks().getCount());
 }
 
+TEST_F(TmsIntegrationTest, BrowseCacheInvalidatedByModelChange)
+{
+    const auto cacheDirectory = std::filesystem::temp_directory_path() / "opendaq_tms_browse_cache_test";
+    std::filesystem::remove_all(cacheDirectory);
+
+    InstancePtr device = createDevice();
+    TmsServer tmsServer(device);
+    tmsServer.start();
+
+    {
+        TmsClient tmsClient(device.getContext(), nullptr, OPC_URL, nullptr);
+        tmsClient.setBrowseCacheDirectory(cacheDirectory.string());
+        auto clientDevice = tmsClient.connect();
+        ASSERT_EQ(1, clientDevice.getFunctionBlocks().getCount());
+
+        // adds nodes to the address space without restarting the server
+        clientDevice.addFunctionBlock("mock_fb_uid");
+    }
+
+    TmsClient tmsClient(device.getContext(), nullptr, OPC_URL, nullptr);
+    tmsClient.setBrowseCacheDirectory(cacheDirectory.string());
+    auto clientDevice = tmsClient.connect();
+    ASSERT_EQ(2, clientDevice.getFunctionBlocks().getCount());
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
 TEST_F(TmsIntegrationTest, InputPortConnect)
 {
     InstancePtr device = createDevice();
@@ -13,6 +13,7 @@
 #include <opendaq/data_rule_factory.h>
 #include "tms_object_integration_test.h"
 #include <opendaq/reader_factory.h>
+#include <thread>
 
 using namespace daq;
 using namespace opcua::tms;
@@ -426,3 +427,31 @@ TEST_F(TmsSignalTest, GetValue)
 
     ASSERT_EQ(clientSignal.getLastValue(), 10.0);
 }
+
+TEST_F(TmsSignalTest, GetValueMonitored)
+{
+    auto dataDescriptor = DataDescriptorBuilder().setName("stub").setSampleType(SampleType::Float64).build();
+    const auto signal = SignalWithDescriptor(NullContext(), dataDescriptor, nullptr, "sig");
+
+    auto serverSignal = TmsServerSignal(signal, this->getServer(), ctx, serverContext);
+    auto nodeId = serverSignal.registerOpcUaNode();
+
+    clientContext->setValueMonitoring(true, 10);
+    SignalPtr clientSignal = TmsClientSignal(NullContext(), nullptr, "sig", clientContext, nodeId);
+
+    sendValueToSignal<double>(signal, 1.0);
+    ASSERT_EQ(clientSignal.getLastValue(), 1.0);
+
+    sendValueToSignal<double>(signal, 10.0);
+
+    BaseObjectPtr lastValue;
+    for (int i = 0; i < 200; ++i)
+    {
+        lastValue = clientSignal.getLastValue();
+        if (lastValue == 10.0)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(lastValue, 10.0);
+}
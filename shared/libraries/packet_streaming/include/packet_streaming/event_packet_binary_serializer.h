@@ -0,0 +1,47 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <packet_streaming/packet_streaming.h>
+#include <opendaq/event_packet_ptr.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <vector>
+
+namespace daq::packet_streaming
+{
+
+// event packet payload encodings, stored in the generic header version field
+#define PACKET_EVENT_VERSION_JSON   0x0
+#define PACKET_EVENT_VERSION_BINARY 0x1
+
+/*
+ * Compact binary encoding of data descriptor changed event packets. Descriptors using features
+ * outside of the supported subset (dimensions, struct fields, non-scalar rule or scaling parameters)
+ * and all other event types are reported as not serializable, in which case JSON is used instead.
+ */
+class EventPacketBinarySerializer
+{
+public:
+    static bool serialize(const EventPacketPtr& packet, std::vector<uint8_t>& output);
+    static EventPacketPtr deserialize(const void* data, size_t size);
+
+private:
+    static bool serializeDescriptor(const DataDescriptorPtr& descriptor, std::vector<uint8_t>& output);
+    static DataDescriptorPtr deserializeDescriptor(const uint8_t*& data, const uint8_t* end);
+};
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace daq::packet_streaming
+{
+
+/*
+ * Free-list of fixed-size memory blocks. Blocks are recycled instead of being returned
+ * to the heap, so the packet buffer records of a streaming session stop allocating once
+ * the session reaches its steady state. Requests of a size other than the block size
+ * (fixed by the first request) fall back to the global heap.
+ */
+class PacketBufferArena
+{
+public:
+    explicit PacketBufferArena(size_t maxFreeBlocks = 1024);
+    ~PacketBufferArena();
+
+    PacketBufferArena(const PacketBufferArena&) = delete;
+    PacketBufferArena& operator=(const PacketBufferArena&) = delete;
+
+    void* allocate(size_t size);
+    void deallocate(void* ptr, size_t size) noexcept;
+
+private:
+    std::mutex sync;
+    std::vector<void*> freeBlocks;
+    size_t blockSize;
+    size_t maxFreeBlocks;
+};
+
+using PacketBufferArenaPtr = std::shared_ptr<PacketBufferArena>;
+
+// Allocator used with std::allocate_shared, so the packet buffer and its shared pointer control block
+// are placed in a single arena block; the allocator copy stored in the control block keeps the arena alive
+template <typename T>
+class PacketBufferAllocator
+{
+public:
+    using value_type = T;
+
+    explicit PacketBufferAllocator(PacketBufferArenaPtr arena) noexcept
+        : arena(std::move(arena))
+    {
+    }
+
+    template <typename U>
+    PacketBufferAllocator(const PacketBufferAllocator<U>& other) noexcept
+        : arena(other.arena)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        arena->deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PacketBufferAllocator<U>& other) const noexcept
+    {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const PacketBufferAllocator<U>& other) const noexcept
+    {
+        return arena != other.arena;
+    }
+
+    PacketBufferArenaPtr arena;
+};
+
+}
@@ -29,6 +29,7 @@ enum PacketType: uint8_t { event = 0, data, release, alreadySent };
 
 #define PACKET_FLAG_CAN_RELEASE            0x1
 #define PACKET_FLAG_OFFSET_TYPE_MASK       (0x2 | 0x4)
+#define PACKET_FLAG_PAYLOAD_ENCODED        0x8
 
 #define PACKET_FLAG_OFFSET_TYPE_SHIFT      1
 
@@ -68,6 +69,8 @@ struct PacketBuffer
     PacketBuffer(const PacketBuffer&) = delete;
     PacketBuffer(PacketBuffer&& packetBuffer) noexcept;
     PacketBuffer(GenericPacketHeader* packetHeader, const void* payload, std::function<void()> onDestroy);
+    // header is placed in the inline header storage, payload memory is kept alive by the payload owner
+    PacketBuffer(const void* payload, BaseObjectPtr payloadOwner);
 
     GenericPacketHeader* packetHeader;
     const void* payload;
@@ -75,6 +78,23 @@ struct PacketBuffer
     std::function<void()> onDestroy;
     std::vector<uint32_t> additionalSignalIds;
 
+    union InlineHeader
+    {
+        GenericPacketHeader genericHeader;
+        DataPacketHeader dataHeader;
+        AlreadySentPacketHeader alreadySentHeader;
+    } inlineHeader;
+    BaseObjectPtr payloadOwner;
+    std::vector<Int> releasedPacketIds;
+    // payload memory owned by the buffer itself, such as encoded payloads or payloads retained by the client
+    std::vector<uint8_t> payloadStorage;
+    // keeps externally owned payload memory valid, such as a shared memory ring slot; packets created from
+    // such a buffer reference the payload instead of copying it
+    std::shared_ptr<void> payloadHolder;
+
+    // copies the payload into the payload storage, so it outlives the memory it was received in
+    void retainPayload();
+
     ~PacketBuffer();
 };
 
@@ -17,9 +17,14 @@
 #pragma once
 
 #include <packet_streaming/packet_streaming.h>
+#include <packet_streaming/packet_buffer_arena.h>
+#include <packet_streaming/event_packet_binary_serializer.h>
+#include <packet_streaming/payload_codec.h>
 #include <opendaq/data_packet_ptr.h>
+#include <opendaq/allocator_ptr.h>
 #include "opendaq/event_packet_ptr.h"
 #include <queue>
+#include <atomic>
 
 namespace daq::packet_streaming
 {
@@ -32,34 +37,85 @@ struct DataDescriptorEventPacket
     DataDescriptorPtr domainDescriptor;
 };
 
+// Packets kept by the client until the server releases them
+struct ReferenceStatistics
+{
+    size_t referencedPackets;
+    size_t referencedBytes;
+    size_t waitingPacketBuffers;
+    size_t referenceLimitHits;
+};
+
+// Event packets received by the client per encoding
+struct EventPacketStatistics
+{
+    size_t jsonEncodedPackets;
+    size_t binaryEncodedPackets;
+};
+
 class PacketStreamingClient
 {
 public:
-    PacketStreamingClient();
+    // referenced packets and packet buffers waiting for domain packets are bounded together
+    static constexpr size_t DefaultMaxReferences = 65536;
 
+    // data packets are allocated with the given allocator, or the default one if not assigned
+    explicit PacketStreamingClient(AllocatorPtr allocator = nullptr);
+
+    // a packet that would exceed the bound is rejected with an exception, as the server is expected to
+    // release packets long before; 0 disables the bound
+    void setMaxReferences(size_t maxReferences);
+
+    // the payload of the packet buffer is only required to be valid for the duration of the call,
+    // it is copied into the data packet memory or retained by the buffer if it has to wait
     void addPacketBuffer(const PacketBufferPtr& packetBuffer);
 
     std::tuple<uint32_t, PacketPtr> getNextDaqPacket();
 
     bool areReferencesCleared() const;
+    // safe to call from any thread
+    ReferenceStatistics getReferenceStatistics() const;
+    // safe to call from any thread
+    EventPacketStatistics getEventPacketStatistics() const;
 
     EventPacketPtr getDataDescriptorChangedEventPacket(uint32_t signalId) const;
 private:
+    AllocatorPtr allocator;
     DeserializerPtr jsonDeserializer;
     std::queue<std::tuple<uint32_t, PacketPtr>> queue;
     std::unordered_map<uint32_t, DataDescriptorPtr> dataDescriptors;
     std::unordered_map<uint32_t, DataDescriptorPtr> domainDescriptors;
 
-    std::unordered_map<Int, DataPacketPtr> referencedPackets;
-    std::unordered_map<Int, PacketBufferPtr> referencedPacketBuffers;
-    std::unordered_map<Int, std::vector<PacketBufferPtr>> packetBuffersWaitingForDomainPackets;
+    // map nodes are recycled by per-map arenas, so a steady stream of referenced packets does not allocate
+    template <typename T>
+    using ReferenceMap = std::unordered_map<Int, T, std::hash<Int>, std::equal_to<Int>, PacketBufferAllocator<std::pair<const Int, T>>>;
+
+    ReferenceMap<DataPacketPtr> referencedPackets;
+    ReferenceMap<PacketBufferPtr> referencedPacketBuffers;
+    ReferenceMap<std::vector<PacketBufferPtr>> packetBuffersWaitingForDomainPackets;
+
+    std::atomic<size_t> referencedPacketCount;
+    std::atomic<size_t> referencedBytes;
+    std::atomic<size_t> waitingPacketBufferCount;
+    std::atomic<size_t> referenceLimitHitCount;
+    size_t maxReferences;
+    std::atomic<size_t> jsonEventPacketCount;
+    std::atomic<size_t> binaryEventPacketCount;
 
     mutable std::mutex descriptorsSync;
 
     void addEventPacketBuffer(const PacketBufferPtr& packetBuffer);
     DataPacketPtr addDataPacketBuffer(const PacketBufferPtr& packetBuffer, const DataPacketPtr& domainPacket);
+    void retainPayloadInPacketMemory(const PacketBufferPtr& packetBuffer);
     void addReleasePacketBuffer(const PacketBufferPtr& packetBuffer);
     void addAlreadySentPacketBuffer(const PacketBufferPtr& packetBuffer);
+
+    void addReferencedPacket(Int packetId, const DataPacketPtr& packet);
+    void eraseReferencedPacket(ReferenceMap<DataPacketPtr>::iterator packetIt);
+    void updateWaitingPacketBufferCount();
+    void checkReferenceLimit();
+    template <typename T>
+    static ReferenceMap<T> createReferenceMap();
 };
 
 }
@@ -17,9 +17,14 @@
 #pragma once
 
 #include <packet_streaming/packet_streaming.h>
+#include <packet_streaming/packet_buffer_arena.h>
+#include <packet_streaming/event_packet_binary_serializer.h>
+#include <packet_streaming/payload_codec.h>
 #include <opendaq/data_packet_ptr.h>
 #include <opendaq/event_packet_ptr.h>
 #include <queue>
+#include <atomic>
+#include <chrono>
 
 namespace daq::packet_streaming
 {
@@ -29,40 +34,74 @@ struct PacketCollection
     std::mutex sync;
     std::unordered_set<Int> sent;
     std::vector<Int> readyForRelease;
+    // referenced by the client until the release packet is sent
+    size_t readyForReleaseBytes{0};
+    std::chrono::steady_clock::time_point firstReadyForRelease;
 };
 
 using PacketCollectionPtr = std::shared_ptr<PacketCollection>;
     
 enum class ReleaseAction { markForRelease, subscribe, alreadySent };
 
+// Result of encoding a single packet once for all sessions it is streamed to.
+// The encoded buffer is immutable once created and is queued by every session that sends the full packet;
+// sessions that sent the packet for the first time share a single destruct notification.
+// Data packets with an encoded payload are shared separately among sessions with payload encoding enabled.
+// Sessions may add the same packet concurrently, the first one encodes it while holding the lock.
+struct SharedPacketEncoding
+{
+    std::mutex sync;
+    PacketBufferPtr packetBuffer;
+    PacketBufferPtr encodedPacketBuffer;
+    std::vector<PacketCollectionPtr> destructSubscribers;
+};
+
 class PacketStreamingServer
 {
 public:
-    PacketStreamingServer(size_t releaseThreshold = 1);
+    // release packets are sent once the threshold count of released packets is reached; optionally also
+    // once the oldest of them waits for max delay, or once their payloads reach max bytes (0 disables)
+    PacketStreamingServer(size_t releaseThreshold = 1,
+                          std::chrono::milliseconds releaseMaxDelay = std::chrono::milliseconds(0),
+                          size_t releaseMaxBytes = 0);
 
     void addDaqPacket(const uint32_t signalId, const PacketPtr& packet);
     void addDaqPacket(const uint32_t signalId, PacketPtr&& packet);
+    void addDaqPacket(const uint32_t signalId, const PacketPtr& packet, SharedPacketEncoding& sharedEncoding);
+    static void completeSharedEncoding(const PacketPtr& packet, SharedPacketEncoding& sharedEncoding);
     PacketBufferPtr getNextPacketBuffer();
 
     void checkAndSendReleasePacket(bool force);
+    void setEventPacketVersion(uint8_t version);
+    void setPayloadEncoding(bool enabled);
     void addAlreadySentPacket(uint32_t signalId, Int packetId, Int domainPacketId, bool markForRelease);
 
 private:
     SerializerPtr jsonSerializer;
-    std::queue<PacketBufferPtr> queue;
+    // drained completely after each added packet, so the vector keeps its capacity instead of reallocating
+    std::vector<PacketBufferPtr> queue;
+    size_t queueReadPosition;
+    PacketBufferArenaPtr packetBufferArena;
     std::unordered_map<uint32_t, DataDescriptorPtr> dataDescriptors;
     PacketCollectionPtr packetCollection;
     size_t releaseThreshold;
+    std::chrono::milliseconds releaseMaxDelay;
+    size_t releaseMaxBytes;
+    std::atomic<uint8_t> eventPacketVersion;
+    std::atomic<bool> payloadEncoding;
+    std::unordered_map<uint32_t, SampleType> payloadSampleTypes;
 
-    void addEventPacket(const uint32_t signalId, const EventPacketPtr& packet);
+    PacketBufferPtr createPacketBuffer(const void* payload, BaseObjectPtr payloadOwner);
+    void addEventPacket(const uint32_t signalId, const EventPacketPtr& packet, SharedPacketEncoding* sharedEncoding = nullptr);
     template <bool CheckRefCount>
     static bool canReleasePacket(const DataPacketPtr& packet);
-    bool shouldSendPacket(const DataPacketPtr& packet, Int packetId, bool markForRelease) const;
+    bool shouldSendPacket(const DataPacketPtr& packet, Int packetId, bool markForRelease, SharedPacketEncoding* sharedEncoding) const;
+    static void subscribeForRelease(const DataPacketPtr& packet, Int packetId, std::vector<PacketCollectionPtr> packetCollections);
     static void setOffset(const DataPacketPtr& packet, DataPacketHeader* packetHeader);
     static Int getDomainPacketId(const DataPacketPtr& packet);
 
     template <class DataPacket>
-    void addDataPacket(const uint32_t signalId, DataPacket&& packet);
+    void addDataPacket(const uint32_t signalId, DataPacket&& packet, SharedPacketEncoding* sharedEncoding = nullptr);
 };
 
 }
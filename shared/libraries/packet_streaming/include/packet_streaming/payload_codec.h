@@ -0,0 +1,38 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <packet_streaming/packet_streaming.h>
+#include <opendaq/sample_type.h>
+#include <vector>
+
+namespace daq::packet_streaming
+{
+
+/*
+ * Lossless codec for data packet payloads. Integer samples are encoded as zigzag varint deltas
+ * to the previous sample, floating point samples as varints of the XOR with the previous sample.
+ * Encoding is skipped for unsupported sample types and for payloads that would not get smaller.
+ */
+class PayloadCodec
+{
+public:
+    static bool encode(SampleType sampleType, const void* data, size_t size, std::vector<uint8_t>& output);
+    static void decode(const void* data, size_t size, void* output, size_t outputSize);
+};
+
+}
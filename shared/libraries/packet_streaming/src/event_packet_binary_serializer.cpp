@@ -0,0 +1,347 @@
+#include <packet_streaming/event_packet_binary_serializer.h>
+#include <opendaq/event_packet_ids.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/packet_factory.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/data_rule_factory.h>
+#include <opendaq/range_factory.h>
+#include <opendaq/scaling_factory.h>
+#include <coreobjects/unit_factory.h>
+#include <coretypes/ratio_factory.h>
+#include <coretypes/boolean_factory.h>
+#include <coretypes/integer_factory.h>
+#include <coretypes/float_factory.h>
+#include <cstring>
+
+namespace daq::packet_streaming
+{
+
+namespace
+{
+
+enum EventKind : uint8_t { dataDescriptorChanged = 0 };
+
+enum DescriptorField : uint8_t
+{
+    name = 0x1,
+    unit = 0x2,
+    valueRange = 0x4,
+    rule = 0x8,
+    origin = 0x10,
+    tickResolution = 0x20,
+    postScaling = 0x40,
+    metadata = 0x80
+};
+
+enum ValueTag : uint8_t { intValue = 0, floatValue, boolValue, stringValue };
+
+template <typename T>
+void write(std::vector<uint8_t>& output, T value)
+{
+    const auto position = output.size();
+    output.resize(position + sizeof(T));
+    std::memcpy(output.data() + position, &value, sizeof(T));
+}
+
+void writeString(std::vector<uint8_t>& output, const StringPtr& value)
+{
+    const auto length = static_cast<uint32_t>(value.getLength());
+    write(output, length);
+    output.insert(output.end(), value.getCharPtr(), value.getCharPtr() + length);
+}
+
+bool writeValue(std::vector<uint8_t>& output, const BaseObjectPtr& value)
+{
+    if (!value.assigned())
+        return false;
+
+    switch (value.getCoreType())
+    {
+        case ctInt:
+            write(output, ValueTag::intValue);
+            write(output, static_cast<Int>(value));
+            return true;
+        case ctFloat:
+            write(output, ValueTag::floatValue);
+            write(output, static_cast<Float>(value));
+            return true;
+        case ctBool:
+            write(output, ValueTag::boolValue);
+            write(output, static_cast<uint8_t>(static_cast<Bool>(value) ? 1 : 0));
+            return true;
+        case ctString:
+            write(output, ValueTag::stringValue);
+            writeString(output, value);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool writeParameters(std::vector<uint8_t>& output, const DictPtr<IString, IBaseObject>& parameters)
+{
+    if (!parameters.assigned())
+    {
+        write(output, static_cast<uint32_t>(0));
+        return true;
+    }
+
+    write(output, static_cast<uint32_t>(parameters.getCount()));
+    for (const auto& [key, value] : parameters)
+    {
+        writeString(output, key);
+        if (!writeValue(output, value))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename T>
+T read(const uint8_t*& data, const uint8_t* end)
+{
+    if (static_cast<size_t>(end - data) < sizeof(T))
+        throw PacketStreamingException("Binary event packet truncated");
+
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+}
+
+StringPtr readString(const uint8_t*& data, const uint8_t* end)
+{
+    const auto length = read<uint32_t>(data, end);
+    if (static_cast<size_t>(end - data) < length)
+        throw PacketStreamingException("Binary event packet truncated");
+
+    auto value = String(std::string(reinterpret_cast<const char*>(data), length));
+    data += length;
+    return value;
+}
+
+BaseObjectPtr readValue(const uint8_t*& data, const uint8_t* end)
+{
+    switch (read<ValueTag>(data, end))
+    {
+        case ValueTag::intValue:
+            return Integer(read<Int>(data, end));
+        case ValueTag::floatValue:
+            return Floating(read<Float>(data, end));
+        case ValueTag::boolValue:
+            return Boolean(read<uint8_t>(data, end) != 0);
+        case ValueTag::stringValue:
+            return readString(data, end);
+        default:
+            throw PacketStreamingException("Unknown binary event packet value");
+    }
+}
+
+DictPtr<IString, IBaseObject> readParameters(const uint8_t*& data, const uint8_t* end)
+{
+    auto parameters = Dict<IString, IBaseObject>();
+    const auto count = read<uint32_t>(data, end);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto key = readString(data, end);
+        parameters[key] = readValue(data, end);
+    }
+
+    parameters.freeze();
+    return parameters;
+}
+
+}
+
+bool EventPacketBinarySerializer::serialize(const EventPacketPtr& packet, std::vector<uint8_t>& output)
+{
+    if (packet.getEventId() != event_packet_id::DATA_DESCRIPTOR_CHANGED)
+        return false;
+
+    output.clear();
+    write(output, EventKind::dataDescriptorChanged);
+
+    const auto parameters = packet.getParameters();
+    for (const auto& paramName : {event_packet_param::DATA_DESCRIPTOR, event_packet_param::DOMAIN_DATA_DESCRIPTOR})
+    {
+        const DataDescriptorPtr descriptor = parameters.get(paramName);
+        write(output, static_cast<uint8_t>(descriptor.assigned() ? 1 : 0));
+        if (descriptor.assigned() && !serializeDescriptor(descriptor, output))
+            return false;
+    }
+
+    return true;
+}
+
+EventPacketPtr EventPacketBinarySerializer::deserialize(const void* data, size_t size)
+{
+    auto current = static_cast<const uint8_t*>(data);
+    const auto end = current + size;
+
+    if (read<EventKind>(current, end) != EventKind::dataDescriptorChanged)
+        throw PacketStreamingException("Unknown binary event packet");
+
+    DataDescriptorPtr valueDescriptor;
+    if (read<uint8_t>(current, end) != 0)
+        valueDescriptor = deserializeDescriptor(current, end);
+
+    DataDescriptorPtr domainDescriptor;
+    if (read<uint8_t>(current, end) != 0)
+        domainDescriptor = deserializeDescriptor(current, end);
+
+    return DataDescriptorChangedEventPacket(valueDescriptor, domainDescriptor);
+}
+
+bool EventPacketBinarySerializer::serializeDescriptor(const DataDescriptorPtr& descriptor, std::vector<uint8_t>& output)
+{
+    const auto dimensions = descriptor.getDimensions();
+    const auto structFields = descriptor.getStructFields();
+    if ((dimensions.assigned() && dimensions.getCount() > 0) || (structFields.assigned() && structFields.getCount() > 0))
+        return false;
+
+    const auto descriptorName = descriptor.getName();
+    const auto descriptorUnit = descriptor.getUnit();
+    const auto descriptorValueRange = descriptor.getValueRange();
+    const auto descriptorRule = descriptor.getRule();
+    const auto descriptorOrigin = descriptor.getOrigin();
+    const auto descriptorTickResolution = descriptor.getTickResolution();
+    const auto descriptorPostScaling = descriptor.getPostScaling();
+    const auto descriptorMetadata = descriptor.getMetadata();
+
+    uint8_t fields = 0;
+    fields |= descriptorName.assigned() ? DescriptorField::name : 0;
+    fields |= descriptorUnit.assigned() ? DescriptorField::unit : 0;
+    fields |= descriptorValueRange.assigned() ? DescriptorField::valueRange : 0;
+    fields |= descriptorRule.assigned() ? DescriptorField::rule : 0;
+    fields |= descriptorOrigin.assigned() ? DescriptorField::origin : 0;
+    fields |= descriptorTickResolution.assigned() ? DescriptorField::tickResolution : 0;
+    fields |= descriptorPostScaling.assigned() ? DescriptorField::postScaling : 0;
+    fields |= descriptorMetadata.assigned() ? DescriptorField::metadata : 0;
+
+    write(output, fields);
+    write(output, static_cast<uint32_t>(descriptor.getSampleType()));
+
+    if (descriptorName.assigned())
+        writeString(output, descriptorName);
+
+    if (descriptorUnit.assigned())
+    {
+        write(output, static_cast<Int>(descriptorUnit.getId()));
+        writeString(output, descriptorUnit.getSymbol());
+        writeString(output, descriptorUnit.getName());
+        writeString(output, descriptorUnit.getQuantity());
+    }
+
+    if (descriptorValueRange.assigned())
+    {
+        if (!writeValue(output, descriptorValueRange.getLowValue()) || !writeValue(output, descriptorValueRange.getHighValue()))
+            return false;
+    }
+
+    if (descriptorRule.assigned())
+    {
+        write(output, static_cast<uint32_t>(descriptorRule.getType()));
+        if (!writeParameters(output, descriptorRule.getParameters()))
+            return false;
+    }
+
+    if (descriptorOrigin.assigned())
+        writeString(output, descriptorOrigin);
+
+    if (descriptorTickResolution.assigned())
+    {
+        write(output, static_cast<Int>(descriptorTickResolution.getNumerator()));
+        write(output, static_cast<Int>(descriptorTickResolution.getDenominator()));
+    }
+
+    if (descriptorPostScaling.assigned())
+    {
+        write(output, static_cast<uint32_t>(descriptorPostScaling.getInputSampleType()));
+        write(output, static_cast<uint32_t>(descriptorPostScaling.getOutputSampleType()));
+        write(output, static_cast<uint32_t>(descriptorPostScaling.getType()));
+        if (!writeParameters(output, descriptorPostScaling.getParameters()))
+            return false;
+    }
+
+    if (descriptorMetadata.assigned())
+    {
+        write(output, static_cast<uint32_t>(descriptorMetadata.getCount()));
+        for (const auto& [key, value] : descriptorMetadata)
+        {
+            writeString(output, key);
+            writeString(output, value);
+        }
+    }
+
+    return true;
+}
+
+DataDescriptorPtr EventPacketBinarySerializer::deserializeDescriptor(const uint8_t*& data, const uint8_t* end)
+{
+    const auto fields = read<uint8_t>(data, end);
+    auto builder = DataDescriptorBuilder().setSampleType(static_cast<SampleType>(read<uint32_t>(data, end)));
+
+    if (fields & DescriptorField::name)
+        builder.setName(readString(data, end));
+
+    if (fields & DescriptorField::unit)
+    {
+        const auto id = read<Int>(data, end);
+        const auto symbol = readString(data, end);
+        const auto unitName = readString(data, end);
+        const auto quantity = readString(data, end);
+        builder.setUnit(Unit(symbol, id, unitName, quantity));
+    }
+
+    if (fields & DescriptorField::valueRange)
+    {
+        const NumberPtr low = readValue(data, end);
+        const NumberPtr high = readValue(data, end);
+        builder.setValueRange(Range(low, high));
+    }
+
+    if (fields & DescriptorField::rule)
+    {
+        const auto type = static_cast<DataRuleType>(read<uint32_t>(data, end));
+        builder.setRule(DataRuleBuilder().setType(type).setParameters(readParameters(data, end)).build());
+    }
+
+    if (fields & DescriptorField::origin)
+        builder.setOrigin(readString(data, end));
+
+    if (fields & DescriptorField::tickResolution)
+    {
+        const auto numerator = read<Int>(data, end);
+        const auto denominator = read<Int>(data, end);
+        builder.setTickResolution(Ratio(numerator, denominator));
+    }
+
+    if (fields & DescriptorField::postScaling)
+    {
+        const auto inputType = static_cast<SampleType>(read<uint32_t>(data, end));
+        const auto outputType = static_cast<ScaledSampleType>(read<uint32_t>(data, end));
+        const auto scalingType = static_cast<ScalingType>(read<uint32_t>(data, end));
+        builder.setPostScaling(ScalingBuilder()
+                                   .setInputDataType(inputType)
+                                   .setOutputDataType(outputType)
+                                   .setScalingType(scalingType)
+                                   .setParameters(readParameters(data, end))
+                                   .build());
+    }
+
+    if (fields & DescriptorField::metadata)
+    {
+        auto metadata = Dict<IString, IString>();
+        const auto count = read<uint32_t>(data, end);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const auto key = readString(data, end);
+            metadata[key] = readString(data, end);
+        }
+        builder.setMetadata(metadata);
+    }
+
+    return builder.build();
+}
+
+}
@@ -0,0 +1,52 @@
+#include <packet_streaming/packet_buffer_arena.h>
+#include <new>
+
+namespace daq::packet_streaming
+{
+
+PacketBufferArena::PacketBufferArena(size_t maxFreeBlocks)
+    : blockSize(0)
+    , maxFreeBlocks(maxFreeBlocks)
+{
+    freeBlocks.reserve(maxFreeBlocks);
+}
+
+PacketBufferArena::~PacketBufferArena()
+{
+    for (const auto block : freeBlocks)
+        ::operator delete(block);
+}
+
+void* PacketBufferArena::allocate(size_t size)
+{
+    {
+        std::scoped_lock lock(sync);
+        if (blockSize == 0)
+            blockSize = size;
+
+        if (size == blockSize && !freeBlocks.empty())
+        {
+            const auto block = freeBlocks.back();
+            freeBlocks.pop_back();
+            return block;
+        }
+    }
+
+    return ::operator new(size);
+}
+
+void PacketBufferArena::deallocate(void* ptr, size_t size) noexcept
+{
+    {
+        std::scoped_lock lock(sync);
+        if (size == blockSize && freeBlocks.size() < maxFreeBlocks)
+        {
+            freeBlocks.push_back(ptr);
+            return;
+        }
+    }
+
+    ::operator delete(ptr);
+}
+
+}
@@ -10,22 +10,49 @@ PacketBuffer::PacketBuffer(GenericPacketHeader* packetHeader, const void* payloa
 {
 }
 
+PacketBuffer::PacketBuffer(const void* payload, BaseObjectPtr payloadOwner)
+    : packetHeader(&inlineHeader.genericHeader)
+    , payload(payload)
+    , payloadOwner(std::move(payloadOwner))
+{
+}
+
 
 PacketBuffer::PacketBuffer(PacketBuffer&& packetBuffer) noexcept
 {
-    packetHeader = packetBuffer.packetHeader;
+    inlineHeader = packetBuffer.inlineHeader;
+    if (packetBuffer.packetHeader == &packetBuffer.inlineHeader.genericHeader)
+        packetHeader = &inlineHeader.genericHeader;
+    else
+        packetHeader = packetBuffer.packetHeader;
     payload = packetBuffer.payload;
 
-    onDestroy = packetBuffer.onDestroy;
+    onDestroy = std::move(packetBuffer.onDestroy);
+    additionalSignalIds = std::move(packetBuffer.additionalSignalIds);
+    payloadOwner = std::move(packetBuffer.payloadOwner);
+    releasedPacketIds = std::move(packetBuffer.releasedPacketIds);
+    payloadStorage = std::move(packetBuffer.payloadStorage);
+    payloadHolder = std::move(packetBuffer.payloadHolder);
 
-    packetBuffer.onDestroy = [](){};
+    packetBuffer.onDestroy = nullptr;
     packetBuffer.packetHeader = nullptr;
     packetBuffer.payload = nullptr;
 }
 
+void PacketBuffer::retainPayload()
+{
+    if (payload == nullptr || payload == payloadStorage.data() || payloadHolder)
+        return;
+
+    const auto bytes = static_cast<const uint8_t*>(payload);
+    payloadStorage.assign(bytes, bytes + packetHeader->payloadSize);
+    payload = payloadStorage.data();
+}
+
 PacketBuffer::~PacketBuffer()
 {
-    onDestroy();
+    if (onDestroy)
+        onDestroy();
 }
 
 PacketStreamingException::PacketStreamingException(const std::string& msg)
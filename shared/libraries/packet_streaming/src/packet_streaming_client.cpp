@@ -3,13 +3,37 @@
 #include <opendaq/event_packet_params.h>
 #include <opendaq/packet_factory.h>
 #include <opendaq/deleter_factory.h>
+#include <cstring>
 
 namespace daq::packet_streaming
 {
 
-PacketStreamingClient::PacketStreamingClient()
-    : jsonDeserializer(JsonDeserializer())
+template <typename T>
+PacketStreamingClient::ReferenceMap<T> PacketStreamingClient::createReferenceMap()
 {
+    using Allocator = PacketBufferAllocator<std::pair<const Int, T>>;
+    return ReferenceMap<T>(0, std::hash<Int>(), std::equal_to<Int>(), Allocator(std::make_shared<PacketBufferArena>()));
+}
+
+PacketStreamingClient::PacketStreamingClient(AllocatorPtr allocator)
+    : allocator(std::move(allocator))
+    , jsonDeserializer(JsonDeserializer())
+    , referencedPackets(createReferenceMap<DataPacketPtr>())
+    , referencedPacketBuffers(createReferenceMap<PacketBufferPtr>())
+    , packetBuffersWaitingForDomainPackets(createReferenceMap<std::vector<PacketBufferPtr>>())
+    , referencedPacketCount(0)
+    , referencedBytes(0)
+    , waitingPacketBufferCount(0)
+    , referenceLimitHitCount(0)
+    , maxReferences(DefaultMaxReferences)
+    , jsonEventPacketCount(0)
+    , binaryEventPacketCount(0)
+{
+}
+
+void PacketStreamingClient::setMaxReferences(size_t maxReferences)
+{
+    this->maxReferences = maxReferences;
 }
 
 void PacketStreamingClient::addPacketBuffer(const PacketBufferPtr& packetBuffer)
@@ -46,6 +70,51 @@ bool PacketStreamingClient::areReferencesCleared() const
     return (referencedPacketBuffers.empty() && referencedPackets.empty() && packetBuffersWaitingForDomainPackets.empty());
 }
 
+ReferenceStatistics PacketStreamingClient::getReferenceStatistics() const
+{
+    return {referencedPacketCount, referencedBytes, waitingPacketBufferCount, referenceLimitHitCount};
+}
+
+EventPacketStatistics PacketStreamingClient::getEventPacketStatistics() const
+{
+    return {jsonEventPacketCount, binaryEventPacketCount};
+}
+
+void PacketStreamingClient::checkReferenceLimit()
+{
+    if (maxReferences == 0 || referencedPackets.size() + referencedPacketBuffers.size() < maxReferences)
+        return;
+
+    referenceLimitHitCount++;
+    throw PacketStreamingException("Limit of " + std::to_string(maxReferences) + " packets referenced by the client reached");
+}
+
+void PacketStreamingClient::addReferencedPacket(Int packetId, const DataPacketPtr& packet)
+{
+    if (referencedPackets.count(packetId) == 0)
+        checkReferenceLimit();
+
+    if (referencedPackets.insert({packetId, packet}).second)
+    {
+        referencedPacketCount = referencedPackets.size();
+        if (packet.getRawData() != nullptr)
+            referencedBytes += packet.getRawDataSize();
+    }
+}
+
+void PacketStreamingClient::eraseReferencedPacket(ReferenceMap<DataPacketPtr>::iterator packetIt)
+{
+    if (packetIt->second.getRawData() != nullptr)
+        referencedBytes -= packetIt->second.getRawDataSize();
+    referencedPackets.erase(packetIt);
+    referencedPacketCount = referencedPackets.size();
+}
+
+void PacketStreamingClient::updateWaitingPacketBufferCount()
+{
+    waitingPacketBufferCount = referencedPacketBuffers.size();
+}
+
 EventPacketPtr PacketStreamingClient::getDataDescriptorChangedEventPacket(uint32_t signalId) const
 {
     std::scoped_lock lock(descriptorsSync);
@@ -68,9 +137,20 @@ void PacketStreamingClient::addEventPacketBuffer(const PacketBufferPtr& packetBu
     bool forwardPacket = true;
     auto signalId = packetBuffer->packetHeader->signalId;
 
-    const auto eventPayloadString = String((ConstCharPtr) packetBuffer->payload);
-
-    EventPacketPtr packet = jsonDeserializer.deserialize(eventPayloadString);
+    EventPacketPtr packet;
+    switch (packetBuffer->packetHeader->version)
+    {
+        case PACKET_EVENT_VERSION_JSON:
+            packet = jsonDeserializer.deserialize(String((ConstCharPtr) packetBuffer->payload));
+            jsonEventPacketCount++;
+            break;
+        case PACKET_EVENT_VERSION_BINARY:
+            packet = EventPacketBinarySerializer::deserialize(packetBuffer->payload, packetBuffer->packetHeader->payloadSize);
+            binaryEventPacketCount++;
+            break;
+        default:
+            throw PacketStreamingException("Event packet version not supported");
+    }
 
     if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED)
     {
@@ -111,12 +191,15 @@ DataPacketPtr PacketStreamingClient::addDataPacketBuffer(const PacketBufferPtr&
         else
         {
             // domain packet did not arrive yet, do not process this packet now, will do it later when the domain packet arrives
+            checkReferenceLimit();
+            retainPayloadInPacketMemory(packetBuffer);
             const auto it = packetBuffersWaitingForDomainPackets.find(domainPacketId);
             if (it == packetBuffersWaitingForDomainPackets.end())
                 packetBuffersWaitingForDomainPackets.insert({domainPacketId, {packetBuffer}});
             else
                 it->second.push_back(packetBuffer);
             referencedPacketBuffers.insert({dataPacketHeader->packetId, packetBuffer});
+            updateWaitingPacketBufferCount();
             return nullptr;
         }
     }
@@ -148,8 +231,10 @@ DataPacketPtr PacketStreamingClient::addDataPacketBuffer(const PacketBufferPtr&
         packet = DataPacketWithDomain(domPacket, valueDescriptor, dataPacketHeader->sampleCount, offset);
         assert(packet.getRawData() == nullptr);
     }
-    else
+    else if (valueDescriptor.getSampleType() == SampleType::Binary)
     {
+        // binary samples have no fixed size, so the received memory is kept and handed over to the packet
+        packetBuffer->retainPayload();
         packet = DataPacketWithExternalMemory(domPacket,
                                               valueDescriptor,
                                               dataPacketHeader->sampleCount,
@@ -157,6 +242,30 @@ DataPacketPtr PacketStreamingClient::addDataPacketBuffer(const PacketBufferPtr&
                                               Deleter([packetBuffer = packetBuffer](void*) mutable { packetBuffer.reset(); }),
                                               offset);
     }
+    else if (packetBuffer->payloadHolder && !(dataPacketHeader->genericHeader.flags & PACKET_FLAG_PAYLOAD_ENCODED))
+    {
+        // the payload memory outlives the receive buffer, so the packet references it instead of copying it
+        packet = DataPacketWithExternalMemory(domPacket,
+                                              valueDescriptor,
+                                              dataPacketHeader->sampleCount,
+                                              const_cast<void*>(packetBuffer->payload),
+                                              Deleter([payloadHolder = packetBuffer->payloadHolder](void*) mutable { payloadHolder.reset(); }),
+                                              offset);
+        if (packet.getRawDataSize() != static_cast<size_t>(dataPacketHeader->genericHeader.payloadSize))
+            throw PacketStreamingException("Data packet payload size mismatch");
+    }
+    else
+    {
+        packet = DataPacketWithDomain(domPacket, valueDescriptor, dataPacketHeader->sampleCount, offset, allocator);
+
+        const auto payloadSize = static_cast<size_t>(dataPacketHeader->genericHeader.payloadSize);
+        if (dataPacketHeader->genericHeader.flags & PACKET_FLAG_PAYLOAD_ENCODED)
+            PayloadCodec::decode(packetBuffer->payload, payloadSize, packet.getRawData(), packet.getRawDataSize());
+        else if (payloadSize == packet.getRawDataSize())
+            std::memcpy(packet.getRawData(), packetBuffer->payload, payloadSize);
+        else
+            throw PacketStreamingException("Data packet payload size mismatch");
+    }
 
     queue.push({signalId, packet});
 
@@ -175,28 +284,57 @@ DataPacketPtr PacketStreamingClient::addDataPacketBuffer(const PacketBufferPtr&
                 queue.push({sigId, dataPacket});
         }
         packetBuffersWaitingForDomainPackets.erase(packetsWaitingIt);
+        updateWaitingPacketBufferCount();
     }
 
     // if the domain packet arrives first or this is shared domain packet, it should have the CAN_RELEASE flag OFF,
     // so keep it in the referenced packets list
     if (!(dataPacketHeader->genericHeader.flags & PACKET_FLAG_CAN_RELEASE))
-        referencedPackets.insert({dataPacketHeader->packetId, packet});
+        addReferencedPacket(dataPacketHeader->packetId, packet);
 
     return packet;
 }
 
+void PacketStreamingClient::retainPayloadInPacketMemory(const PacketBufferPtr& packetBuffer)
+{
+    const auto dataPacketHeader = reinterpret_cast<DataPacketHeader*>(packetBuffer->packetHeader);
+    const auto sigIt = dataDescriptors.find(dataPacketHeader->genericHeader.signalId);
+
+    // encoded and binary payloads are converted when the packet is created, so they are kept as received
+    if (!allocator.assigned() || packetBuffer->payload == nullptr || packetBuffer->payloadHolder ||
+        (dataPacketHeader->genericHeader.flags & PACKET_FLAG_PAYLOAD_ENCODED) || sigIt == dataDescriptors.end() ||
+        sigIt->second.getSampleType() == SampleType::Binary)
+    {
+        packetBuffer->retainPayload();
+        return;
+    }
+
+    // the payload is copied once into memory of the packet allocator, the packet created once the domain
+    // packet arrives references it instead of copying it again
+    const auto payloadSize = static_cast<size_t>(dataPacketHeader->genericHeader.payloadSize);
+    void* memory = allocator.allocate(sigIt->second, payloadSize, sigIt->second.getRawSampleSize());
+    if (memory == nullptr)
+        throw PacketStreamingException("Packet allocator is out of memory");
+
+    std::memcpy(memory, packetBuffer->payload, payloadSize);
+    packetBuffer->payloadHolder = std::shared_ptr<void>(memory, [allocator = allocator](void* address) { allocator.free(address); });
+    packetBuffer->payload = memory;
+}
+
 void PacketStreamingClient::addReleasePacketBuffer(const PacketBufferPtr& packetBuffer)
 {
-    auto packetIds = static_cast<const Int*>(packetBuffer->payload);
+    // the payload may be placed in the receive buffer without alignment guarantees
+    const auto packetIds = static_cast<const uint8_t*>(packetBuffer->payload);
     const auto packetCount = static_cast<size_t>(packetBuffer->packetHeader->payloadSize) / sizeof(Int);
 
     for (size_t i = 0; i < packetCount; i++)
     {
-        const auto packetId = *packetIds++;
+        Int packetId;
+        std::memcpy(&packetId, packetIds + i * sizeof(Int), sizeof(Int));
 
         const auto packetIt = referencedPackets.find(packetId);
         if (packetIt != referencedPackets.end())
-            referencedPackets.erase(packetIt);
+            eraseReferencedPacket(packetIt);
         else
         {
             const auto packetBufferIt = referencedPacketBuffers.find(packetId);
@@ -248,7 +386,7 @@ void PacketStreamingClient::addAlreadySentPacketBuffer(const PacketBufferPtr& pa
     queue.push({signalId, packetIt->second});
 
     if (alreadySentPacketHeader->genericHeader.flags & PACKET_FLAG_CAN_RELEASE)
-        referencedPackets.erase(packetIt);
+        eraseReferencedPacket(packetIt);
 }
 
 }
@@ -6,10 +6,18 @@
 namespace daq::packet_streaming
 {
 
-PacketStreamingServer::PacketStreamingServer(size_t releaseThreshold)
+PacketStreamingServer::PacketStreamingServer(size_t releaseThreshold,
+                                             std::chrono::milliseconds releaseMaxDelay,
+                                             size_t releaseMaxBytes)
     : jsonSerializer(JsonSerializer())
+    , queueReadPosition(0)
+    , packetBufferArena(std::make_shared<PacketBufferArena>())
     , packetCollection(std::make_shared<PacketCollection>())
     , releaseThreshold(releaseThreshold)
+    , releaseMaxDelay(releaseMaxDelay)
+    , releaseMaxBytes(releaseMaxBytes)
+    , eventPacketVersion(PACKET_EVENT_VERSION_JSON)
+    , payloadEncoding(false)
 {
 }
 
@@ -50,50 +58,124 @@ void PacketStreamingServer::addDaqPacket(const uint32_t signalId, PacketPtr&& pa
     checkAndSendReleasePacket(false);
 }
 
+void PacketStreamingServer::addDaqPacket(const uint32_t signalId, const PacketPtr& packet, SharedPacketEncoding& sharedEncoding)
+{
+    switch (packet.getType())
+    {
+        case daq::PacketType::Event:
+            addEventPacket(signalId, packet, &sharedEncoding);
+            break;
+        case daq::PacketType::Data:
+            {
+                DataPacketPtr dataPacket = packet;
+                addDataPacket(signalId, dataPacket, &sharedEncoding);
+            }
+            break;
+        default:
+            throw NotSupportedException("Packet type not supported");
+    }
+
+    checkAndSendReleasePacket(false);
+}
+
+void PacketStreamingServer::completeSharedEncoding(const PacketPtr& packet, SharedPacketEncoding& sharedEncoding)
+{
+    if (!sharedEncoding.destructSubscribers.empty())
+    {
+        const DataPacketPtr dataPacket = packet;
+        subscribeForRelease(dataPacket, dataPacket.getPacketId(), std::move(sharedEncoding.destructSubscribers));
+    }
+
+    sharedEncoding.packetBuffer.reset();
+    sharedEncoding.encodedPacketBuffer.reset();
+    sharedEncoding.destructSubscribers.clear();
+}
+
 PacketBufferPtr PacketStreamingServer::getNextPacketBuffer()
 {
-    if (!queue.empty())
+    if (queueReadPosition < queue.size())
     {
-        auto packetBuffer = queue.front();
-        queue.pop();
+        auto packetBuffer = std::move(queue[queueReadPosition++]);
+        if (queueReadPosition == queue.size())
+        {
+            queue.clear();
+            queueReadPosition = 0;
+        }
         return packetBuffer;
     }
 
     return nullptr;
 }
 
-void PacketStreamingServer::addEventPacket(const uint32_t signalId, const EventPacketPtr& packet)
+PacketBufferPtr PacketStreamingServer::createPacketBuffer(const void* payload, BaseObjectPtr payloadOwner)
 {
-    const auto packetHeader = new GenericPacketHeader();
-    packetHeader->size = sizeof(GenericPacketHeader);
-    packetHeader->type = PacketType::event;
-    packetHeader->version = 0;
-    packetHeader->flags = 0;
-    packetHeader->signalId = signalId;
+    return std::allocate_shared<PacketBuffer>(PacketBufferAllocator<PacketBuffer>(packetBufferArena),
+                                              payload,
+                                              std::move(payloadOwner));
+}
 
-    jsonSerializer.reset();
-    packet.serialize(jsonSerializer);
-    auto serializedPacket = jsonSerializer.getOutput();
+void PacketStreamingServer::addEventPacket(const uint32_t signalId, const EventPacketPtr& packet, SharedPacketEncoding* sharedEncoding)
+{
+    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED &&
+        packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR).assigned())
+    {
+        const DataDescriptorPtr dataDescriptor = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+        dataDescriptors.insert_or_assign(signalId, dataDescriptor);
 
-    packetHeader->payloadSize = static_cast<uint32_t>(serializedPacket.getLength() + 1);
+        // raw data is in the input sample type of the post scaling
+        const auto postScaling = dataDescriptor.getPostScaling();
+        payloadSampleTypes.insert_or_assign(signalId,
+                                            postScaling.assigned() ? postScaling.getInputSampleType() : dataDescriptor.getSampleType());
+    }
 
-    const auto packetBuffer = std::make_shared<PacketBuffer>(
-            packetHeader,
-            reinterpret_cast<const void*>(serializedPacket.getCharPtr()),
-            [packetHeader, serializedPacket]() mutable {
-                delete packetHeader;
-                serializedPacket.release();
-        });
+    const uint8_t version = eventPacketVersion;
+    std::unique_lock<std::mutex> sharedEncodingLock;
+    if (sharedEncoding != nullptr)
+    {
+        sharedEncodingLock = std::unique_lock(sharedEncoding->sync);
+        if (sharedEncoding->packetBuffer && sharedEncoding->packetBuffer->packetHeader->version == version)
+        {
+            queue.push_back(sharedEncoding->packetBuffer);
+            return;
+        }
+    }
 
-    if (packet.getEventId() == event_packet_id::DATA_DESCRIPTOR_CHANGED &&
-        packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR).assigned())
+    PacketBufferPtr packetBuffer;
+    if (version == PACKET_EVENT_VERSION_BINARY)
+    {
+        packetBuffer = createPacketBuffer(nullptr, nullptr);
+        if (EventPacketBinarySerializer::serialize(packet, packetBuffer->payloadStorage))
+        {
+            packetBuffer->payload = reinterpret_cast<const void*>(packetBuffer->payloadStorage.data());
+            packetBuffer->packetHeader->version = PACKET_EVENT_VERSION_BINARY;
+            packetBuffer->packetHeader->payloadSize = static_cast<uint32_t>(packetBuffer->payloadStorage.size());
+        }
+        else
+            packetBuffer.reset();
+    }
+
+    // JSON is used by clients not supporting binary encoding and for events outside of the binary subset
+    if (!packetBuffer)
     {
-        dataDescriptors.insert_or_assign(
-            signalId,
-            packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR));
+        jsonSerializer.reset();
+        packet.serialize(jsonSerializer);
+        auto serializedPacket = jsonSerializer.getOutput();
+
+        packetBuffer = createPacketBuffer(reinterpret_cast<const void*>(serializedPacket.getCharPtr()), serializedPacket);
+        packetBuffer->packetHeader->version = PACKET_EVENT_VERSION_JSON;
+        packetBuffer->packetHeader->payloadSize = static_cast<uint32_t>(serializedPacket.getLength() + 1);
     }
 
-    queue.push(packetBuffer);
+    const auto packetHeader = packetBuffer->packetHeader;
+    packetHeader->size = sizeof(GenericPacketHeader);
+    packetHeader->type = PacketType::event;
+    packetHeader->flags = 0;
+    packetHeader->signalId = signalId;
+
+    if (sharedEncoding != nullptr && !sharedEncoding->packetBuffer)
+        sharedEncoding->packetBuffer = packetBuffer;
+
+    queue.push_back(packetBuffer);
 }
 
 template <bool CheckRefCount>
@@ -110,7 +192,10 @@ bool PacketStreamingServer::canReleasePacket(const DataPacketPtr& packet)
     return false;
 }
 
-bool PacketStreamingServer::shouldSendPacket(const DataPacketPtr& packet, Int packetId, bool markForRelease) const
+bool PacketStreamingServer::shouldSendPacket(const DataPacketPtr& packet,
+                                             Int packetId,
+                                             bool markForRelease,
+                                             SharedPacketEncoding* sharedEncoding) const
 {
     bool packetAlreadySent = false;
     {
@@ -127,16 +212,41 @@ bool PacketStreamingServer::shouldSendPacket(const DataPacketPtr& packet, Int pa
     }
 
     if (!markForRelease && !packetAlreadySent)
-        packet.subscribeForDestructNotification(PacketDestructCallback(
-            [packetCollection = packetCollection, packetId]
+    {
+        // with shared encoding the destruct notification is registered once for all sessions
+        if (sharedEncoding != nullptr)
+        {
+            std::scoped_lock lock(sharedEncoding->sync);
+            sharedEncoding->destructSubscribers.push_back(packetCollection);
+        }
+        else
+            subscribeForRelease(packet, packetId, {packetCollection});
+    }
+
+    return !packetAlreadySent;
+}
+
+void PacketStreamingServer::subscribeForRelease(const DataPacketPtr& packet,
+                                                Int packetId,
+                                                std::vector<PacketCollectionPtr> packetCollections)
+{
+    const size_t packetSize = packet.getRawData() != nullptr ? packet.getRawDataSize() : 0;
+    packet.subscribeForDestructNotification(PacketDestructCallback(
+        [packetCollections = std::move(packetCollections), packetId, packetSize]
+        {
+            for (const auto& packetCollection : packetCollections)
             {
                 std::scoped_lock lock(packetCollection->sync);
                 const auto erasedCount = packetCollection->sent.erase(packetId);
                 if (erasedCount > 0)
+                {
+                    if (packetCollection->readyForRelease.empty())
+                        packetCollection->firstReadyForRelease = std::chrono::steady_clock::now();
                     packetCollection->readyForRelease.push_back(packetId);
-            }));
-
-    return !packetAlreadySent;
+                    packetCollection->readyForReleaseBytes += packetSize;
+                }
+            }
+        }));
 }
 
 void PacketStreamingServer::setOffset(const DataPacketPtr& packet, DataPacketHeader* packetHeader)
@@ -169,7 +279,7 @@ Int PacketStreamingServer::getDomainPacketId(const DataPacketPtr& packet)
 }
 
 template <class DataPacket>
-void PacketStreamingServer::addDataPacket(const uint32_t signalId, DataPacket&& packet)
+void PacketStreamingServer::addDataPacket(const uint32_t signalId, DataPacket&& packet, SharedPacketEncoding* sharedEncoding)
 {
     if (dataDescriptors.find(signalId) == dataDescriptors.end())
         throw PacketStreamingException("No signal descriptor event received");
@@ -180,14 +290,47 @@ void PacketStreamingServer::addDataPacket(const uint32_t signalId, DataPacket&&
     auto packetId = packet.getPacketId();
     auto domainPacketId = getDomainPacketId(packet);
 
-    auto doSendPacket = shouldSendPacket(packet, packetId, markPacketForRelease);
+    auto doSendPacket = shouldSendPacket(packet, packetId, markPacketForRelease, sharedEncoding);
     if (!doSendPacket)
     {
         addAlreadySentPacket(signalId, packetId, domainPacketId, markPacketForRelease);
         return;
     }
 
-    const auto packetHeader = static_cast<DataPacketHeader*>(std::malloc(sizeof(DataPacketHeader)));
+    // the encoded data packet does not depend on per-session state unless it is marked for release,
+    // sessions with payload encoding enabled share a separate buffer
+    const bool encodePayload = payloadEncoding;
+    PacketBufferPtr* sharedPacketBuffer = nullptr;
+    std::unique_lock<std::mutex> sharedEncodingLock;
+    if (sharedEncoding != nullptr && !markPacketForRelease)
+    {
+        sharedEncodingLock = std::unique_lock(sharedEncoding->sync);
+        sharedPacketBuffer = encodePayload ? &sharedEncoding->encodedPacketBuffer : &sharedEncoding->packetBuffer;
+        if (*sharedPacketBuffer)
+        {
+            queue.push_back(*sharedPacketBuffer);
+            return;
+        }
+    }
+
+    const auto packetDataPtr = packet.getRawData();
+    const auto packetDataSize = packetDataPtr != nullptr ? packet.getRawDataSize() : 0;
+
+    PacketBufferPtr packetBuffer;
+    if (encodePayload && packetDataSize > 0)
+    {
+        packetBuffer = createPacketBuffer(nullptr, nullptr);
+        if (PayloadCodec::encode(payloadSampleTypes[signalId], packetDataPtr, packetDataSize, packetBuffer->payloadStorage))
+            packetBuffer->payload = reinterpret_cast<const void*>(packetBuffer->payloadStorage.data());
+        else
+            packetBuffer.reset();
+    }
+
+    const bool payloadEncoded = packetBuffer != nullptr;
+    if (!payloadEncoded)
+        packetBuffer = createPacketBuffer(packetDataPtr, packet);
+
+    const auto packetHeader = &packetBuffer->inlineHeader.dataHeader;
     packetHeader->genericHeader.size = sizeof(DataPacketHeader);
     packetHeader->genericHeader.type = PacketType::data;
     packetHeader->genericHeader.version = 0;
@@ -199,42 +342,52 @@ void PacketStreamingServer::addDataPacket(const uint32_t signalId, DataPacket&&
 
     setOffset(packet, packetHeader);
 
-    const auto packetDataPtr = packet.getRawData();
-    const auto packetDataSize = packetDataPtr != nullptr ? packet.getRawDataSize() : 0;
-    packetHeader->genericHeader.payloadSize = static_cast<uint32_t>(packetDataSize);
-
-    const auto packetBuffer = std::make_shared<PacketBuffer>(
-        reinterpret_cast<GenericPacketHeader*>(packetHeader),
-        packetDataPtr,
-        [packetHeader, packet = packet]() mutable
-        {
-            std::free(packetHeader);
-            packet.release();
-        }
-    );
+    if (payloadEncoded)
+    {
+        packetHeader->genericHeader.flags |= PACKET_FLAG_PAYLOAD_ENCODED;
+        packetHeader->genericHeader.payloadSize = static_cast<uint32_t>(packetBuffer->payloadStorage.size());
+    }
+    else
+        packetHeader->genericHeader.payloadSize = static_cast<uint32_t>(packetDataSize);
 
     if constexpr (isPacketRValue)
         packet.release();
 
-    queue.push(packetBuffer);
+    if (sharedPacketBuffer != nullptr)
+        *sharedPacketBuffer = packetBuffer;
+
+    queue.push_back(packetBuffer);
 }
 
 void PacketStreamingServer::checkAndSendReleasePacket(bool force)
 {
-    Int* packetIds;
+    std::vector<Int> packetIds;
     size_t packetsReadyForRelease;
     {
         std::scoped_lock lock(packetCollection->sync);
         packetsReadyForRelease = packetCollection->readyForRelease.size();
-        if (!(force && packetsReadyForRelease > 0) && (packetsReadyForRelease < releaseThreshold))
+        if (packetsReadyForRelease == 0)
+            return;
+
+        // packets of low rate signals would be kept by the client until the threshold count is reached,
+        // so the release is also sent when they are held for too long or hold too much memory
+        const bool flush = force ||
+                           packetsReadyForRelease >= releaseThreshold ||
+                           (releaseMaxBytes > 0 && packetCollection->readyForReleaseBytes >= releaseMaxBytes) ||
+                           (releaseMaxDelay.count() > 0 &&
+                            std::chrono::steady_clock::now() - packetCollection->firstReadyForRelease >= releaseMaxDelay);
+        if (!flush)
             return;
 
-        packetIds = new Int[packetsReadyForRelease];
-        std::memcpy(packetIds, packetCollection->readyForRelease.data(), packetsReadyForRelease * sizeof(Int));
-        packetCollection->readyForRelease.clear();
+        packetIds.swap(packetCollection->readyForRelease);
+        packetCollection->readyForReleaseBytes = 0;
     }
 
-    const auto packetHeader = new GenericPacketHeader();
+    const auto packetBuffer = createPacketBuffer(nullptr, nullptr);
+    packetBuffer->releasedPacketIds = std::move(packetIds);
+    packetBuffer->payload = reinterpret_cast<const void*>(packetBuffer->releasedPacketIds.data());
+
+    const auto packetHeader = packetBuffer->packetHeader;
     packetHeader->size = sizeof(GenericPacketHeader);
     packetHeader->type = PacketType::release;
     packetHeader->version = 0;
@@ -242,20 +395,24 @@ void PacketStreamingServer::checkAndSendReleasePacket(bool force)
     packetHeader->signalId = std::numeric_limits<uint32_t>::max();
     packetHeader->payloadSize = static_cast<uint32_t>(packetsReadyForRelease * sizeof(Int));
 
-    const auto packetBuffer = std::make_shared<PacketBuffer>(packetHeader, 
-                                                             reinterpret_cast<const void*>(packetIds),
-                                                             [packetHeader, packetIds]
-                                                             {
-                                                                 delete packetHeader;
-                                                                 delete[] packetIds;
-                                                             });
+    queue.push_back(packetBuffer);
+}
+
+void PacketStreamingServer::setEventPacketVersion(uint8_t version)
+{
+    eventPacketVersion = std::min<uint8_t>(version, PACKET_EVENT_VERSION_BINARY);
+}
 
-    queue.push(packetBuffer);
+void PacketStreamingServer::setPayloadEncoding(bool enabled)
+{
+    payloadEncoding = enabled;
 }
 
 void PacketStreamingServer::addAlreadySentPacket(uint32_t signalId, Int packetId, Int domainPacketId, bool markForRelease)
 {
-    const auto packetHeader = static_cast<AlreadySentPacketHeader*>(std::malloc(sizeof(AlreadySentPacketHeader)));
+    const auto packetBuffer = createPacketBuffer(nullptr, nullptr);
+
+    const auto packetHeader = &packetBuffer->inlineHeader.alreadySentHeader;
     packetHeader->genericHeader.size = sizeof(AlreadySentPacketHeader);
     packetHeader->genericHeader.type = PacketType::alreadySent;
     packetHeader->genericHeader.version = 0;
@@ -265,13 +422,7 @@ void PacketStreamingServer::addAlreadySentPacket(uint32_t signalId, Int packetId
     packetHeader->packetId = packetId;
     packetHeader->domainPacketId = domainPacketId;
 
-    const auto packetBuffer = std::make_shared<PacketBuffer>(reinterpret_cast<GenericPacketHeader*>(packetHeader), nullptr,
-                                                             [packetHeader]
-                                                             {
-                                                                 std::free(packetHeader);
-                                                             });
-
-    queue.push(packetBuffer);
+    queue.push_back(packetBuffer);
 }
 
 }
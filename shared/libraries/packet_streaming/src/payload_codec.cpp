@@ -0,0 +1,236 @@
+#include <packet_streaming/payload_codec.h>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace daq::packet_streaming
+{
+
+namespace
+{
+
+struct EncodedPayloadHeader
+{
+    uint8_t sampleType;
+    uint32_t elementCount;
+};
+
+constexpr size_t encodedPayloadHeaderSize = sizeof(uint8_t) + sizeof(uint32_t);
+
+// maximum size of a 64-bit LEB128 varint
+constexpr size_t maxVarintSize = 10;
+
+inline uint8_t* writeVarint(uint8_t* output, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        *output++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *output++ = static_cast<uint8_t>(value);
+    return output;
+}
+
+inline uint64_t readVarint(const uint8_t*& data, const uint8_t* end)
+{
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (data == end)
+            throw PacketStreamingException("Encoded payload truncated");
+
+        const uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+
+    throw PacketStreamingException("Encoded payload varint too long");
+}
+
+inline uint64_t zigzagEncode(uint64_t delta)
+{
+    return (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+}
+
+inline uint64_t zigzagDecode(uint64_t value)
+{
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+template <typename T>
+using BitsType = std::conditional_t<sizeof(T) == 8, uint64_t, std::conditional_t<sizeof(T) == 4, uint32_t, std::conditional_t<sizeof(T) == 2, uint16_t, uint8_t>>>;
+
+template <typename T>
+inline uint64_t toWideBits(T value)
+{
+    if constexpr (std::is_signed_v<T> && std::is_integral_v<T>)
+        return static_cast<uint64_t>(static_cast<int64_t>(value));
+    else
+    {
+        BitsType<T> bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits;
+    }
+}
+
+template <typename T>
+inline T fromWideBits(uint64_t value)
+{
+    const auto bits = static_cast<BitsType<T>>(value);
+    T result;
+    std::memcpy(&result, &bits, sizeof(T));
+    return result;
+}
+
+// returns false once the encoded output would not be smaller than the raw payload
+template <typename T>
+bool encodeElements(const void* data, size_t elementCount, size_t rawSize, std::vector<uint8_t>& output)
+{
+    if (rawSize <= encodedPayloadHeaderSize)
+        return false;
+
+    const auto elements = static_cast<const T*>(data);
+    // encoding stops as soon as it reaches the raw size, so the last varint is the most it can overshoot
+    output.resize(rawSize + maxVarintSize);
+
+    uint8_t* current = output.data() + encodedPayloadHeaderSize;
+    const uint8_t* limit = output.data() + rawSize;
+
+    uint64_t previous = 0;
+    for (size_t i = 0; i < elementCount; i++)
+    {
+        const uint64_t bits = toWideBits(elements[i]);
+        if constexpr (std::is_floating_point_v<T>)
+            current = writeVarint(current, bits ^ previous);
+        else
+            current = writeVarint(current, zigzagEncode(bits - previous));
+        previous = bits;
+
+        if (current >= limit)
+            return false;
+    }
+
+    output.resize(current - output.data());
+    return true;
+}
+
+template <typename T>
+void decodeElements(const uint8_t* data, const uint8_t* end, size_t elementCount, void* output)
+{
+    const auto elements = static_cast<T*>(output);
+
+    uint64_t previous = 0;
+    for (size_t i = 0; i < elementCount; i++)
+    {
+        const uint64_t value = readVarint(data, end);
+        if constexpr (std::is_floating_point_v<T>)
+            previous ^= value;
+        else
+            previous += zigzagDecode(value);
+
+        // narrower types are kept sign or zero extended, so the deltas stay small
+        elements[i] = fromWideBits<T>(previous);
+        if constexpr (!std::is_floating_point_v<T>)
+            previous = toWideBits(elements[i]);
+    }
+}
+
+template <typename Func>
+bool dispatchSampleType(SampleType sampleType, Func&& func)
+{
+    switch (sampleType)
+    {
+        case SampleType::Int8:
+            func(int8_t{});
+            return true;
+        case SampleType::Int16:
+            func(int16_t{});
+            return true;
+        case SampleType::Int32:
+            func(int32_t{});
+            return true;
+        case SampleType::Int64:
+            func(int64_t{});
+            return true;
+        case SampleType::UInt8:
+            func(uint8_t{});
+            return true;
+        case SampleType::UInt16:
+            func(uint16_t{});
+            return true;
+        case SampleType::UInt32:
+            func(uint32_t{});
+            return true;
+        case SampleType::UInt64:
+            func(uint64_t{});
+            return true;
+        case SampleType::Float32:
+            func(float{});
+            return true;
+        case SampleType::Float64:
+            func(double{});
+            return true;
+        default:
+            return false;
+    }
+}
+
+}
+
+bool PayloadCodec::encode(SampleType sampleType, const void* data, size_t size, std::vector<uint8_t>& output)
+{
+    bool encoded = false;
+    const bool supported = dispatchSampleType(
+        sampleType,
+        [&](auto element)
+        {
+            using T = decltype(element);
+            if (size % sizeof(T) != 0 || size / sizeof(T) > std::numeric_limits<uint32_t>::max())
+                return;
+
+            const auto elementCount = size / sizeof(T);
+            encoded = encodeElements<T>(data, elementCount, size, output);
+            if (encoded)
+            {
+                const EncodedPayloadHeader header {static_cast<uint8_t>(sampleType), static_cast<uint32_t>(elementCount)};
+                std::memcpy(output.data(), &header.sampleType, sizeof(header.sampleType));
+                std::memcpy(output.data() + sizeof(header.sampleType), &header.elementCount, sizeof(header.elementCount));
+            }
+        });
+
+    if (!supported || !encoded)
+    {
+        output.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void PayloadCodec::decode(const void* data, size_t size, void* output, size_t outputSize)
+{
+    if (size < encodedPayloadHeaderSize)
+        throw PacketStreamingException("Encoded payload truncated");
+
+    const auto begin = static_cast<const uint8_t*>(data);
+    EncodedPayloadHeader header;
+    std::memcpy(&header.sampleType, begin, sizeof(header.sampleType));
+    std::memcpy(&header.elementCount, begin + sizeof(header.sampleType), sizeof(header.elementCount));
+
+    const bool supported = dispatchSampleType(
+        static_cast<SampleType>(header.sampleType),
+        [&](auto element)
+        {
+            using T = decltype(element);
+            if (header.elementCount * sizeof(T) != outputSize)
+                throw PacketStreamingException("Encoded payload size mismatch");
+
+            decodeElements<T>(begin + encodedPayloadHeaderSize, begin + size, header.elementCount, output);
+        });
+
+    if (!supported)
+        throw PacketStreamingException("Encoded payload sample type not supported");
+}
+
+}
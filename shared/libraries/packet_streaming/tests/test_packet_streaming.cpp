@@ -2,10 +2,16 @@
 #include <packet_streaming/packet_streaming_client.h>
 #include <packet_streaming/packet_streaming_server.h>
 #include <opendaq/packet_factory.h>
+#include <opendaq/malloc_allocator_factory.h>
 #include <opendaq/data_descriptor_factory.h>
 #include <opendaq/data_rule_factory.h>
 #include <opendaq/packet_destruct_callback_factory.h>
+#include <opendaq/range_factory.h>
+#include <opendaq/scaling_factory.h>
+#include <coreobjects/unit_factory.h>
+#include <coretypes/ratio_factory.h>
 #include "packet_transmission.h"
+#include <thread>
 
 using namespace daq;
 using namespace packet_streaming;
@@ -65,6 +71,38 @@ TEST_F(PacketStreamingTest, EventPacket)
     ASSERT_EQ(descriptorEventPacket, clientEventPacket);
 }
 
+TEST_F(PacketStreamingTest, EventPacketBinaryEncoding)
+{
+    server.setEventPacketVersion(PACKET_EVENT_VERSION_BINARY);
+
+    const auto valueDescriptor = DataDescriptorBuilder()
+                                     .setSampleType(SampleType::Float32)
+                                     .setName("Value")
+                                     .setUnit(Unit("V", 1, "volt", "voltage"))
+                                     .setValueRange(Range(-10.0, 10.0))
+                                     .setPostScaling(LinearScaling(2.0, 1.0, SampleType::Int16, ScaledSampleType::Float32))
+                                     .build();
+    const auto domainDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Int64)
+                                      .setRule(LinearDataRule(10, 0))
+                                      .setTickResolution(Ratio(1, 1000))
+                                      .setOrigin("1970-01-01T00:00:00Z")
+                                      .setUnit(Unit("s", -1, "seconds", "time"))
+                                      .build();
+    const auto serverEventPacket = DataDescriptorChangedEventPacket(valueDescriptor, domainDescriptor);
+
+    server.addDaqPacket(1, serverEventPacket);
+    const auto serverPacketBuffer = server.getNextPacketBuffer();
+    ASSERT_EQ(serverPacketBuffer->packetHeader->version, PACKET_EVENT_VERSION_BINARY);
+
+    transmission.sendPacketBuffer(serverPacketBuffer);
+    client.addPacketBuffer(transmission.recvPacketBuffer());
+    auto [signalId, clientEventPacket] = client.getNextDaqPacket();
+
+    ASSERT_EQ(signalId, 1u);
+    ASSERT_EQ(serverEventPacket, clientEventPacket);
+}
+
 TEST_F(PacketStreamingTest, DataPacket)
 {
     const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
@@ -96,6 +134,111 @@ TEST_F(PacketStreamingTest, DataPacket)
     ASSERT_TRUE(client.areReferencesCleared());
 }
 
+TEST_F(PacketStreamingTest, DataPacketTransientPayload)
+{
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+
+    const auto serverDataDescriptorChangedEventPacket = DataDescriptorChangedEventPacket(valueDescriptor, nullptr);
+    server.addDaqPacket(1, serverDataDescriptorChangedEventPacket);
+    transmitAll();
+    client.getNextDaqPacket();
+
+    constexpr size_t sampleCount = 100;
+    auto serverDataPacket = DataPacket(valueDescriptor, sampleCount, 1024);
+    auto data = static_cast<float*>(serverDataPacket.getRawData());
+    for (size_t i = 0; i < sampleCount; i++)
+        *data++ = static_cast<float>(i);
+
+    server.addDaqPacket(1, serverDataPacket);
+    const auto serverPacketBuffer = server.getNextPacketBuffer();
+
+    // the payload is only valid while the client processes the buffer, as with a socket receive buffer
+    const auto payloadBytes = static_cast<const uint8_t*>(serverPacketBuffer->payload);
+    std::vector<uint8_t> receiveBuffer(payloadBytes, payloadBytes + serverPacketBuffer->packetHeader->payloadSize);
+    const auto clientPacketBuffer = std::make_shared<PacketBuffer>(receiveBuffer.data(), nullptr);
+    std::memcpy(clientPacketBuffer->packetHeader, serverPacketBuffer->packetHeader, serverPacketBuffer->packetHeader->size);
+
+    client.addPacketBuffer(clientPacketBuffer);
+    std::fill(receiveBuffer.begin(), receiveBuffer.end(), uint8_t{0xFF});
+
+    auto [signalId, clientDataPacket] = client.getNextDaqPacket();
+    ASSERT_EQ(signalId, 1u);
+    ASSERT_EQ(serverDataPacket, clientDataPacket);
+}
+
+TEST_F(PacketStreamingTest, ValuePacketWaitingForDomainUsesAllocator)
+{
+    PacketStreamingClient allocatorClient(MallocAllocator());
+
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    const auto domainDescriptor =
+        DataDescriptorBuilder().setSampleType(SampleType::Int64).setRule(LinearDataRule(1, 0)).setTickResolution(Ratio(1, 1000)).build();
+
+    server.addDaqPacket(1, DataDescriptorChangedEventPacket(valueDescriptor, domainDescriptor));
+    server.addDaqPacket(2, DataDescriptorChangedEventPacket(domainDescriptor, nullptr));
+
+    constexpr size_t sampleCount = 100;
+    auto serverDomainPacket = DataPacket(domainDescriptor, sampleCount, 1024);
+    auto serverValuePacket = DataPacketWithDomain(serverDomainPacket, valueDescriptor, sampleCount);
+    auto data = static_cast<float*>(serverValuePacket.getRawData());
+    for (size_t i = 0; i < sampleCount; i++)
+        *data++ = static_cast<float>(i);
+
+    // the value packet arrives first and waits for its domain packet
+    server.addDaqPacket(1, serverValuePacket);
+    server.addDaqPacket(2, serverDomainPacket);
+
+    while (const auto serverPacketBuffer = server.getNextPacketBuffer())
+    {
+        transmission.sendPacketBuffer(serverPacketBuffer);
+        while (const auto clientPacketBuffer = transmission.recvPacketBuffer())
+            allocatorClient.addPacketBuffer(clientPacketBuffer);
+    }
+
+    allocatorClient.getNextDaqPacket();
+    allocatorClient.getNextDaqPacket();
+
+    auto [domainSignalId, clientDomainPacket] = allocatorClient.getNextDaqPacket();
+    ASSERT_EQ(domainSignalId, 2u);
+    ASSERT_EQ(serverDomainPacket, clientDomainPacket);
+
+    auto [valueSignalId, clientValuePacket] = allocatorClient.getNextDaqPacket();
+    ASSERT_EQ(valueSignalId, 1u);
+    ASSERT_EQ(serverValuePacket, clientValuePacket);
+    ASSERT_EQ(clientValuePacket.asPtr<IDataPacket>().getDomainPacket(), clientDomainPacket);
+}
+
+TEST_F(PacketStreamingTest, DataPacketEncodedPayload)
+{
+    server.setPayloadEncoding(true);
+
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int32).build();
+
+    const auto serverDataDescriptorChangedEventPacket = DataDescriptorChangedEventPacket(valueDescriptor, nullptr);
+    server.addDaqPacket(1, serverDataDescriptorChangedEventPacket);
+    transmitAll();
+    client.getNextDaqPacket();
+
+    constexpr size_t sampleCount = 100;
+    auto serverDataPacket = DataPacket(valueDescriptor, sampleCount, 1024);
+    auto data = static_cast<int32_t*>(serverDataPacket.getRawData());
+    for (size_t i = 0; i < sampleCount; i++)
+        *data++ = 1 << 22 | static_cast<int32_t>(i % 7);
+
+    server.addDaqPacket(1, serverDataPacket);
+
+    const auto serverPacketBuffer = server.getNextPacketBuffer();
+    ASSERT_TRUE(serverPacketBuffer->packetHeader->flags & PACKET_FLAG_PAYLOAD_ENCODED);
+    ASSERT_LT(serverPacketBuffer->packetHeader->payloadSize, serverDataPacket.getRawDataSize());
+
+    transmission.sendPacketBuffer(serverPacketBuffer);
+    client.addPacketBuffer(transmission.recvPacketBuffer());
+    auto [signalId, clientDataPacket] = client.getNextDaqPacket();
+
+    ASSERT_EQ(signalId, 1u);
+    ASSERT_EQ(serverDataPacket, clientDataPacket);
+}
+
 TEST_F(PacketStreamingTest, CanReleaseDataPacket)
 {
     const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
@@ -127,6 +270,162 @@ TEST_F(PacketStreamingTest, CanReleaseDataPacket)
 }
 
 
+TEST_F(PacketStreamingTest, ReleaseBelowThresholdOnMaxBytes)
+{
+    // the threshold count is not reached, the release is sent because of the memory held by the client
+    PacketStreamingServer releasingServer(10, std::chrono::milliseconds(0), 1);
+    const auto transmitAllFromServer = [this, &releasingServer]()
+    {
+        while (const auto serverPacketBuffer = releasingServer.getNextPacketBuffer())
+        {
+            transmission.sendPacketBuffer(serverPacketBuffer);
+            while (const auto clientPacketBuffer = transmission.recvPacketBuffer())
+                client.addPacketBuffer(clientPacketBuffer);
+        }
+    };
+
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    const auto serverDataDescriptorChangedEventPacket = DataDescriptorChangedEventPacket(valueDescriptor, nullptr);
+    releasingServer.addDaqPacket(1, serverDataDescriptorChangedEventPacket);
+
+    constexpr size_t sampleCount = 100;
+    auto serverDataPacket = DataPacket(valueDescriptor, sampleCount, 1024);
+
+    // the packet is still referenced on the server, so the client keeps it until it is released
+    releasingServer.addDaqPacket(1, serverDataPacket);
+    transmitAllFromServer();
+
+    auto statistics = client.getReferenceStatistics();
+    ASSERT_EQ(statistics.referencedPackets, 1u);
+    ASSERT_EQ(statistics.referencedBytes, sampleCount * sizeof(float));
+    ASSERT_EQ(statistics.waitingPacketBuffers, 0u);
+
+    serverDataPacket.release();
+    releasingServer.checkAndSendReleasePacket(false);
+    transmitAllFromServer();
+
+    statistics = client.getReferenceStatistics();
+    ASSERT_EQ(statistics.referencedPackets, 0u);
+    ASSERT_EQ(statistics.referencedBytes, 0u);
+    ASSERT_TRUE(client.areReferencesCleared());
+}
+
+TEST_F(PacketStreamingTest, ReleaseBelowThresholdOnMaxDelay)
+{
+    // the threshold count is not reached, the release is sent once the packet is held for the max delay
+    PacketStreamingServer releasingServer(10, std::chrono::milliseconds(50));
+    const auto transmitAllFromServer = [this, &releasingServer]()
+    {
+        while (const auto serverPacketBuffer = releasingServer.getNextPacketBuffer())
+        {
+            transmission.sendPacketBuffer(serverPacketBuffer);
+            while (const auto clientPacketBuffer = transmission.recvPacketBuffer())
+                client.addPacketBuffer(clientPacketBuffer);
+        }
+    };
+
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    const auto serverDataDescriptorChangedEventPacket = DataDescriptorChangedEventPacket(valueDescriptor, nullptr);
+    releasingServer.addDaqPacket(1, serverDataDescriptorChangedEventPacket);
+
+    auto serverDataPacket = DataPacket(valueDescriptor, 100, 1024);
+    releasingServer.addDaqPacket(1, serverDataPacket);
+    transmitAllFromServer();
+    ASSERT_EQ(client.getReferenceStatistics().referencedPackets, 1u);
+
+    // no packet is added afterwards, the check is run periodically by the session
+    serverDataPacket.release();
+    releasingServer.checkAndSendReleasePacket(false);
+    transmitAllFromServer();
+    ASSERT_EQ(client.getReferenceStatistics().referencedPackets, 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    releasingServer.checkAndSendReleasePacket(false);
+    transmitAllFromServer();
+    ASSERT_EQ(client.getReferenceStatistics().referencedPackets, 0u);
+    ASSERT_TRUE(client.areReferencesCleared());
+}
+
+TEST_F(PacketStreamingTest, ReferenceLimit)
+{
+    client.setMaxReferences(2);
+
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    server.addDaqPacket(1, DataDescriptorChangedEventPacket(valueDescriptor, nullptr));
+
+    // the packets are still referenced on the server, so the client keeps them until they are released
+    auto serverDataPacket1 = DataPacket(valueDescriptor, 100, 1024);
+    auto serverDataPacket2 = DataPacket(valueDescriptor, 100, 1124);
+    auto serverDataPacket3 = DataPacket(valueDescriptor, 100, 1224);
+    server.addDaqPacket(1, serverDataPacket1);
+    server.addDaqPacket(1, serverDataPacket2);
+    transmitAll();
+    ASSERT_EQ(client.getReferenceStatistics().referencedPackets, 2u);
+    ASSERT_EQ(client.getReferenceStatistics().referenceLimitHits, 0u);
+
+    server.addDaqPacket(1, serverDataPacket3);
+    ASSERT_THROW(transmitAll(), PacketStreamingException);
+
+    const auto statistics = client.getReferenceStatistics();
+    ASSERT_EQ(statistics.referencedPackets, 2u);
+    ASSERT_EQ(statistics.referenceLimitHits, 1u);
+}
+
+TEST_F(PacketStreamingTest, PacketBufferArenaRecyclesBlocks)
+{
+    auto arena = std::make_shared<PacketBufferArena>(1);
+
+    const auto firstBlock = arena->allocate(64);
+    arena->deallocate(firstBlock, 64);
+
+    const auto secondBlock = arena->allocate(64);
+    ASSERT_EQ(firstBlock, secondBlock);
+
+    // requests of a different size are not served from the free list
+    const auto otherBlock = arena->allocate(32);
+    ASSERT_NE(otherBlock, secondBlock);
+
+    arena->deallocate(otherBlock, 32);
+    arena->deallocate(secondBlock, 64);
+}
+
+TEST_F(PacketStreamingTest, SharedEncodingAcrossServers)
+{
+    PacketStreamingServer otherServer {10};
+
+    const auto valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
+    const auto serverDataDescriptorChangedEventPacket = DataDescriptorChangedEventPacket(valueDescriptor, nullptr);
+
+    SharedPacketEncoding eventEncoding;
+    server.addDaqPacket(1, serverDataDescriptorChangedEventPacket, eventEncoding);
+    otherServer.addDaqPacket(1, serverDataDescriptorChangedEventPacket, eventEncoding);
+    PacketStreamingServer::completeSharedEncoding(serverDataDescriptorChangedEventPacket, eventEncoding);
+    ASSERT_EQ(server.getNextPacketBuffer(), otherServer.getNextPacketBuffer());
+
+    constexpr size_t sampleCount = 100;
+    auto serverDataPacket = DataPacket(valueDescriptor, sampleCount, 1024);
+
+    SharedPacketEncoding dataEncoding;
+    server.addDaqPacket(1, serverDataPacket, dataEncoding);
+    otherServer.addDaqPacket(1, serverDataPacket, dataEncoding);
+    ASSERT_EQ(dataEncoding.destructSubscribers.size(), 2u);
+    PacketStreamingServer::completeSharedEncoding(serverDataPacket, dataEncoding);
+    ASSERT_EQ(server.getNextPacketBuffer(), otherServer.getNextPacketBuffer());
+
+    // each server keeps its own release bookkeeping for the shared packet
+    serverDataPacket.release();
+    server.checkAndSendReleasePacket(true);
+    otherServer.checkAndSendReleasePacket(true);
+
+    const auto releasePacketBuffer = server.getNextPacketBuffer();
+    const auto otherReleasePacketBuffer = otherServer.getNextPacketBuffer();
+    ASSERT_TRUE(releasePacketBuffer);
+    ASSERT_TRUE(otherReleasePacketBuffer);
+    ASSERT_NE(releasePacketBuffer, otherReleasePacketBuffer);
+    ASSERT_EQ(releasePacketBuffer->packetHeader->type, PacketType::release);
+    ASSERT_EQ(otherReleasePacketBuffer->packetHeader->type, PacketType::release);
+}
+
 TEST_F(PacketStreamingTest, DataPacketsWithDataDescriptorChanged)
 {
     const auto valueDescriptor1 = DataDescriptorBuilder().setSampleType(SampleType::Float32).build();
@@ -15,14 +15,18 @@
  */
 
 #pragma once
-#include <thread>
 #include "websocket_streaming/websocket_streaming.h"
 #include <opendaq/device_ptr.h>
+#include <opendaq/input_port_config_ptr.h>
 #include <opendaq/reader_factory.h>
-#include <queue>
+#include <mutex>
 
 BEGIN_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
 
+// Forwards packets of read signals as they are enqueued, driven by input port notifications.
+// Signals are read independently of each other, the packets of each signal are forwarded in order.
+// With coalescing enabled, packets enqueued while a notification is pending are passed to the
+// callback together; otherwise each packet is passed on its own as soon as it is read.
 class AsyncPacketReader
 {
 public:
@@ -31,26 +35,48 @@ public:
     AsyncPacketReader(const DevicePtr& device, const ContextPtr& context);
     ~AsyncPacketReader();
 
-    void start();
+    // returns once the packets being forwarded have been passed to the callback, no packets are forwarded afterwards
     void stop();
     void onPacket(const OnPacketCallback& callback);
-    void setLoopFrequency(uint32_t freqency);
+    void setUseMultiThreadedScheduler(bool useMultiThreadedScheduler);
+    void setCoalescePackets(bool coalescePackets);
     void startReadSignal(const SignalPtr& signal);
     void stopReadSignal(const SignalPtr& signal);
 
 protected:
-    void startReadThread();
+    // shared with the notification callback of the reader, which holds it only weakly
+    struct ReadContext
+    {
+        // serializes the notifications of a signal, so that its packets are forwarded in the order of reading
+        std::mutex sync;
+        bool stopped = false;
+        SignalPtr signal;
+        PacketReaderPtr reader;
+        OnPacketCallback onPacketCallback;
+        bool coalescePackets;
+        LoggerComponentPtr loggerComponent;
+    };
+    using ReadContextPtr = std::shared_ptr<ReadContext>;
+
+    struct SignalReader
+    {
+        SignalPtr signal;
+        InputPortConfigPtr port;
+        ReadContextPtr readContext;
+    };
+
     void createReaders();
     void addReader(SignalPtr signalToRead);
     void removeReader(SignalPtr signalToRead);
+    static void stopReader(const SignalReader& signalReader);
+    static void readPackets(ReadContext& readContext);
 
     DevicePtr device;
     ContextPtr context;
     OnPacketCallback onPacketCallback;
-    std::thread readThread;
-    bool readThreadStarted = false;
-    std::chrono::milliseconds sleepTime;
-    std::vector<std::pair<SignalPtr, PacketReaderPtr>> signalReaders;
+    bool useMultiThreadedScheduler = true;
+    bool coalescePackets = true;
+    std::vector<SignalReader> signalReaders;
 
     LoggerPtr logger;
     LoggerComponentPtr loggerComponent;
@@ -21,6 +21,7 @@
 #include <opendaq/sample_type.h>
 #include <opendaq/signal_factory.h>
 #include <opendaq/event_packet_ptr.h>
+#include <opendaq/allocator_ptr.h>
 
 BEGIN_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
 
@@ -30,7 +31,8 @@ using InputSignalPtr = std::shared_ptr<InputSignal>;
 class InputSignal
 {
 public:
-    InputSignal();
+    // data packets are allocated with the given allocator, or the default one if not assigned
+    explicit InputSignal(AllocatorPtr packetAllocator = nullptr);
 
     PacketPtr createDataPacket(uint64_t packetOffset, const uint8_t* data, size_t size) const;
     EventPacketPtr createDecriptorChangedPacket() const;
@@ -48,6 +50,7 @@ public:
 protected:
     DataDescriptorPtr currentDataDescriptor;
     DataDescriptorPtr currentDomainDataDescriptor;
+    AllocatorPtr packetAllocator;
 
     std::string name;
     std::string description;
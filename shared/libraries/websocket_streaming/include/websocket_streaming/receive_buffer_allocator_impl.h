@@ -0,0 +1,58 @@
+/*
+ * Copyright 2022-2023 Blueberry d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "websocket_streaming/websocket_streaming.h"
+#include <opendaq/allocator.h>
+#include <opendaq/data_descriptor.h>
+#include <coretypes/intfs.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
+
+// Packet allocator for received data blocks. Freed buffers are kept per size and handed out
+// again, so a steady stream of equally sized blocks reuses warm memory instead of allocating
+// (and page-faulting) fresh buffers for every block. Buffers are aligned to the largest power
+// of two dividing the requested alignment, so that a sample size may be passed as alignment.
+class ReceiveBufferAllocatorImpl : public ImplementationOf<IAllocator>
+{
+public:
+    explicit ReceiveBufferAllocatorImpl(SizeT maxCachedBytes = 64 * 1024 * 1024);
+    ~ReceiveBufferAllocatorImpl() override;
+
+    ErrCode INTERFACE_FUNC allocate(const IDataDescriptor* descriptor, SizeT bytes, SizeT align, VoidPtr* address) override;
+    ErrCode INTERFACE_FUNC free(VoidPtr address) override;
+
+private:
+    // stored right before the returned address
+    struct alignas(std::max_align_t) BufferHeader
+    {
+        SizeT size;
+        void* base;
+    };
+
+    static SizeT getEffectiveAlignment(SizeT align);
+    static bool isAligned(const void* address, SizeT align);
+
+    const SizeT maxCachedBytes;
+    SizeT cachedBytes;
+    std::unordered_map<SizeT, std::vector<BufferHeader*>> freeBuffers;
+    std::mutex sync;
+};
+
+END_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
@@ -30,6 +30,7 @@
 #include <opendaq/logger_ptr.h>
 #include <opendaq/logger_component_ptr.h>
 #include <opendaq/event_packet_ptr.h>
+#include <opendaq/allocator_ptr.h>
 
 #include <condition_variable>
 #include <mutex>
@@ -70,6 +71,7 @@ public:
     std::string getTarget();
     bool isConnected();
     void setConnectTimeout(std::chrono::milliseconds timeout);
+    void setPacketAllocator(const AllocatorPtr& packetAllocator);
     EventPacketPtr getDataDescriptorChangedEventPacket(const StringPtr& signalStringId);
     void subscribeSignals(const std::vector<std::string>& signalIds);
     void unsubscribeSignals(const std::vector<std::string>& signalIds);
@@ -103,6 +105,7 @@ protected:
     daq::streaming_protocol::SignalContainer signalContainer;
     daq::streaming_protocol::ProtocolHanlderPtr protocolHandler;
     std::unordered_map<std::string, InputSignalPtr> signals;
+    AllocatorPtr packetAllocator;
     OnPacketCallback onPacketCallback = [](const StringPtr&, const PacketPtr&) {};
     OnSignalCallback onSignalInitCallback = [](const StringPtr&, const SubscribedSignalInfo&) {};
     OnDomainDescriptorCallback onDomainDescriptorCallback = [](const StringPtr&, const DataDescriptorPtr&) {};
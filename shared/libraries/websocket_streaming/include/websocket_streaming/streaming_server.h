@@ -24,6 +24,7 @@
 #include <thread>
 #include <boost/asio/io_context.hpp>
 #include <functional>
+#include <mutex>
 
 #include <opendaq/data_packet_ptr.h>
 #include <opendaq/event_packet_ptr.h>
@@ -81,6 +82,9 @@ protected:
     std::unique_ptr<daq::streaming_protocol::ControlServer> controlServer;
     std::thread serverThread;
     ClientMap clients;
+    // guards the client map against packets sent from reader threads while clients connect or send
+    // control commands; not held while the subscribe callbacks run, as they start sending packets
+    mutable std::mutex clientsSync;
     OnAcceptCallback onAcceptCallback;
     OnSubscribeCallback onSubscribeCallback;
     OnUnsubscribeCallback onUnsubscribeCallback;
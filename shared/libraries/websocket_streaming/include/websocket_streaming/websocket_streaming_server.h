@@ -31,6 +31,8 @@ public:
 
     void setStreamingPort(uint16_t port);
     void setControlPort(uint16_t port);
+    void setUseMultiThreadedScheduler(bool useMultiThreadedScheduler);
+    void setCoalescePackets(bool coalescePackets);
     void start();
     void stop();
 
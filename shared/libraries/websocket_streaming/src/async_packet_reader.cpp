@@ -2,6 +2,7 @@
 #include <opendaq/instance_factory.h>
 #include <opendaq/custom_log.h>
 #include <opendaq/search_filter_factory.h>
+#include <opendaq/input_port_factory.h>
 
 BEGIN_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
 
@@ -11,7 +12,6 @@ AsyncPacketReader::AsyncPacketReader(const DevicePtr& device, const ContextPtr&
     , logger(context.getLogger())
     , loggerComponent(logger.getOrAddComponent("WebsocketStreamingPacketReader"))
 {
-    setLoopFrequency(50);
     onPacketCallback = [](const SignalPtr& signal, const ListPtr<IPacket>& packets) {};
 }
 
@@ -20,26 +20,22 @@ AsyncPacketReader::~AsyncPacketReader()
     stop();
 }
 
-void AsyncPacketReader::start()
+void AsyncPacketReader::stop()
 {
-    readThreadStarted = true;
-    this->readThread = std::thread([this]()
-    {
-        this->startReadThread();
-        LOG_I("Reading thread finished");
-    });
+    std::scoped_lock lock(readersSync);
+    for (const auto& signalReader : signalReaders)
+        stopReader(signalReader);
+    signalReaders.clear();
 }
 
-void AsyncPacketReader::stop()
+void AsyncPacketReader::stopReader(const SignalReader& signalReader)
 {
-    readThreadStarted = false;
-    if (readThread.joinable())
-    {
-        readThread.join();
-        LOG_I("Reading thread joined");
-    }
+    signalReader.readContext->reader.setOnDataAvailable(nullptr);
+    signalReader.port.remove();
 
-    signalReaders.clear();
+    // waits for a notification still forwarding packets of the signal, later ones find the reader stopped
+    std::scoped_lock lock(signalReader.readContext->sync);
+    signalReader.readContext->stopped = true;
 }
 
 void AsyncPacketReader::onPacket(const OnPacketCallback& callback)
@@ -47,37 +43,55 @@ void AsyncPacketReader::onPacket(const OnPacketCallback& callback)
     onPacketCallback = callback;
 }
 
-void AsyncPacketReader::setLoopFrequency(uint32_t freqency)
+void AsyncPacketReader::setUseMultiThreadedScheduler(bool useMultiThreadedScheduler)
+{
+    this->useMultiThreadedScheduler = useMultiThreadedScheduler;
+}
+
+void AsyncPacketReader::setCoalescePackets(bool coalescePackets)
 {
-    uint64_t sleepMs = 1000.0 / freqency;
-    this->sleepTime = std::chrono::milliseconds(sleepMs);
+    this->coalescePackets = coalescePackets;
 }
 
-void AsyncPacketReader::startReadThread()
+void AsyncPacketReader::readPackets(ReadContext& readContext)
 {
-    while (readThreadStarted)
+    const auto& loggerComponent = readContext.loggerComponent;
+    if (readContext.stopped)
+        return;
+
+    try
     {
+        if (readContext.coalescePackets)
         {
-            std::scoped_lock lock(readersSync);
-            for (const auto& [signal, reader] : signalReaders)
+            auto packets = readContext.reader.readAll();
+            while (packets.getCount() > 0)
             {
-                if (reader.getAvailableCount() == 0)
-                    continue;
-
-                const auto& packets = reader.readAll();
-                onPacketCallback(signal, packets);
+                readContext.onPacketCallback(readContext.signal, packets);
+                packets = readContext.reader.readAll();
+            }
+        }
+        else
+        {
+            auto packet = readContext.reader.read();
+            while (packet.assigned())
+            {
+                readContext.onPacketCallback(readContext.signal, List<IPacket>(packet));
+                packet = readContext.reader.read();
             }
         }
-
-        std::this_thread::sleep_for(sleepTime);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Failed to forward packets of signal {}: {}", readContext.signal.getGlobalId(), e.what());
     }
 }
 
 void AsyncPacketReader::createReaders()
 {
-    signalReaders.clear();
+    stop();
     auto signals = device.getSignals(search::Recursive(search::Any()));
 
+    std::scoped_lock lock(readersSync);
     for (const auto& signal : signals)
     {
         addReader(signal);
@@ -103,32 +117,57 @@ void AsyncPacketReader::addReader(SignalPtr signalToRead)
 
     auto it = std::find_if(signalReaders.begin(),
                            signalReaders.end(),
-                           [&signalToRead](const std::pair<SignalPtr, PacketReaderPtr>& element)
+                           [&signalToRead](const SignalReader& element)
                            {
-                               return element.first == signalToRead;
+                               return element.signal == signalToRead;
                            });
     if (it != signalReaders.end())
         return;
 
     LOG_I("Add reader for signal {}", signalToRead.getGlobalId());
-    auto reader = PacketReader(signalToRead);
-    signalReaders.push_back(std::pair<SignalPtr, PacketReaderPtr>({signalToRead, reader}));
+
+    auto port = InputPort(signalToRead.getContext(), nullptr, "readsignal");
+    auto readContext = std::make_shared<ReadContext>();
+    readContext->signal = signalToRead;
+    readContext->reader = PacketReaderFromPort(port);
+    readContext->onPacketCallback = onPacketCallback;
+    readContext->coalescePackets = coalescePackets;
+    readContext->loggerComponent = loggerComponent;
+    if (!useMultiThreadedScheduler)
+        port.setNotificationMethod(PacketReadyNotification::SameThread);
+    port.connect(signalToRead);
+
+    // the callback may run on a scheduler thread after the reader is removed, so it holds no reference to it
+    std::weak_ptr<ReadContext> readContextRef = readContext;
+    readContext->reader.setOnDataAvailable([readContextRef]
+    {
+        if (const auto readContext = readContextRef.lock())
+        {
+            std::scoped_lock lock(readContext->sync);
+            readPackets(*readContext);
+        }
+    });
+    signalReaders.push_back({signalToRead, port, readContext});
+
+    // forward packets enqueued before the notification callback was set
+    std::scoped_lock lock(readContext->sync);
+    readPackets(*readContext);
 }
 
 void AsyncPacketReader::removeReader(SignalPtr signalToRead)
 {
     auto it = std::find_if(signalReaders.begin(),
                            signalReaders.end(),
-                           [&signalToRead](const std::pair<SignalPtr, PacketReaderPtr>& element)
+                           [&signalToRead](const SignalReader& element)
                            {
-                               return element.first == signalToRead;
+                               return element.signal == signalToRead;
                            });
     if (it == signalReaders.end())
         return;
 
     LOG_I("Remove reader for signal {}", signalToRead.getGlobalId());
+    stopReader(*it);
     signalReaders.erase(it);
 }
 
 END_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
-
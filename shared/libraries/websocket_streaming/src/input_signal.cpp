@@ -10,8 +10,9 @@ BEGIN_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
 using namespace daq;
 using namespace daq::streaming_protocol;
 
-InputSignal::InputSignal()
-    : isDomainSignal(false)
+InputSignal::InputSignal(AllocatorPtr packetAllocator)
+    : packetAllocator(std::move(packetAllocator))
+    , isDomainSignal(false)
 {
 }
 
@@ -25,9 +26,13 @@ PacketPtr InputSignal::createDataPacket(uint64_t packetOffset, const uint8_t* da
     const auto sampleSize = getSampleSize(sampleType);
     const auto sampleCount = size / sampleSize;
 
+    // packets of linear time signals only carry the offset and own no buffer
     auto domainPacket = DataPacket(currentDomainDataDescriptor, sampleCount, (Int) packetOffset);
-    auto dataPacket = DataPacketWithDomain(domainPacket, currentDataDescriptor, sampleCount);
-    std::memcpy(dataPacket.getRawData(), data, sampleCount*sampleSize);
+
+    // the received block is only valid during the protocol callback, so it is copied once
+    // into packet memory taken from the (recycling) packet allocator
+    auto dataPacket = DataPacketWithDomain(domainPacket, currentDataDescriptor, sampleCount, nullptr, packetAllocator);
+    std::memcpy(dataPacket.getRawData(), data, sampleCount * sampleSize);
     return dataPacket;
 }
 
@@ -0,0 +1,95 @@
+#include "websocket_streaming/receive_buffer_allocator_impl.h"
+#include <coretypes/impl.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+BEGIN_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
+
+ReceiveBufferAllocatorImpl::ReceiveBufferAllocatorImpl(SizeT maxCachedBytes)
+    : maxCachedBytes(maxCachedBytes)
+    , cachedBytes(0)
+{
+}
+
+ReceiveBufferAllocatorImpl::~ReceiveBufferAllocatorImpl()
+{
+    for (const auto& [_, buffers] : freeBuffers)
+    {
+        for (const auto& buffer : buffers)
+            std::free(buffer->base);
+    }
+}
+
+SizeT ReceiveBufferAllocatorImpl::getEffectiveAlignment(SizeT align)
+{
+    // lowest set bit, a sample size of 24 bytes needs its elements aligned to 8 bytes at most
+    align = align & (~align + 1);
+    return std::max<SizeT>(align, alignof(BufferHeader));
+}
+
+bool ReceiveBufferAllocatorImpl::isAligned(const void* address, SizeT align)
+{
+    return reinterpret_cast<std::uintptr_t>(address) % align == 0;
+}
+
+ErrCode ReceiveBufferAllocatorImpl::allocate(const IDataDescriptor* /*descriptor*/, SizeT bytes, SizeT align, VoidPtr* address)
+{
+    OPENDAQ_PARAM_NOT_NULL(address);
+
+    align = getEffectiveAlignment(align);
+
+    {
+        std::scoped_lock lock(sync);
+        if (auto it = freeBuffers.find(bytes); it != freeBuffers.end() && !it->second.empty())
+        {
+            // blocks of a signal share size and alignment, a buffer cached for a less aligned request is kept
+            BufferHeader* header = it->second.back();
+            if (isAligned(header + 1, align))
+            {
+                it->second.pop_back();
+                cachedBytes -= bytes;
+                *address = header + 1;
+                return OPENDAQ_SUCCESS;
+            }
+        }
+    }
+
+    // the header alignment is guaranteed by malloc, larger alignments round the data offset up
+    const SizeT padding = align - alignof(BufferHeader);
+    void* base = std::malloc(sizeof(BufferHeader) + padding + bytes);
+    if (base == nullptr)
+        return OPENDAQ_ERR_NOMEMORY;
+
+    auto data = reinterpret_cast<std::uintptr_t>(base) + sizeof(BufferHeader);
+    data = (data + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+
+    auto header = reinterpret_cast<BufferHeader*>(data) - 1;
+    header->size = bytes;
+    header->base = base;
+    *address = header + 1;
+    return OPENDAQ_SUCCESS;
+}
+
+ErrCode ReceiveBufferAllocatorImpl::free(VoidPtr address)
+{
+    if (address == nullptr)
+        return OPENDAQ_SUCCESS;
+
+    BufferHeader* header = static_cast<BufferHeader*>(address) - 1;
+
+    {
+        std::scoped_lock lock(sync);
+        if (cachedBytes + header->size <= maxCachedBytes)
+        {
+            freeBuffers[header->size].push_back(header);
+            cachedBytes += header->size;
+            return OPENDAQ_SUCCESS;
+        }
+    }
+
+    std::free(header->base);
+    return OPENDAQ_SUCCESS;
+}
+
+END_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
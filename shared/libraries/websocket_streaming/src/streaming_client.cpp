@@ -8,6 +8,7 @@
 #include "streaming_protocol/SignalContainer.hpp"
 #include "opendaq/custom_log.h"
 #include <opendaq/packet_factory.h>
+#include "websocket_streaming/receive_buffer_allocator_impl.h"
 
 BEGIN_NAMESPACE_OPENDAQ_WEBSOCKET_STREAMING
 
@@ -21,6 +22,7 @@ StreamingClient::StreamingClient(const ContextPtr& context, const std::string& c
         this->loggerComponent.logMessage(SourceLocation{location.filename, location.line, location.funcname}, msg, static_cast<LogLevel>(level));
     })
     , signalContainer(logCallback)
+    , packetAllocator(createWithImplementation<IAllocator, ReceiveBufferAllocatorImpl>())
     , useRawTcpConnection(useRawTcpConnection)
 {
     parseConnectionString(connectionString);
@@ -36,6 +38,7 @@ StreamingClient::StreamingClient(const ContextPtr& context, const std::string& h
     , port(port)
     , target(target)
     , signalContainer(logCallback)
+    , packetAllocator(createWithImplementation<IAllocator, ReceiveBufferAllocatorImpl>())
     , useRawTcpConnection(useRawTcpConnection)
 {
 }
@@ -198,6 +201,11 @@ void StreamingClient::setConnectTimeout(std::chrono::milliseconds timeout)
     this->connectTimeout = timeout;
 }
 
+void StreamingClient::setPacketAllocator(const AllocatorPtr& packetAllocator)
+{
+    this->packetAllocator = packetAllocator;
+}
+
 EventPacketPtr StreamingClient::getDataDescriptorChangedEventPacket(const StringPtr& signalStringId)
 {
     if (auto it = signals.find(signalStringId); it == signals.end())
@@ -283,7 +291,7 @@ void StreamingClient::onProtocolMeta(daq::streaming_protocol::ProtocolHandler& p
 
                 if (auto signalIt = signals.find(signalId); signalIt == signals.end())
                 {
-                    auto inputSignal = std::make_shared<InputSignal>();
+                    auto inputSignal = std::make_shared<InputSignal>(packetAllocator);
                     signals.insert({signalId, inputSignal});
                 }
                 else
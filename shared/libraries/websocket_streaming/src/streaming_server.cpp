@@ -91,9 +91,10 @@ void StreamingServer::unicastPacket(const std::string& streamId,
                                     const std::string& signalId,
                                     const PacketPtr& packet)
 {
+    std::scoped_lock lock(clientsSync);
     if (auto clientIt = clients.find(streamId); clientIt != clients.end())
     {
-        auto signals = clientIt->second.second;
+        const auto& signals = clientIt->second.second;
         if (auto signalIt = signals.find(streamId); signalIt != signals.end())
             signalIt->second->write(packet);
     }
@@ -101,9 +102,10 @@ void StreamingServer::unicastPacket(const std::string& streamId,
 
 void StreamingServer::broadcastPacket(const std::string& signalId, const PacketPtr& packet)
 {
-    for (auto& [_, client] : clients)
+    std::scoped_lock lock(clientsSync);
+    for (const auto& [_, client] : clients)
     {
-        auto signals = client.second;
+        const auto& signals = client.second;
         if (auto signalIter = signals.find(signalId); signalIter != signals.end())
         {
             signalIter->second->write(packet);
@@ -113,9 +115,10 @@ void StreamingServer::broadcastPacket(const std::string& signalId, const PacketP
 
 void StreamingServer::sendPacketToSubscribers(const std::string& signalId, const PacketPtr& packet)
 {
-    for (auto& [_, client] : clients)
+    std::scoped_lock lock(clientsSync);
+    for (const auto& [_, client] : clients)
     {
-        auto signals = client.second;
+        const auto& signals = client.second;
         if (auto signalIter = signals.find(signalId); signalIter != signals.end())
         {
             if (signalIter->second->isSubscribed())
@@ -156,7 +159,10 @@ void StreamingServer::onAcceptInternal(const daq::stream::StreamPtr& stream)
     }
 
     LOG_I("New client connected. Stream Id: {}", writer->id());
-    clients.insert({writer->id(), {writer, outputSignals}});
+    {
+        std::scoped_lock lock(clientsSync);
+        clients.insert({writer->id(), {writer, outputSignals}});
+    }
 
     writeSignalsAvailable(writer, signals);
 }
@@ -173,12 +179,18 @@ int StreamingServer::onControlCommand(const std::string& streamId,
         return -1;
     }
 
-    auto clientIter = clients.find(streamId);
-    if (clientIter == std::end(clients))
+    // the handlers are called without the lock, subscribing starts a reader which sends packets to subscribers
+    SignalMap signals;
     {
-        LOG_W("Unknown streamId: {}, reject command", streamId);
-        errorMessage = "Unknown streamId:  '" + streamId + "'";
-        return -1;
+        std::scoped_lock lock(clientsSync);
+        auto clientIter = clients.find(streamId);
+        if (clientIter == std::end(clients))
+        {
+            LOG_W("Unknown streamId: {}, reject command", streamId);
+            errorMessage = "Unknown streamId:  '" + streamId + "'";
+            return -1;
+        }
+        signals = clientIter->second.second;
     }
 
     if (command == "subscribe" || command == "unsubscribe")
@@ -187,7 +199,6 @@ int StreamingServer::onControlCommand(const std::string& streamId,
         std::string message = "Command '" + command + "' failed for unknown signals:\n";
         for (const auto& signalId : signalIds)
         {
-            auto signals = clientIter->second.second;
             if (auto signalIter = signals.find(signalId); signalIter != signals.end())
             {
                 if (command == "subscribe")
@@ -261,10 +272,11 @@ void StreamingServer::writeInit(const streaming_protocol::StreamWriterPtr& write
 
 bool StreamingServer::isSignalSubscribed(const std::string& signalId) const
 {
+    std::scoped_lock lock(clientsSync);
     bool result = false;
     for (const auto& [_, client] : clients)
     {
-        auto signals = client.second;
+        const auto& signals = client.second;
         if (auto iter = signals.find(signalId); iter != signals.end())
             result = result || iter->second->isSubscribed();
     }
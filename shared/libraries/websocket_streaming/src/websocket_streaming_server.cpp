@@ -38,6 +38,16 @@ void WebsocketStreamingServer::setControlPort(uint16_t port)
     this->controlPort = port;
 }
 
+void WebsocketStreamingServer::setUseMultiThreadedScheduler(bool useMultiThreadedScheduler)
+{
+    packetReader.setUseMultiThreadedScheduler(useMultiThreadedScheduler);
+}
+
+void WebsocketStreamingServer::setCoalescePackets(bool coalescePackets)
+{
+    packetReader.setCoalescePackets(coalescePackets);
+}
+
 void WebsocketStreamingServer::start()
 {
     if (!device.assigned())
@@ -47,18 +57,16 @@ void WebsocketStreamingServer::start()
     if (streamingPort == 0 || controlPort == 0)
         return;
 
-    streamingServer.onAccept([this](const daq::streaming_protocol::StreamWriterPtr& writer) { return device.getSignals(search::Recursive(search::Any())); });
-    streamingServer.onSubscribe([this](const daq::SignalPtr& signal) { packetReader.startReadSignal(signal); } );
-    streamingServer.onUnsubscribe([this](const daq::SignalPtr& signal) { packetReader.stopReadSignal(signal); } );
-    streamingServer.start(streamingPort, controlPort);
-
-    packetReader.setLoopFrequency(50);
     packetReader.onPacket([this](const SignalPtr& signal, const ListPtr<IPacket>& packets) {
         const auto signalId = signal.getGlobalId();
         for (const auto& packet : packets)
             streamingServer.sendPacketToSubscribers(signalId, packet);
     });
-    packetReader.start();
+
+    streamingServer.onAccept([this](const daq::streaming_protocol::StreamWriterPtr& writer) { return device.getSignals(search::Recursive(search::Any())); });
+    streamingServer.onSubscribe([this](const daq::SignalPtr& signal) { packetReader.startReadSignal(signal); } );
+    streamingServer.onUnsubscribe([this](const daq::SignalPtr& signal) { packetReader.stopReadSignal(signal); } );
+    streamingServer.start(streamingPort, controlPort);
 
     // The control port is published thru the streaming protocol itself
     // so here the streaming port only is added to the StreamingInfo object
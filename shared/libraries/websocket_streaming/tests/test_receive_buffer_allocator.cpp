@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <opendaq/allocator_ptr.h>
+#include "websocket_streaming/receive_buffer_allocator_impl.h"
+
+using namespace daq;
+using namespace daq::websocket_streaming;
+
+using ReceiveBufferAllocatorTest = testing::Test;
+
+TEST_F(ReceiveBufferAllocatorTest, ReusesFreedBufferOfSameSize)
+{
+    AllocatorPtr allocator = createWithImplementation<IAllocator, ReceiveBufferAllocatorImpl>();
+
+    void* first = allocator.allocate(nullptr, 4096, 8);
+    ASSERT_NE(first, nullptr);
+    allocator.free(first);
+
+    void* second = allocator.allocate(nullptr, 4096, 8);
+    ASSERT_EQ(second, first);
+
+    void* other = allocator.allocate(nullptr, 1024, 8);
+    ASSERT_NE(other, first);
+
+    allocator.free(second);
+    allocator.free(other);
+}
+
+TEST_F(ReceiveBufferAllocatorTest, CachedBytesAreBounded)
+{
+    AllocatorPtr allocator = createWithImplementation<IAllocator, ReceiveBufferAllocatorImpl>(4096);
+
+    void* first = allocator.allocate(nullptr, 4096, 8);
+    void* second = allocator.allocate(nullptr, 4096, 8);
+    allocator.free(first);
+    allocator.free(second);
+
+    // only one buffer fits into the cache, the other one is released
+    void* reused = allocator.allocate(nullptr, 4096, 8);
+    void* fresh = allocator.allocate(nullptr, 4096, 8);
+    ASSERT_EQ(reused, first);
+    ASSERT_NE(fresh, nullptr);
+
+    allocator.free(reused);
+    allocator.free(fresh);
+}
+
+TEST_F(ReceiveBufferAllocatorTest, HonoursAlignment)
+{
+    AllocatorPtr allocator = createWithImplementation<IAllocator, ReceiveBufferAllocatorImpl>();
+
+    for (SizeT align : {1, 8, 64, 256, 4096})
+    {
+        void* address = allocator.allocate(nullptr, 1000, align);
+        ASSERT_NE(address, nullptr);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(address) % align, 0u) << "align " << align;
+        allocator.free(address);
+    }
+
+    // a sample size is aligned to its largest power of two divisor
+    void* address = allocator.allocate(nullptr, 1000, 24);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(address) % 8, 0u);
+    allocator.free(address);
+}
+
+TEST_F(ReceiveBufferAllocatorTest, CachedBufferReusedOnlyWhenAligned)
+{
+    AllocatorPtr allocator = createWithImplementation<IAllocator, ReceiveBufferAllocatorImpl>();
+
+    void* first = allocator.allocate(nullptr, 4096, 4096);
+    allocator.free(first);
+    void* reused = allocator.allocate(nullptr, 4096, 4096);
+    ASSERT_EQ(reused, first);
+    allocator.free(reused);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        void* address = allocator.allocate(nullptr, 2048, 8);
+        allocator.free(address);
+        void* aligned = allocator.allocate(nullptr, 2048, 4096);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 4096, 0u);
+        allocator.free(aligned);
+    }
+}